@@ -22,6 +22,7 @@
         "lpsolve/shared/commonlib.c",
         "lpsolve/shared/mmio.c",
         "lpsolve/shared/myblas.c",
+        "lpsolve/shared/mythread.c",
         "lpsolve/ini.c",
         "lpsolve/fortify.c",
         "lpsolve/colamd/colamd.c",
@@ -39,6 +40,7 @@
         "lpsolve/lp_presolve.c",
         "lpsolve/lp_price.c",
         "lpsolve/lp_pricePSE.c",
+        "lpsolve/lp_propagate.c",
         "lpsolve/lp_report.c",
         "lpsolve/lp_scale.c",
         "lpsolve/lp_simplex.c",
@@ -49,6 +49,7 @@
 #include <math.h>
 #include "lusol.h"
 #include "myblas.h"
+#include "mythread.h"
 #ifdef MATLAB
   #include "mex.h"
 #endif
@@ -274,11 +275,14 @@ LUSOLrec *LUSOL_create(FILE *outstream, int msgfil, int pivotmodel, int updateli
   newLU->parmlu[LUSOL_RP_MARKOWITZ_DENSE]  = 0.5e+0;
 
   newLU->parmlu[LUSOL_RP_SMARTRATIO]       = LUSOL_DEFAULT_SMARTRATIO;
+  newLU->parmlu[LUSOL_RP_HYPERSPARSE]      = LUSOL_DEFAULT_HYPERSPARSE;
 #ifdef ForceRowBasedL0
   newLU->luparm[LUSOL_IP_ACCELERATION]     = LUSOL_BASEORDER;
 #endif
   newLU->luparm[LUSOL_IP_KEEPLU]           = TRUE;
   newLU->luparm[LUSOL_IP_UPDATELIMIT]      = updatelimit;
+  newLU->luparm[LUSOL_IP_THREADS]          = 1;
+  newLU->densekernel                       = LU1DPB_kernel();
 
   init_BLAS();
 
@@ -618,6 +622,7 @@ void LUSOL_free(LUSOLrec *LUSOL)
     LUSOL_matfree(&(LUSOL->L0));
   if(LUSOL->U != NULL)
     LUSOL_matfree(&(LUSOL->U));
+  LU6HYP_free(LUSOL);
   if(!is_nativeBLAS())
     unload_BLAS();
   LUSOL_FREE(LUSOL);
@@ -676,8 +681,9 @@ int LUSOL_ftran(LUSOLrec *LUSOL, REAL b[], int NZidx[], MYBOOL prepareupdate)
 
   /* Copy RHS vector, but make adjustment for offset since this
      can create a memory error when the calling program uses
-     a 0-base vector offset back to comply with LUSOL. */
-  MEMCOPY(vector+1, b+1, LUSOL->n);
+     a 0-base vector offset back to comply with LUSOL; this also
+     provides the nonzero index list for the hypersparse solves. */
+  NZidx = LU6HYP_copyrhs(LUSOL, vector, b, NZidx, LUSOL->n);
   if (vector != NULL)
     vector[0] = 0;
 
@@ -694,8 +700,9 @@ int LUSOL_btran(LUSOLrec *LUSOL, REAL b[], int NZidx[])
 
   /* Copy RHS vector, but make adjustment for offset since this
      can create a memory error when the calling program uses
-     a 0-base vector offset back to comply with LUSOL. */
-  MEMCOPY(LUSOL->w+1, b+1, LUSOL->m);
+     a 0-base vector offset back to comply with LUSOL; this also
+     provides the nonzero index list for the hypersparse solves. */
+  NZidx = LU6HYP_copyrhs(LUSOL, LUSOL->w, b, NZidx, LUSOL->m);
   if (LUSOL->w != NULL)
     LUSOL->w[0] = 0;
 
@@ -46,6 +46,12 @@
 /*  #define DoTraceL0 */
 #endif
 /*#define UseTimer */
+#ifndef LUSOL_DENSEBLOCK
+  #define LUSOL_DENSEBLOCK          32    /* Panel width of the blocked dense LU */
+#endif
+#ifndef LUSOL_DENSEPARALLEL
+  #define LUSOL_DENSEPARALLEL   1.0e+6    /* Minimum flops of a threaded dense update */
+#endif
 
 
 /* Legacy compatibility and testing options (Fortran-LUSOL)                  */
@@ -101,6 +107,7 @@
 #endif
 #define LUSOL_MINDELTA_rc         1000
 #define LUSOL_DEFAULT_SMARTRATIO 0.667
+#define LUSOL_DEFAULT_HYPERSPARSE 0.10  /* Max. reach density for hypersparse solves */
 
 /* Fixed system parameters (changeable only by developers)                   */
 /* ------------------------------------------------------------------------- */
@@ -129,7 +136,10 @@
 #define LUSOL_RP_USERDATA_2         18
 #define LUSOL_RP_USERDATA_3         19
 #define LUSOL_RP_RESIDUAL_U         20
-#define LUSOL_RP_LASTITEM            LUSOL_RP_RESIDUAL_U
+
+/* parmlu INPUT parameters (continued): */
+#define LUSOL_RP_HYPERSPARSE        21
+#define LUSOL_RP_LASTITEM            LUSOL_RP_HYPERSPARSE
 
 /* luparm INPUT parameters: */
 #define LUSOL_IP_USERDATA_0          0
@@ -167,7 +177,11 @@
 #define LUSOL_IP_FTRANCOUNT         30
 #define LUSOL_IP_BTRANCOUNT         31
 #define LUSOL_IP_ROWCOUNT_L0        32
-#define LUSOL_IP_LASTITEM            LUSOL_IP_ROWCOUNT_L0
+
+/* luparm INPUT parameters (continued): */
+#define LUSOL_IP_UPDATEMODEL        33
+#define LUSOL_IP_THREADS            34
+#define LUSOL_IP_LASTITEM            LUSOL_IP_THREADS
 
 
 /* Macros for matrix-based access for dense part of A and timer mapping      */
@@ -188,6 +202,7 @@
 #define LUSOL_AUTOORDER              2
 #define LUSOL_ACCELERATE_L0          4
 #define LUSOL_ACCELERATE_U           8
+#define LUSOL_ACCELERATE_HYPER      16  /* Symbolic reach solves for sparse rhs */
 
 #define LUSOL_PIVMOD_NOCHANGE       -2  /* Don't change active pivoting model */
 #define LUSOL_PIVMOD_DEFAULT        -1  /* Set pivoting model to default */
@@ -197,6 +212,9 @@
 #define LUSOL_PIVMOD_TSP             3  /* Threshold Symmetric pivoting */
 #define LUSOL_PIVMOD_MAX             LUSOL_PIVMOD_TSP
 
+#define LUSOL_UPDMOD_BG              0  /* Bartels-Golub: stabilizing row interchanges */
+#define LUSOL_UPDMOD_FT              1  /* Forrest-Tomlin: row etas, no interchanges */
+
 #define LUSOL_PIVTOL_NOCHANGE        0
 #define LUSOL_PIVTOL_BAGGY           1
 #define LUSOL_PIVTOL_LOOSE           2
@@ -254,6 +272,9 @@
 /* ------------------------------------------------------------------------- */
 typedef void LUSOLlogfunc(void *lp, void *userhandle, char *buf);
 
+/* Update kernel of the blocked dense factorization; adds t[c]*x to y[c] */
+typedef void (LU1DPB_kernel_func)(int n, int ny, REAL *t, REAL *x, REAL **y);
+
 
 /* Sparse matrix data */
 typedef struct _LUSOLmat {
@@ -304,6 +325,22 @@ typedef struct _LUSOLrec {
   LUSOLmat *L0;
   LUSOLmat *U;
 
+  /* Work arrays and pivot maps for hypersparse solves, length hypersize */
+  int    hypersize;
+  int    *hypermark, *hyperlist, *hyperrhs;
+  int    *hyperL0col, *hyperL0loc, *hyperL0Tpos, *hyperUpos, *hyperUrowpos;
+  MYBOOL hyperL0ok, hyperL0Tok, hyperUok;
+
+  /* Column pattern of U for hypersparse U solves: linked lists of row
+     indeces by column, and the rows filled in by updates since it was set */
+  int    *hyperUhead, *hyperUdirty;
+  int    *hyperUcolrow, *hyperUcolnext;
+  int    hyperUcolitems, hyperUcolalloc;
+  MYBOOL hyperUcolok;
+
+  /* Dense factorization kernel, chosen for the processor by LUSOL_create */
+  LU1DPB_kernel_func *densekernel;
+
   /* Miscellaneous data */
   int    expanded_a;
   int    replaced_c;
@@ -344,6 +381,10 @@ int LUSOL_btran(LUSOLrec *LUSOL, REAL b[], int NZidx[]);
 void LU1FAC(LUSOLrec *LUSOL, int *INFORM);
 MYBOOL LU1L0(LUSOLrec *LUSOL, LUSOLmat **mat, int *inform);
 void LU6SOL(LUSOLrec *LUSOL, int MODE, REAL V[], REAL W[], int NZidx[], int *INFORM);
+LU1DPB_kernel_func *LU1DPB_kernel(void);
+MYBOOL LU6HYP_alloc(LUSOLrec *LUSOL);
+void LU6HYP_free(LUSOLrec *LUSOL);
+int *LU6HYP_copyrhs(LUSOLrec *LUSOL, REAL V[], REAL b[], int NZidx[], int dim);
 void LU8RPC(LUSOLrec *LUSOL, int MODE1, int MODE2,
             int JREP, REAL V[], REAL W[],
             int *INFORM, REAL *DIAG, REAL *VNORM);
@@ -335,6 +335,8 @@ x10:
 
 }
 
+#include "lusol1d.c"
+
 
 /* ==================================================================
    lu1pq1  constructs a permutation  iperm  from the array  len.
@@ -1604,8 +1606,8 @@ void LU1MXR(LUSOLrec *LUSOL, int K1, int K2, int IX[], REAL AMAXR[])
 {
 #define FastMXR
 #ifdef FastMXR
-  static int  I, *J, *IC, K, LC, LC1, LC2, LR, LR1, LR2;
-  static REAL AMAX;
+  int  I, *J, *IC, K, LC, LC1, LC2, LR, LR1, LR2;
+  REAL AMAX;
 #else
   int  I, J, K, LC, LC1, LC2, LR, LR1, LR2;
   REAL AMAX;
@@ -1702,7 +1704,9 @@ void LU1FUL(LUSOLrec *LUSOL, int LEND, int LU1, MYBOOL TPP,
 /*      ------------------------------------------------------------------
         Call our favorite dense LU factorizer.
         ------------------------------------------------------------------ */
-  if(TPP)
+  if(TPP && (MIN(MLEFT,NLEFT) > LUSOL_DENSEBLOCK))
+    LU1DPB(LUSOL, D,MLEFT,MLEFT,NLEFT,SMALL,NSING,IPVT,LUSOL->iq+NROWU-LUSOL_ARRAYOFFSET);
+  else if(TPP)
     LU1DPP(LUSOL, D,MLEFT,MLEFT,NLEFT,SMALL,NSING,IPVT,LUSOL->iq+NROWU-LUSOL_ARRAYOFFSET);
   else
     LU1DCP(LUSOL, D,MLEFT,MLEFT,NLEFT,SMALL,NSING,IPVT,LUSOL->iq+NROWU-LUSOL_ARRAYOFFSET);
@@ -3370,6 +3374,7 @@ void LU1FAC(LUSOLrec *LUSOL, int *INFORM)
 /*      Free row-based version of L0 (regenerated by LUSOL_btran). */
   if(LUSOL->L0 != NULL)
     LUSOL_matfree(&(LUSOL->L0));
+  LUSOL->hyperL0ok = LUSOL->hyperL0Tok = LUSOL->hyperUok = LUSOL->hyperUcolok = FALSE;
 
 /*      Grab relevant input parameters. */
   NELEM0 = LUSOL->nelem;
@@ -0,0 +1,272 @@
+
+/* ------------------------------------------------------------------
+   Column-blocked version of lu1DPP with vectorized update kernels.
+   The elimination steps of a panel of LUSOL_DENSEBLOCK columns are
+   first done within the panel only; the trailing columns then receive
+   all the steps of the panel in one pass, while the multipliers of the
+   panel are still in cache.  Every column sees the same interchanges
+   and the same axpy operations in the same order as in lu1DPP, so the
+   factors are identical; only the memory traffic is reduced.
+   The kernels are chosen at run time from the instruction sets that
+   init_BLAS detected (AVX-512, AVX2 or plain C).  They use separate
+   multiplications and additions, so that the results do not depend on
+   the availability of fused multiply-add.
+   The trailing update is split by columns over luparm[LUSOL_IP_THREADS]
+   threads when it is large; the factors are the same for any count.
+   This is the only threaded part of lu1fac: the sparse Markowitz
+   phase in lu1fad, including its Schur complement updates, remains
+   sequential, and there is no block-triangular pre-pass.  Bases that
+   never switch to the dense LU are therefore factored on one thread.
+   ------------------------------------------------------------------ */
+
+#if ((defined __GNUC__ && __GNUC__ >= 5) || (defined __clang__)) && \
+    ((defined __x86_64__) || (defined __i386__)) && !(defined NoDenseSIMD)
+  #define LUSOLDenseSIMD
+  #include <immintrin.h>
+  #if defined __clang__
+    #define LU1DPB_TARGET(isa)  __attribute__((target(isa)))
+    #define LU1DPB_NOCONTRACT   _Pragma("clang fp contract(off)")
+  #else
+    #define LU1DPB_TARGET(isa)  __attribute__((target(isa), optimize("fp-contract=off")))
+    #define LU1DPB_NOCONTRACT
+  #endif
+#endif
+
+/* Add multiples t[c]*x to the ny (at most 4) vectors y[c] of length n */
+void LU1DPB_kernel_c(int n, int ny, REAL *t, REAL *x, REAL **y)
+{
+  int  c, i;
+  REAL tc, *yc;
+
+  for(c = 0; c < ny; c++) {
+    tc = t[c];
+    yc = y[c];
+    for(i = 0; i < n; i++)
+      yc[i] += tc*x[i];
+  }
+}
+
+#ifdef LUSOLDenseSIMD
+LU1DPB_TARGET("avx2")
+void LU1DPB_kernel_avx2(int n, int ny, REAL *t, REAL *x, REAL **y)
+{
+  LU1DPB_NOCONTRACT
+  int     c, i, n4 = n & ~3;
+  __m256d xv, tv[4];
+
+  for(c = 0; c < ny; c++)
+    tv[c] = _mm256_set1_pd(t[c]);
+  for(i = 0; i < n4; i += 4) {
+    xv = _mm256_loadu_pd(x+i);
+    for(c = 0; c < ny; c++)
+      _mm256_storeu_pd(y[c]+i, _mm256_add_pd(_mm256_loadu_pd(y[c]+i),
+                                             _mm256_mul_pd(tv[c], xv)));
+  }
+  for(; i < n; i++)
+    for(c = 0; c < ny; c++)
+      y[c][i] += t[c]*x[i];
+}
+
+LU1DPB_TARGET("avx512f")
+void LU1DPB_kernel_avx512(int n, int ny, REAL *t, REAL *x, REAL **y)
+{
+  LU1DPB_NOCONTRACT
+  int     c, i, n8 = n & ~7;
+  __m512d xv, tv[4];
+
+  for(c = 0; c < ny; c++)
+    tv[c] = _mm512_set1_pd(t[c]);
+  for(i = 0; i < n8; i += 8) {
+    xv = _mm512_loadu_pd(x+i);
+    for(c = 0; c < ny; c++)
+      _mm512_storeu_pd(y[c]+i, _mm512_add_pd(_mm512_loadu_pd(y[c]+i),
+                                             _mm512_mul_pd(tv[c], xv)));
+  }
+  for(; i < n; i++)
+    for(c = 0; c < ny; c++)
+      y[c][i] += t[c]*x[i];
+}
+#endif
+
+/* Pick the best kernel for the instruction sets detected by init_BLAS;
+   called by LUSOL_create, so that the choice is made before any
+   factorization threads are started */
+LU1DPB_kernel_func *LU1DPB_kernel(void)
+{
+#ifdef LUSOLDenseSIMD
+  init_BLAS();
+  if(simd_levelBLAS() >= BLAS_SIMD_AVX512)
+    return( LU1DPB_kernel_avx512 );
+  else if(simd_levelBLAS() >= BLAS_SIMD_AVX2)
+    return( LU1DPB_kernel_avx2 );
+#endif
+  return( LU1DPB_kernel_c );
+}
+
+/* Apply the elimination steps k1..k2 to the columns j1..j2 of DA */
+void LU1DPB_update(REAL DA[], int LDA, int M, int K1, int K2, int IPVT[],
+                   int J1, int J2, LU1DPB_kernel_func *kernel)
+{
+  int  c, J, K, L, NC, NY, IDA1, IDA2;
+  REAL T, TY[4], *Y[4];
+
+  for(J = J1; J <= J2; J += 4) {
+    NC = MIN(4, J2-J+1);
+    for(K = K1; K <= K2; K++) {
+      L = IPVT[K];
+      NY = 0;
+      for(c = 0; c < NC; c++) {
+        IDA1 = DAPOS(L,J+c);
+        T = DA[IDA1];
+        if(L!=K) {
+          IDA2 = DAPOS(K,J+c);
+          DA[IDA1] = DA[IDA2];
+          DA[IDA2] = T;
+        }
+        /* Zero multiples are skipped, as in daxpy */
+        if(T != 0) {
+          TY[NY] = T;
+          Y[NY] = DA+DAPOS(K+1,J+c);
+          NY++;
+        }
+      }
+      if((NY > 0) && (M > K))
+        kernel(M-K, NY, TY, DA+DAPOS(K+1,K), Y);
+    }
+  }
+}
+
+/* Shared record of a threaded trailing update */
+typedef struct _LU1DPBrec
+{
+  REAL *DA;
+  int  *IPVT;
+  int  LDA, M, K1, K2, J1, J2;
+  LU1DPB_kernel_func *kernel;
+} LU1DPBrec;
+
+/* Worker for one contiguous range of 4-column groups; the columns are
+   independent, so the result does not depend on the thread count */
+void LU1DPB_updatethread(void *data, int threadnr, int threadcount)
+{
+  LU1DPBrec *rec = (LU1DPBrec *) data;
+  int       lo, hi;
+
+  thread_partition(threadnr, threadcount, 0, (rec->J2-rec->J1)/4, &lo, &hi);
+  if(lo <= hi)
+    LU1DPB_update(rec->DA, rec->LDA, rec->M, rec->K1, rec->K2, rec->IPVT,
+                  rec->J1+4*lo, MIN(rec->J1+4*hi+3, rec->J2), rec->kernel);
+}
+
+/* Trailing update, split over the threads set in luparm when the work
+   is large enough to amortize handing it to the worker threads */
+void LU1DPB_trailing(LUSOLrec *LUSOL, REAL DA[], int LDA, int M, int K1, int K2,
+                     int IPVT[], int J1, int J2, LU1DPB_kernel_func *kernel)
+{
+  int       threads = LUSOL->luparm[LUSOL_IP_THREADS];
+  LU1DPBrec rec;
+
+  if(J1 > J2)
+    return;
+  SETMIN(threads, (J2-J1)/4+1);
+  if((threads <= 1) ||
+     ((REAL) (J2-J1+1)*(K2-K1+1)*(M-K1) < LUSOL_DENSEPARALLEL)) {
+    LU1DPB_update(DA, LDA, M, K1, K2, IPVT, J1, J2, kernel);
+    return;
+  }
+  rec.DA     = DA;
+  rec.IPVT   = IPVT;
+  rec.LDA    = LDA;
+  rec.M      = M;
+  rec.K1     = K1;
+  rec.K2     = K2;
+  rec.J1     = J1;
+  rec.J2     = J2;
+  rec.kernel = kernel;
+  thread_run(threads, LU1DPB_updatethread, &rec);
+}
+
+/* ==================================================================
+   lu1DPB  factors a dense m x n matrix A exactly like lu1DPP, but
+   processes the columns in panels; see lu1DPP for the arguments.
+   ================================================================== */
+void LU1DPB(LUSOLrec *LUSOL, REAL DA[], int LDA, int M, int N, REAL SMALL,
+            int *NSING, int IPVT[], int IX[])
+{
+  MYBOOL DONE = FALSE;
+  int    I, J, K, KB, KEND, L, LAST, LENCOL;
+  REAL   T;
+  LU1DPB_kernel_func *kernel = LUSOL->densekernel;
+
+  *NSING = 0;
+  K = 1;
+  LAST = N;
+  while(!DONE && (K <= LAST)) {
+    KB = K;
+    KEND = MIN(KB+LUSOL_DENSEBLOCK-1, LAST);
+/*      ------------------------------------------------------------------
+        Factor the panel kb:kend with the trailing columns left pending.
+        ------------------------------------------------------------------ */
+    while(K <= KEND) {
+      LENCOL = (M-K)+1;
+      L = (idamax(LENCOL,DA+DAPOS(K,K)-LUSOL_ARRAYOFFSET,1)+K)-1;
+      IPVT[K] = L;
+      if(fabs(DA[DAPOS(L,K)])<=SMALL) {
+/*         Column interchange with the last live column, which must first
+           catch up with the steps of the panel done so far. */
+        (*NSING)++;
+        if(LAST > KEND)
+          LU1DPB_update(DA, LDA, M, KB, K-1, IPVT, LAST, LAST, kernel);
+        J = IX[LAST];
+        IX[LAST] = IX[K];
+        IX[K] = J;
+        for(I = 1; I <= K-1; I++) {
+          T = DA[DAPOS(I,LAST)];
+          DA[DAPOS(I,LAST)] = DA[DAPOS(I,K)];
+          DA[DAPOS(I,K)] = T;
+        }
+        for(I = K; I <= M; I++) {
+          T = DA[DAPOS(I,LAST)];
+          DA[DAPOS(I,LAST)] = ZERO;
+          DA[DAPOS(I,K)] = T;
+        }
+        LAST--;
+        SETMIN(KEND, LAST);
+      }
+      else if(M>K) {
+/*         Row interchange, multipliers and elimination within the panel. */
+        if(L!=K) {
+          T = DA[DAPOS(L,K)];
+          DA[DAPOS(L,K)] = DA[DAPOS(K,K)];
+          DA[DAPOS(K,K)] = T;
+        }
+        T = -ONE/DA[DAPOS(K,K)];
+        dscal(M-K,T,DA+DAPOS(K+1,K)-LUSOL_ARRAYOFFSET,1);
+        for(J = K+1; J <= KEND; J++) {
+          T = DA[DAPOS(L,J)];
+          if(L!=K) {
+            DA[DAPOS(L,J)] = DA[DAPOS(K,J)];
+            DA[DAPOS(K,J)] = T;
+          }
+          daxpy(M-K,T,DA+DAPOS(K+1,K)-LUSOL_ARRAYOFFSET,1,
+                      DA+DAPOS(K+1,J)-LUSOL_ARRAYOFFSET,1);
+        }
+        K++;
+      }
+      else {
+/*         Last row reached; nothing is left to eliminate. */
+        DONE = TRUE;
+        break;
+      }
+    }
+/*      ------------------------------------------------------------------
+        Bring the trailing columns up to date with the panel.
+        ------------------------------------------------------------------ */
+    if(K-1 >= KB)
+      LU1DPB_trailing(LUSOL, DA, LDA, M, KB, K-1, IPVT, KEND+1, LAST, kernel);
+  }
+/*      Set ipvt(*) for singular rows. */
+  for(K = LAST+1; K <= M; K++)
+    IPVT[K] = K;
+
+}
@@ -346,6 +346,12 @@ void LU6CHK(LUSOLrec *LUSOL, int MODE, int LENA2, int *INFORM)
 #include "lusol6l0.c"
 
 
+/* ------------------------------------------------------------------
+   Include routines for hypersparse solves.
+   ------------------------------------------------------------------ */
+#include "lusol6h.c"
+
+
 /* ------------------------------------------------------------------
    lu6L   solves   L v = v(input).
    ------------------------------------------------------------------
@@ -354,9 +360,10 @@ void LU6CHK(LUSOLrec *LUSOL, int MODE, int LENA2, int *INFORM)
    ------------------------------------------------------------------ */
 void LU6L(LUSOLrec *LUSOL, int *INFORM, REAL V[], int NZidx[])
 {
-  int  JPIV, K, L, L1, LEN, LENL, LENL0, NUML, NUML0;
+  int  JPIV, K, L, L1, LEN, LENL, LENL0, NUML, NUML0, IW, JV;
   REAL SMALL;
   register REAL VPIV;
+  register REALXP SUM;
 #ifdef LUSOLFastSolve
   REAL *aptr;
   int  *iptr, *jptr;
@@ -370,6 +377,12 @@ void LU6L(LUSOLrec *LUSOL, int *INFORM, REAL V[], int NZidx[])
   SMALL = LUSOL->parmlu[LUSOL_RP_ZEROTOLERANCE];
   *INFORM = LUSOL_INFORM_LUSUCCESS;
   L1 = LUSOL->lena+1;
+  /* Only visit the columns of L0 reached from a sparse rhs, if possible;
+     otherwise the nonzero pattern of the result is not known */
+  if(LU6L0_hyper(LUSOL, V, NZidx))
+    NUML0 = 0;
+  else if(NZidx != NULL)
+    NZidx[0] = -1;
   for(K = 1; K <= NUML0; K++) {
     LEN = LUSOL->lenc[K];
     L = L1;
@@ -398,6 +411,46 @@ void LU6L(LUSOLrec *LUSOL, int *INFORM, REAL V[], int NZidx[])
   }
   L = (LUSOL->lena-LENL0)+1;
   NUML = LENL-LENL0;
+
+  /* Add the rows that the L updates may fill to the nonzero pattern of v */
+  if((NZidx != NULL) && (NZidx[0] >= 0) && (NUML > 0)) {
+    for(K = 1; K <= NZidx[0]; K++)
+      LUSOL->hypermark[NZidx[K]] = TRUE;
+    for(L1 = L-NUML; L1 < L; L1++) {
+      K = LUSOL->indc[L1];
+      if(!LUSOL->hypermark[K]) {
+        LUSOL->hypermark[K] = TRUE;
+        NZidx[++NZidx[0]] = K;
+      }
+    }
+    for(K = 1; K <= NZidx[0]; K++)
+      LUSOL->hypermark[NZidx[K]] = FALSE;
+  }
+
+/*     Forrest-Tomlin updates are row etas, i.e. runs of multipliers that
+       all modify the same row  iw  of v; apply each run as an inner product. */
+  if(LUSOL->luparm[LUSOL_IP_UPDATEMODEL] == LUSOL_UPDMOD_FT) {
+    while(NUML > 0) {
+      L--;
+      IW = LUSOL->indc[L];
+      SUM = ZERO;
+      for(;;) {
+        JV = LUSOL->indr[L];
+        if(fabs(V[JV])>SMALL)
+          SUM += LUSOL->a[L]*V[JV];
+#ifdef SetSmallToZero
+        else
+          V[JV] = 0;
+#endif
+        NUML--;
+        if((NUML == 0) || (LUSOL->indc[L-1] != IW))
+          break;
+        L--;
+      }
+      V[IW] += SUM;
+    }
+  }
+  else {
 /*     ***** This loop could be coded specially. */
 #ifdef LUSOLFastSolve
   L--;
@@ -424,6 +477,7 @@ void LU6L(LUSOLrec *LUSOL, int *INFORM, REAL V[], int NZidx[])
 #endif
   }
 #endif
+  }
 /*      Exit. */
   LUSOL->luparm[LUSOL_IP_INFORM] = *INFORM;
 }
@@ -510,7 +564,7 @@ void LU6LT(LUSOLrec *LUSOL, int *INFORM, REAL V[], int NZidx[])
 #ifdef DoTraceL0
   REAL    TEMP;
 #endif
-  int     K, L, L1, L2, LEN, LENL, LENL0, NUML0;
+  int     K, L, L1, L2, LEN, LENL, LENL0, NUML0, IW;
   REAL    SMALL;
   register REALXP SUM;
   register REAL HOLD;
@@ -529,6 +583,44 @@ void LU6LT(LUSOLrec *LUSOL, int *INFORM, REAL V[], int NZidx[])
   L1 = (LUSOL->lena-LENL)+1;
   L2 = LUSOL->lena-LENL0;
 
+  /* Add the rows that the L updates may fill to the nonzero pattern of v */
+  if((NZidx != NULL) && (NZidx[0] >= 0) && (L1 <= L2)) {
+    for(K = 1; K <= NZidx[0]; K++)
+      LUSOL->hypermark[NZidx[K]] = TRUE;
+    for(L = L1; L <= L2; L++) {
+      K = LUSOL->indr[L];
+      if(!LUSOL->hypermark[K]) {
+        LUSOL->hypermark[K] = TRUE;
+        NZidx[++NZidx[0]] = K;
+      }
+    }
+    for(K = 1; K <= NZidx[0]; K++)
+      LUSOL->hypermark[NZidx[K]] = FALSE;
+  }
+
+/*     Apply the row etas of Forrest-Tomlin updates as one scatter of the
+       multipliers each, or skip them altogether if their row of v is zero */
+  if(LUSOL->luparm[LUSOL_IP_UPDATEMODEL] == LUSOL_UPDMOD_FT) {
+    for(L = L1; L <= L2; ) {
+      IW = LUSOL->indc[L];
+      HOLD = V[IW];
+      if(fabs(HOLD)>SMALL) {
+        do {
+          V[LUSOL->indr[L]] += LUSOL->a[L]*HOLD;
+          L++;
+        } while((L <= L2) && (LUSOL->indc[L] == IW));
+      }
+      else {
+#ifdef SetSmallToZero
+        V[IW] = 0;
+#endif
+        do {
+          L++;
+        } while((L <= L2) && (LUSOL->indc[L] == IW));
+      }
+    }
+  }
+  else
 /*     ***** This loop could be coded specially. */
 #if (defined LUSOLFastSolve) && !(defined DoTraceL0)
   for(L = L1, aptr = LUSOL->a+L1, iptr = LUSOL->indr+L1, jptr = LUSOL->indc+L1;
@@ -559,7 +651,8 @@ void LU6LT(LUSOLrec *LUSOL, int *INFORM, REAL V[], int NZidx[])
   /* Do row-based L0 version, if available */
   if((LUSOL->L0 != NULL) ||
      ((LUSOL->luparm[LUSOL_IP_BTRANCOUNT] == 0) && LU1L0(LUSOL, &(LUSOL->L0), INFORM))) {
-    LU6L0T_v(LUSOL, LUSOL->L0, V, NZidx, INFORM);
+    if(!LU6L0T_hyper(LUSOL, LUSOL->L0, V, NZidx))
+      LU6L0T_v(LUSOL, LUSOL->L0, V, NZidx, INFORM);
   }
 
   /* Alternatively, do the standard column-based L0 version */
@@ -641,6 +734,10 @@ void print_L0(LUSOLrec *LUSOL)
    ================================================================== */
 void LU6U(LUSOLrec *LUSOL, int *INFORM, REAL V[], REAL W[], int NZidx[])
 {
+  /* Only solve with the rows of U reached from a sparse v, if possible */
+  if(LU6U_hyper(LUSOL, INFORM, V, W, NZidx))
+    return;
+
   /* Do column-based U version, if available */
   if((LUSOL->U != NULL) ||
      ((LUSOL->luparm[LUSOL_IP_FTRANCOUNT] == 0) && LU1U0(LUSOL, &(LUSOL->U), INFORM))) {
@@ -731,6 +828,12 @@ void LU6UT(LUSOLrec *LUSOL, int *INFORM, REAL V[], REAL W[], int NZidx[])
   int  *jptr;
 #endif
 
+  /* Only visit the rows of U reached from a sparse w, if possible */
+  if(LU6UT_hyper(LUSOL, INFORM, V, W, NZidx))
+    return;
+  if(NZidx != NULL)
+    NZidx[0] = -1;
+
   NRANK = LUSOL->luparm[LUSOL_IP_RANK_U];
   SMALL = LUSOL->parmlu[LUSOL_RP_ZEROTOLERANCE];
   *INFORM = LUSOL_INFORM_LUSUCCESS;
@@ -849,11 +952,11 @@ void LU6SOL(LUSOLrec *LUSOL, int MODE, REAL V[], REAL W[], int NZidx[], int *INF
   }
   else if(MODE==LUSOL_SOLVE_Aw_v) {     /* Solve  A w      = v (i.e. FTRAN) */
     LU6L(LUSOL, INFORM,V, NZidx);        /* via     L v(new) = v */
-    LU6U(LUSOL, INFORM,V,W, NULL);       /* ... and U w = v(new). */
+    LU6U(LUSOL, INFORM,V,W, NZidx);      /* ... and U w = v(new). */
   }
   else if(MODE==LUSOL_SOLVE_Atv_w) {    /* Solve  A'v = w (i.e. BTRAN) */
     LU6UT(LUSOL, INFORM,V,W, NZidx);     /* via      U'v = w */
-    LU6LT(LUSOL, INFORM,V, NULL);        /* ... and  L'v(new) = v. */
+    LU6LT(LUSOL, INFORM,V, NZidx);       /* ... and  L'v(new) = v. */
   }
   else if(MODE==LUSOL_SOLVE_Av_v) {     /* Solve  LDv(bar) = v */
     LU6LD(LUSOL, INFORM,1,V, NZidx);     /* and    L'v(new) = v(bar). */
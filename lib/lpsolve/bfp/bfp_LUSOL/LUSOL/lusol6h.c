@@ -0,0 +1,551 @@
+
+/* Hypersparse triangular solves.
+   When the right-hand side has only a handful of nonzeros, most of the
+   columns of L0 and rows of U are skipped by the standard sweeps, but the
+   sweeps still touch every one of them.  Here we first determine the set
+   of pivots that can be reached from the nonzeros of the rhs by following
+   the nonzero structure of the factor (Gilbert-Peierls symbolic phase),
+   and then only do the numeric work for those pivots.  The symbolic phase
+   is seeded from the index list of the rhs nonzeros, which LUSOL_ftran and
+   LUSOL_btran collect while copying the rhs, and which the U' solve passes
+   on to the L0' solve of a btran.  The reached pivots
+   are processed in the same order as in the full sweep, so that the result
+   is identical to that of the standard solve.  If the reach grows beyond
+   parmlu[LUSOL_RP_HYPERSPARSE] of the dimension, the symbolic phase is
+   abandoned and the caller falls back to the standard sweep.
+   The U solve of an ftran needs the rows of U that hold a given column.
+   U is stored by rows only, so a column pattern of U is set up at the
+   first such solve after a factorization.  The updates add the entries
+   they create (lu7add, lu7elm) and the rows they fill in (lu7for), so
+   that the pattern stays a superset of the structure of U; entries that
+   the updates delete remain listed, which only enlarges the reach. */
+
+#define LUSOL_HYPER_L0               1  /* Columns of L0, by pivot row */
+#define LUSOL_HYPER_L0T              2  /* Rows of the row-based L0 copy */
+#define LUSOL_HYPER_UT               3  /* Rows of U, by pivot column */
+#define LUSOL_HYPER_U                4  /* Columns of U, by pivot row */
+
+/* Make sure that the work arrays cover the current dimensions */
+MYBOOL LU6HYP_alloc(LUSOLrec *LUSOL)
+{
+  int oldsize = LUSOL->hypersize,
+      newsize = MAX(LUSOL->maxm, LUSOL->maxn)+1;
+
+  if(newsize <= oldsize)
+    return( TRUE );
+
+  LUSOL->hypermark   = (int *) clean_realloc(LUSOL->hypermark,   sizeof(int), newsize, oldsize);
+  LUSOL->hyperlist   = (int *) clean_realloc(LUSOL->hyperlist,   sizeof(int), newsize, oldsize);
+  LUSOL->hyperrhs    = (int *) clean_realloc(LUSOL->hyperrhs,    sizeof(int), newsize, oldsize);
+  LUSOL->hyperL0col  = (int *) clean_realloc(LUSOL->hyperL0col,  sizeof(int), newsize, oldsize);
+  LUSOL->hyperL0loc  = (int *) clean_realloc(LUSOL->hyperL0loc,  sizeof(int), newsize, oldsize);
+  LUSOL->hyperL0Tpos = (int *) clean_realloc(LUSOL->hyperL0Tpos, sizeof(int), newsize, oldsize);
+  LUSOL->hyperUpos   = (int *) clean_realloc(LUSOL->hyperUpos,   sizeof(int), newsize, oldsize);
+  LUSOL->hyperUrowpos = (int *) clean_realloc(LUSOL->hyperUrowpos, sizeof(int), newsize, oldsize);
+  LUSOL->hyperUhead  = (int *) clean_realloc(LUSOL->hyperUhead,  sizeof(int), newsize, oldsize);
+  LUSOL->hyperUdirty = (int *) clean_realloc(LUSOL->hyperUdirty, sizeof(int), newsize, oldsize);
+  LUSOL->hyperL0ok = LUSOL->hyperL0Tok = LUSOL->hyperUok = LUSOL->hyperUcolok = FALSE;
+  if((LUSOL->hypermark == NULL) || (LUSOL->hyperlist == NULL) || (LUSOL->hyperrhs == NULL) ||
+     (LUSOL->hyperL0col == NULL) || (LUSOL->hyperL0loc == NULL) ||
+     (LUSOL->hyperL0Tpos == NULL) || (LUSOL->hyperUpos == NULL) ||
+     (LUSOL->hyperUrowpos == NULL) || (LUSOL->hyperUhead == NULL) || (LUSOL->hyperUdirty == NULL)) {
+    LU6HYP_free(LUSOL);
+    return( FALSE );
+  }
+  LUSOL->hypersize = newsize;
+  return( TRUE );
+}
+
+void LU6HYP_free(LUSOLrec *LUSOL)
+{
+  LUSOL_FREE(LUSOL->hypermark);
+  LUSOL_FREE(LUSOL->hyperlist);
+  LUSOL_FREE(LUSOL->hyperrhs);
+  LUSOL_FREE(LUSOL->hyperL0col);
+  LUSOL_FREE(LUSOL->hyperL0loc);
+  LUSOL_FREE(LUSOL->hyperL0Tpos);
+  LUSOL_FREE(LUSOL->hyperUpos);
+  LUSOL_FREE(LUSOL->hyperUrowpos);
+  LUSOL_FREE(LUSOL->hyperUhead);
+  LUSOL_FREE(LUSOL->hyperUdirty);
+  LUSOL_FREE(LUSOL->hyperUcolrow);
+  LUSOL_FREE(LUSOL->hyperUcolnext);
+  LUSOL->hypersize = 0;
+  LUSOL->hyperUcolitems = LUSOL->hyperUcolalloc = 0;
+  LUSOL->hyperL0ok = LUSOL->hyperL0Tok = LUSOL->hyperUok = LUSOL->hyperUcolok = FALSE;
+}
+
+/* Add row i to the column pattern list of column j of U */
+static MYBOOL LU6HYP_addUcol(LUSOLrec *LUSOL, int i, int j)
+{
+  int n = LUSOL->hyperUcolitems+1, newalloc;
+
+  if(n >= LUSOL->hyperUcolalloc) {
+    newalloc = MAX(2*LUSOL->hyperUcolalloc, LUSOL->hypersize);
+    LUSOL->hyperUcolrow  = (int *) LUSOL_REALLOC(LUSOL->hyperUcolrow,  newalloc*sizeof(int));
+    LUSOL->hyperUcolnext = (int *) LUSOL_REALLOC(LUSOL->hyperUcolnext, newalloc*sizeof(int));
+    if((LUSOL->hyperUcolrow == NULL) || (LUSOL->hyperUcolnext == NULL)) {
+      LUSOL_FREE(LUSOL->hyperUcolrow);
+      LUSOL_FREE(LUSOL->hyperUcolnext);
+      LUSOL->hyperUcolitems = LUSOL->hyperUcolalloc = 0;
+      LUSOL->hyperUcolok = FALSE;
+      return( FALSE );
+    }
+    LUSOL->hyperUcolalloc = newalloc;
+  }
+  LUSOL->hyperUcolrow[n]  = i;
+  LUSOL->hyperUcolnext[n] = LUSOL->hyperUhead[j];
+  LUSOL->hyperUhead[j]    = n;
+  LUSOL->hyperUcolitems   = n;
+  return( TRUE );
+}
+
+/* Set up the column pattern of U from the row file, or bring it up to date
+   with the rows that were filled in by updates since the last U solve; the
+   pattern is set up anew when the deleted entries make up most of it */
+static MYBOOL LU6HYP_patternU(LUSOLrec *LUSOL)
+{
+  int I, K, L, L1, L2, *dirty = LUSOL->hyperUdirty;
+
+  if(!LUSOL->hyperUcolok ||
+     (LUSOL->hyperUcolitems > 2*LUSOL->luparm[LUSOL_IP_NONZEROS_U]+LUSOL->m)) {
+    MEMCLEAR(LUSOL->hyperUhead, LUSOL->n+1);
+    LUSOL->hyperUcolitems = 0;
+    LUSOL->hyperUcolok = TRUE;
+    for(I = 1; I <= LUSOL->m; I++) {
+      L1 = LUSOL->locr[I];
+      L2 = (L1+LUSOL->lenr[I])-1;
+      for(L = L1; L <= L2; L++)
+        if(!LU6HYP_addUcol(LUSOL, I, LUSOL->indr[L]))
+          return( FALSE );
+    }
+  }
+  else {
+    for(K = 1; K <= dirty[0]; K++) {
+      I = dirty[K];
+      L1 = LUSOL->locr[I];
+      L2 = (L1+LUSOL->lenr[I])-1;
+      for(L = L1; L <= L2; L++)
+        if(!LU6HYP_addUcol(LUSOL, I, LUSOL->indr[L]))
+          return( FALSE );
+    }
+  }
+  dirty[0] = 0;
+  return( TRUE );
+}
+
+/* Record that an update has put an entry of column j of U in row i */
+void LU6HYP_touchU(LUSOLrec *LUSOL, int i, int j)
+{
+  if(LUSOL->hyperUcolok)
+    LU6HYP_addUcol(LUSOL, i, j);
+}
+
+/* Record that an update may have filled in row i of U; its columns are
+   added to the pattern before the next U solve */
+void LU6HYP_touchrowU(LUSOLrec *LUSOL, int i)
+{
+  int *dirty = LUSOL->hyperUdirty;
+
+  if(!LUSOL->hyperUcolok || ((dirty[0] > 0) && (dirty[dirty[0]] == i)))
+    return;
+  if(dirty[0] >= LUSOL->hypersize-1)
+    LUSOL->hyperUcolok = FALSE;
+  else
+    dirty[++dirty[0]] = i;
+}
+
+/* Check if the hypersparse solves are active and the work arrays exist */
+static MYBOOL LU6HYP_active(LUSOLrec *LUSOL)
+{
+  return( (MYBOOL) (((LUSOL->luparm[LUSOL_IP_ACCELERATION] & LUSOL_ACCELERATE_HYPER) != 0) &&
+                    (LUSOL->parmlu[LUSOL_RP_HYPERSPARSE] > 0) && LU6HYP_alloc(LUSOL)) );
+}
+
+/* Copy the rhs b[1..dim] to V and return the index list of its nonzeros in
+   hyperrhs, with the count in hyperrhs[0].  The list is taken from NZidx if
+   the caller has one, else it is gathered in the copy loop.  Returns NULL
+   after a plain copy if the hypersparse solves are not active. */
+int *LU6HYP_copyrhs(LUSOLrec *LUSOL, REAL V[], REAL b[], int NZidx[], int dim)
+{
+  int i, n, *list;
+
+  if(!LU6HYP_active(LUSOL)) {
+    MEMCOPY(V+1, b+1, dim);
+    return( NULL );
+  }
+
+  list = LUSOL->hyperrhs;
+  if(NZidx != NULL) {
+    MEMCOPY(V+1, b+1, dim);
+    MEMCOPY(list, NZidx, NZidx[0]+1);
+  }
+  else {
+    n = 0;
+    for(i = 1; i <= dim; i++) {
+      V[i] = b[i];
+      if(V[i] != 0)
+        list[++n] = i;
+    }
+    list[0] = n;
+  }
+  return( list );
+}
+
+/* Check if the hypersparse solves are active and set up the pivot maps of
+   the requested graph; the maps are valid until the next factorization
+   (L0 and its row copy) or the next column replacement (U). */
+MYBOOL LU6HYP_prepare(LUSOLrec *LUSOL, int graph)
+{
+  int K, L1, NUML0, *map;
+
+  if(!LU6HYP_active(LUSOL))
+    return( FALSE );
+
+  if((graph == LUSOL_HYPER_L0) && !LUSOL->hyperL0ok) {
+    NUML0 = LUSOL->luparm[LUSOL_IP_COLCOUNT_L0];
+    map = LUSOL->hyperL0col;
+    MEMCLEAR(map, LUSOL->m+1);
+    L1 = LUSOL->lena+1;
+    for(K = 1; K <= NUML0; K++) {
+      L1 -= LUSOL->lenc[K];
+      LUSOL->hyperL0loc[K] = L1;
+      if(LUSOL->lenc[K] > 0)
+        map[LUSOL->indr[L1]] = K;
+    }
+    LUSOL->hyperL0ok = TRUE;
+  }
+  else if((graph == LUSOL_HYPER_L0T) && !LUSOL->hyperL0Tok) {
+    NUML0 = LUSOL->luparm[LUSOL_IP_ROWCOUNT_L0];
+    map = LUSOL->hyperL0Tpos;
+    MEMCLEAR(map, LUSOL->m+1);
+    for(K = 1; K <= NUML0; K++)
+      map[LUSOL->L0->indx[K]] = K;
+    LUSOL->hyperL0Tok = TRUE;
+  }
+  else if((graph == LUSOL_HYPER_UT) || (graph == LUSOL_HYPER_U)) {
+    if((graph == LUSOL_HYPER_U) && !LU6HYP_patternU(LUSOL))
+      return( FALSE );
+    if(!LUSOL->hyperUok) {
+      map = LUSOL->hyperUpos;
+      for(K = 1; K <= LUSOL->n; K++)
+        map[LUSOL->iq[K]] = K;
+      map = LUSOL->hyperUrowpos;
+      for(K = 1; K <= LUSOL->m; K++)
+        map[LUSOL->ip[K]] = K;
+      LUSOL->hyperUok = TRUE;
+    }
+  }
+  return( TRUE );
+}
+
+/* Compute the set of pivots reached from the nonzeros of V[1..dim] and
+   return them in hyperlist[1..n] as pivot positions in increasing order,
+   or return -1 if the reach is too dense to make the effort worthwhile.
+   NZidx lists (a superset of) the nonzeros of V, possibly with repeats;
+   V is only scanned when there is no list or its count is negative. */
+int LU6HYP_reach(LUSOLrec *LUSOL, int graph, REAL V[], int dim, int NZidx[])
+{
+  int  i, j, k, n, nk, L, L1, L2, maxn,
+       *mark = LUSOL->hypermark, *list = LUSOL->hyperlist, *index;
+  int  NRANK = LUSOL->luparm[LUSOL_IP_RANK_U];
+
+  maxn = (int) (LUSOL->parmlu[LUSOL_RP_HYPERSPARSE]*dim);
+  n = 0;
+
+  /* Seed with the nonzeros of the rhs */
+  if((NZidx != NULL) && (NZidx[0] >= 0)) {
+    for(k = 1; k <= NZidx[0]; k++) {
+      i = NZidx[k];
+      if((V[i] == 0) || mark[i])
+        continue;
+      if(n >= maxn)
+        goto Dense;
+      mark[i] = TRUE;
+      list[++n] = i;
+    }
+  }
+  else {
+    for(i = 1; i <= dim; i++) {
+      if(V[i] == 0)
+        continue;
+      if(n >= maxn)
+        goto Dense;
+      mark[i] = TRUE;
+      list[++n] = i;
+    }
+  }
+
+  /* Extend to everything that can be reached from the seeds */
+  for(k = 1; k <= n; k++) {
+    i = list[k];
+    L1 = 1;
+    L2 = 0;
+    index = NULL;
+    if(graph == LUSOL_HYPER_L0) {
+      j = LUSOL->hyperL0col[i];
+      if(j > 0) {
+        L1 = LUSOL->hyperL0loc[j];
+        L2 = L1+LUSOL->lenc[j]-1;
+        index = LUSOL->indc;
+      }
+    }
+    else if(graph == LUSOL_HYPER_L0T) {
+      if(LUSOL->hyperL0Tpos[i] > 0) {
+        L1 = LUSOL->L0->lenx[i-1];
+        L2 = LUSOL->L0->lenx[i]-1;
+        index = LUSOL->L0->indr;
+      }
+    }
+    else if(graph == LUSOL_HYPER_UT) {
+      j = LUSOL->hyperUpos[i];
+      if(j <= NRANK) {
+        j = LUSOL->ip[j];
+        L1 = LUSOL->locr[j]+1;
+        L2 = LUSOL->locr[j]+LUSOL->lenr[j]-1;
+        index = LUSOL->indr;
+      }
+    }
+    else {
+      j = LUSOL->hyperUrowpos[i];
+      if(j > NRANK)
+        continue;
+      for(L = LUSOL->hyperUhead[LUSOL->iq[j]]; L > 0; L = LUSOL->hyperUcolnext[L]) {
+        j = LUSOL->hyperUcolrow[L];
+        if(mark[j])
+          continue;
+        if(n >= maxn)
+          goto Dense;
+        mark[j] = TRUE;
+        list[++n] = j;
+      }
+      continue;
+    }
+    for(L = L1; L <= L2; L++) {
+      j = index[L];
+      if(mark[j])
+        continue;
+      if(n >= maxn)
+        goto Dense;
+      mark[j] = TRUE;
+      list[++n] = j;
+    }
+  }
+
+  /* Map the reached nodes to pivot positions, dropping those that carry
+     no column/row in the factor, and sort in pivotal order */
+  nk = 0;
+  for(k = 1; k <= n; k++) {
+    i = list[k];
+    mark[i] = FALSE;
+    if(graph == LUSOL_HYPER_L0)
+      j = LUSOL->hyperL0col[i];
+    else if(graph == LUSOL_HYPER_L0T)
+      j = LUSOL->hyperL0Tpos[i];
+    else {
+      j = (graph == LUSOL_HYPER_UT ? LUSOL->hyperUpos[i] : LUSOL->hyperUrowpos[i]);
+      if(j > NRANK)
+        j = 0;
+    }
+    if(j > 0)
+      list[++nk] = j;
+  }
+  if(nk > 1)
+    qsort(list+1, nk, sizeof(*list), compareINT);
+  return( nk );
+
+Dense:
+  for(k = 1; k <= n; k++)
+    mark[list[k]] = FALSE;
+  return( -1 );
+}
+
+/* Solve L0 v = v over the reached columns of L0; see LU6L.  With an index
+   list of v, the rows that the reached columns fill in are added to it, so
+   that it holds the nonzero pattern of v for the U solve of an ftran. */
+MYBOOL LU6L0_hyper(LUSOLrec *LUSOL, REAL V[], int NZidx[])
+{
+  int  I, JPIV, K, KK, L, L1, LEN, NK, *mark = LUSOL->hypermark;
+  REAL SMALL;
+  register REAL VPIV;
+
+  if(!LU6HYP_prepare(LUSOL, LUSOL_HYPER_L0))
+    return( FALSE );
+  NK = LU6HYP_reach(LUSOL, LUSOL_HYPER_L0, V, LUSOL->m, NZidx);
+  if(NK < 0)
+    return( FALSE );
+
+  if((NZidx != NULL) && (NZidx[0] < 0))
+    NZidx = NULL;
+  if(NZidx != NULL) {
+    for(K = 1; K <= NZidx[0]; K++)
+      mark[NZidx[K]] = TRUE;
+  }
+  SMALL = LUSOL->parmlu[LUSOL_RP_ZEROTOLERANCE];
+  for(KK = 1; KK <= NK; KK++) {
+    K = LUSOL->hyperlist[KK];
+    L1 = LUSOL->hyperL0loc[K];
+    LEN = LUSOL->lenc[K];
+    JPIV = LUSOL->indr[L1];
+    VPIV = V[JPIV];
+    if(fabs(VPIV)>SMALL) {
+      for(L = L1+LEN-1; L >= L1; L--) {
+        I = LUSOL->indc[L];
+        V[I] += LUSOL->a[L]*VPIV;
+        if((NZidx != NULL) && !mark[I]) {
+          mark[I] = TRUE;
+          NZidx[++NZidx[0]] = I;
+        }
+      }
+    }
+#ifdef SetSmallToZero
+    else
+      V[JPIV] = 0;
+#endif
+  }
+  if(NZidx != NULL) {
+    for(K = 1; K <= NZidx[0]; K++)
+      mark[NZidx[K]] = FALSE;
+  }
+  return( TRUE );
+}
+
+/* Solve L0'v = v over the reached rows of the row-based L0; see LU6L0T_v */
+MYBOOL LU6L0T_hyper(LUSOLrec *LUSOL, LUSOLmat *mat, REAL V[], int NZidx[])
+{
+  int  K, KK, L, L1, NK;
+  REAL SMALL;
+  register REAL VPIV;
+
+  if(!LU6HYP_prepare(LUSOL, LUSOL_HYPER_L0T))
+    return( FALSE );
+  NK = LU6HYP_reach(LUSOL, LUSOL_HYPER_L0T, V, LUSOL->m, NZidx);
+  if(NK < 0)
+    return( FALSE );
+
+  SMALL = LUSOL->parmlu[LUSOL_RP_ZEROTOLERANCE];
+  for(K = NK; K > 0; K--) {
+    KK = mat->indx[LUSOL->hyperlist[K]];
+    L  = mat->lenx[KK];
+    L1 = mat->lenx[KK-1];
+    if(L == L1)
+      continue;
+    VPIV = V[KK];
+    if(fabs(VPIV)>SMALL) {
+      for(L--; L >= L1; L--)
+        V[mat->indr[L]] += VPIV * mat->a[L];
+    }
+#ifdef SetSmallToZero
+    else
+      V[KK] = 0;
+#endif
+  }
+  return( TRUE );
+}
+
+/* Solve U'v = w over the reached rows of U; see LU6UT.  With an index list
+   of w, v is taken to be zero outside the listed entries (in a btran it
+   holds the rhs), so only those are cleared; on return the list then holds
+   the nonzero pattern of v, for the L0' solve that follows. */
+MYBOOL LU6UT_hyper(LUSOLrec *LUSOL, int *INFORM, REAL V[], REAL W[], int NZidx[])
+{
+  int  I, J, K, KK, L, L1, L2, NK, NRANK, NZ;
+  REAL SMALL;
+  register REAL T;
+
+  if(!LU6HYP_prepare(LUSOL, LUSOL_HYPER_UT))
+    return( FALSE );
+  NK = LU6HYP_reach(LUSOL, LUSOL_HYPER_UT, W, LUSOL->n, NZidx);
+  if(NK < 0)
+    return( FALSE );
+
+  NRANK = LUSOL->luparm[LUSOL_IP_RANK_U];
+  SMALL = LUSOL->parmlu[LUSOL_RP_ZEROTOLERANCE];
+  *INFORM = LUSOL_INFORM_LUSUCCESS;
+  if((NZidx != NULL) && (NZidx[0] >= 0)) {
+    for(KK = 1; KK <= NZidx[0]; KK++)
+      V[NZidx[KK]] = 0;
+  }
+  else {
+    MEMCLEAR(V+1, LUSOL->m);
+    NZidx = NULL;
+  }
+  NZ = 0;
+  for(KK = 1; KK <= NK; KK++) {
+    K = LUSOL->hyperlist[KK];
+    I = LUSOL->ip[K];
+    J = LUSOL->iq[K];
+    T = W[J];
+    if(fabs(T)<=SMALL)
+      continue;
+    L1 = LUSOL->locr[I];
+    T /= LUSOL->a[L1];
+    V[I] = T;
+    if(NZidx != NULL)
+      NZidx[++NZ] = I;
+    L2 = (L1+LUSOL->lenr[I])-1;
+    for(L = L1+1; L <= L2; L++)
+      W[LUSOL->indr[L]] -= T*LUSOL->a[L];
+  }
+/*      Compute residual for overdetermined systems. */
+  T = ZERO;
+  for(K = NRANK+1; K <= LUSOL->n; K++) {
+    J = LUSOL->iq[K];
+    T += fabs(W[J]);
+  }
+  if(T>ZERO)
+    *INFORM = LUSOL_INFORM_LUSINGULAR;
+  LUSOL->luparm[LUSOL_IP_INFORM]     = *INFORM;
+  LUSOL->parmlu[LUSOL_RP_RESIDUAL_U] = T;
+  if(NZidx != NULL)
+    NZidx[0] = NZ;
+  return( TRUE );
+}
+
+/* Solve U w = v over the reached rows of U; see LU6U.  The reach follows
+   the column pattern of U from the nonzeros of v, and the reached rows are
+   then solved by inner products in the same order as in the full sweep,
+   with w cleared elsewhere. */
+MYBOOL LU6U_hyper(LUSOLrec *LUSOL, int *INFORM, REAL V[], REAL W[], int NZidx[])
+{
+  int  I, J, K, KK, L, L1, L2, NK, NRANK;
+  REAL SMALL;
+  register REALXP T;
+
+  if(!LU6HYP_prepare(LUSOL, LUSOL_HYPER_U))
+    return( FALSE );
+  NK = LU6HYP_reach(LUSOL, LUSOL_HYPER_U, V, LUSOL->m, NZidx);
+  if(NK < 0)
+    return( FALSE );
+
+  NRANK = LUSOL->luparm[LUSOL_IP_RANK_U];
+  SMALL = LUSOL->parmlu[LUSOL_RP_ZEROTOLERANCE];
+  *INFORM = LUSOL_INFORM_LUSUCCESS;
+  MEMCLEAR(W+1, LUSOL->n);
+  for(KK = NK; KK > 0; KK--) {
+    K = LUSOL->hyperlist[KK];
+    I = LUSOL->ip[K];
+    T = V[I];
+    L1 = LUSOL->locr[I];
+    L2 = (L1+LUSOL->lenr[I])-1;
+    for(L = L1+1; L <= L2; L++)
+      T -= LUSOL->a[L]*W[LUSOL->indr[L]];
+    J = LUSOL->iq[K];
+    if(fabs((REAL) T)<=SMALL)
+      T = ZERO;
+    else
+      T /= LUSOL->a[L1];
+    W[J] = (REAL) T;
+  }
+/*      Compute residual for overdetermined systems. */
+  T = ZERO;
+  for(K = NRANK+1; K <= LUSOL->m; K++) {
+    I = LUSOL->ip[K];
+    T += fabs(V[I]);
+  }
+  if(T>ZERO)
+    *INFORM = LUSOL_INFORM_LUSINGULAR;
+  LUSOL->luparm[LUSOL_IP_INFORM]     = *INFORM;
+  LUSOL->parmlu[LUSOL_RP_RESIDUAL_U] = (REAL) T;
+  return( TRUE );
+}
@@ -21,7 +21,7 @@ MYBOOL LU1L0(LUSOLrec *LUSOL, LUSOLmat **mat, int *inform)
   LENL0 = LUSOL->luparm[LUSOL_IP_NONZEROS_L0];
   if((NUML0 == 0) || (LENL0 == 0) ||
      (LUSOL->luparm[LUSOL_IP_ACCELERATION] == LUSOL_BASEORDER) ||
-     ((LUSOL->luparm[LUSOL_IP_ACCELERATION] & LUSOL_ACCELERATE_L0) == 0))
+     ((LUSOL->luparm[LUSOL_IP_ACCELERATION] & (LUSOL_ACCELERATE_L0 | LUSOL_ACCELERATE_HYPER)) == 0))
     return( status );
 
   /* Allocate temporary array */
@@ -86,6 +86,7 @@ x180:
     LUSOL->indr[LR2] = JADD;
     LUSOL->lenr[I] = LENI+1;
     (*LENU)++;
+    LU6HYP_touchU(LUSOL, I, JADD);
   }
 /*      Normal exit. */
   *INFORM = LUSOL_INFORM_LUSUCCESS;
@@ -219,6 +220,7 @@ x100:
     LUSOL->lenr[IMAX] = 1;
     LUSOL->a[*LROW] = VMAX;
     LUSOL->indr[*LROW] = JELM;
+    LU6HYP_touchU(LUSOL, IMAX, JELM);
   }
   *INFORM = LUSOL_INFORM_LUSINGULAR;
   goto x990;
@@ -240,6 +242,12 @@ x990:
    triangular.
    The row permutation  ip  is updated to preserve stability and/or
    sparsity.  The column permutation  iq  is not altered.
+   With the Forrest-Tomlin update model (luparm[LUSOL_IP_UPDATEMODEL]),
+   rows are only interchanged when row  iv  has no diagonal to eliminate
+   with.  The other rows of  U  are then left unchanged, all fill-in stays
+   in row  iw,  and the multipliers form a single row eta: a contiguous
+   run of  L  elements that all modify row  iw,  which lu6L and lu6LT
+   apply as one inner product and one scatter respectively.
    kfirst  is such that row  ip(kfirst)  is the first row involved
    in eliminating row  iw.  (Hence,  kfirst  marks the first nonzero
    in row  iw  in pivotal order.)  If  kfirst  is unknown it may be
@@ -280,6 +288,7 @@ void LU7FOR(LUSOLrec *LUSOL, int KFIRST, int KLAST, int *LENL, int *LENU,
 /*      We come back here from below if a row interchange is performed. */
 x100:
   IW = LUSOL->ip[KLAST];
+  LU6HYP_touchrowU(LUSOL, IW);
   LENW = LUSOL->lenr[IW];
   if(LENW==0)
     goto x910;
@@ -337,6 +346,8 @@ x100:
     VJ = LUSOL->a[LV1];
     if(SWAPPD)
       goto x200;
+    if(LUSOL->luparm[LUSOL_IP_UPDATEMODEL] == LUSOL_UPDMOD_FT)
+      goto x200;
     if(LTOL*fabs(WJ)<fabs(VJ))
       goto x200;
     if(LTOL*fabs(VJ)<fabs(WJ))
@@ -62,6 +62,8 @@ void LU8RPC(LUSOLrec *LUSOL, int MODE1, int MODE2,
   NRANK0 = NRANK;
   *DIAG  = ZERO;
   *VNORM = ZERO;
+/*      The column permutation changes; the hypersparse U map is stale. */
+  LUSOL->hyperUok = FALSE;
   if(JREP<1)
     goto x980;
   if(JREP>LUSOL->n)
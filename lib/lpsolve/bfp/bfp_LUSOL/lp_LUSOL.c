@@ -76,7 +76,7 @@ MYBOOL BFP_CALLMODEL bfp_resize(lprec *lp, int newsize)
     lu->LUSOL = LUSOL_create(NULL, 0, LUSOL_PIVMOD_TPP, bfp_pivotmax(lp)*0);
 
 #if 1
-    lu->LUSOL->luparm[LUSOL_IP_ACCELERATION]  = LUSOL_AUTOORDER;
+    lu->LUSOL->luparm[LUSOL_IP_ACCELERATION]  = LUSOL_AUTOORDER | LUSOL_ACCELERATE_HYPER;
     lu->LUSOL->parmlu[LUSOL_RP_SMARTRATIO]    = 0.50;
 #endif
 #if 0
@@ -365,6 +365,13 @@ int BFP_CALLMODEL bfp_factorize(lprec *lp, int uservars, int Bsize, MYBOOL *used
     bfp_LUSOLtighten(lp);
 
 
+ /* Set the update model to be used until the next refactorization */
+  LUSOL->luparm[LUSOL_IP_UPDATEMODEL] = (lp->bfp_mode == BFPMODE_FORRESTTOMLIN ?
+                                         LUSOL_UPDMOD_FT : LUSOL_UPDMOD_BG);
+
+ /* Set the number of threads that the dense LU of the factorization may use */
+  LUSOL->luparm[LUSOL_IP_THREADS] = lp->num_threads;
+
  /* Reload B and factorize */
   inform = bfp_LUSOLfactorize(lp, usedpos, rownum, NULL);
 
@@ -586,8 +593,9 @@ void BFP_CALLMODEL bfp_ftran_normal(lprec *lp, REAL *pcol, int *nzidx)
 
   lu = lp->invB;
 
-  /* Do the LUSOL ftran */
-  i = LUSOL_ftran(lu->LUSOL, pcol-bfp_rowoffset(lp), nzidx, FALSE);
+  /* Do the LUSOL ftran; nzidx is not passed on, since lp_solve index lists
+     are not in the LUSOL row space and need not describe pcol */
+  i = LUSOL_ftran(lu->LUSOL, pcol-bfp_rowoffset(lp), NULL, FALSE);
   if(i != LUSOL_INFORM_LUSUCCESS) {
     lu->status = BFP_STATUS_ERROR;
     lp->report(lp, NORMAL, "bfp_ftran_normal: Failed at iter %.0f, pivot %d;\n%s\n",
@@ -605,7 +613,7 @@ void BFP_CALLMODEL bfp_ftran_prepare(lprec *lp, REAL *pcol, int *nzidx)
   lu = lp->invB;
 
   /* Do the LUSOL ftran */
-  i = LUSOL_ftran(lu->LUSOL, pcol-bfp_rowoffset(lp), nzidx, TRUE);
+  i = LUSOL_ftran(lu->LUSOL, pcol-bfp_rowoffset(lp), NULL, TRUE);
   if(i != LUSOL_INFORM_LUSUCCESS) {
     lu->status = BFP_STATUS_ERROR;
     lp->report(lp, NORMAL, "bfp_ftran_prepare: Failed at iter %.0f, pivot %d;\n%s\n",
@@ -623,7 +631,7 @@ void BFP_CALLMODEL bfp_btran_normal(lprec *lp, REAL *prow, int *nzidx)
   lu = lp->invB;
 
   /* Do the LUSOL btran */
-  i = LUSOL_btran(lu->LUSOL, prow-bfp_rowoffset(lp), nzidx);
+  i = LUSOL_btran(lu->LUSOL, prow-bfp_rowoffset(lp), NULL);
   if(i != LUSOL_INFORM_LUSUCCESS) {
     lu->status = BFP_STATUS_ERROR;
     lp->report(lp, NORMAL, "bfp_btran_normal: Failed at iter %.0f, pivot %d;\n%s\n",
@@ -12,6 +12,7 @@
     Release notes:
     v1.0.0  1 April   2004      First version.
     v1.1.0  20 July 2004        Reworked with flexible matrix storage model.
+    v1.2.0  19 October 2026     Added triangular crash of structural columns.
 
    ----------------------------------------------------------------------------------
 */
@@ -331,6 +332,151 @@ FinishLD:
     freeLink(&colLL);
 
   }
+
+  /* Construct a lower triangular basis of the freest structural columns */
+  else if((lp->crashmode == CRASH_TRIANGULAR) && mat_validate(mat)) {
+    /* The logic here follows Bixby */
+    int     ii, rx, cx, ix, nz, n, nbasic = 0;
+    MYBOOL  isdominant;
+    REAL    wx, tx, objmax, *rowMAX = NULL, *colKEY = NULL;
+    int     *rowNZ = NULL, *rowWT = NULL, *colWT = NULL, *colNR = NULL;
+    REAL    *value;
+    int     *rownr;
+
+    report(lp, NORMAL, "crash_basis: 'Triangular' basis crashing selected\n");
+
+    ok = allocINT(lp,  &rowNZ, lp->rows+1,     TRUE) &&
+         allocINT(lp,  &rowWT, lp->rows+1,     FALSE) &&
+         allocREAL(lp, &rowMAX, lp->rows+1,    TRUE) &&
+         allocINT(lp,  &colWT, lp->columns+1,  FALSE) &&
+         allocINT(lp,  &colNR, lp->columns+1,  FALSE) &&
+         allocREAL(lp, &colKEY, lp->columns+1, FALSE);
+    if(!ok)
+      goto FinishTR;
+
+    /* Rate the rows by how much their slacks are restricted; only rows
+       that still have their slack in the basis can be crashed */
+    for(i = 1; i <= lp->rows; i++) {
+      if(lp->var_basic[i] != i)
+        ii = 0;
+      else if(get_constr_type(lp, i)==EQ)
+        ii = 3;
+      else if(lp->orig_upbo[i] < lp->infinite)
+        ii = 2;
+      else if(fabs(lp->orig_rhs[i]) < lp->infinite)
+        ii = 1;
+      else
+        ii = 0;
+      rowWT[i] = ii;
+    }
+    rowWT[0] = 0;
+
+    /* Structural columns already in the basis cover their rows */
+    for(cx = 1; cx <= lp->columns; cx++) {
+      if(!lp->is_basic[lp->rows+cx])
+        continue;
+      ii = mat->col_end[cx-1];
+      nz = mat->col_end[cx];
+      rownr = &COL_MAT_ROWNR(ii);
+      value = &COL_MAT_VALUE(ii);
+      for(; ii < nz;
+          ii++, rownr += matRowColStep, value += matValueStep) {
+        rx = *rownr;
+        rowNZ[rx]++;
+        SETMAX(rowMAX[rx], fabs(*value));
+      }
+    }
+
+    /* Rate the columns by how free they are, and order them by that rating;
+       ties favour a low cost and then a short column */
+    objmax = 0;
+    for(cx = 1; cx <= lp->columns; cx++)
+      SETMAX(objmax, fabs(lp->orig_obj[cx]));
+    if(objmax == 0)
+      objmax = 1;
+    n = 0;
+    for(cx = 1; cx <= lp->columns; cx++) {
+      ix = lp->rows+cx;
+      if(lp->is_basic[ix] || (mat_collength(mat, cx) == 0))
+        ii = 0;
+      else if(is_unbounded(lp, cx))
+        ii = 3;
+      else if((lp->orig_upbo[ix] >= lp->infinite) || (lp->orig_lowbo[ix] <= -lp->infinite))
+        ii = 2;
+      else if(fabs(lp->orig_upbo[ix]-lp->orig_lowbo[ix]) > lp->epsmachine)
+        ii = 1;
+      else
+        ii = 0;
+      colWT[cx] = ii;
+      if(ii == 0)
+        continue;
+      n++;
+      colNR[n]  = cx;
+      colKEY[n] = CRASH_SPACER*ii - CRASH_WEIGHT*lp->orig_obj[cx]/objmax -
+                  (REAL) mat_collength(mat, cx) / (lp->rows+1);
+    }
+    if(n > 1)
+      qsortex(colKEY+1, n, 0, sizeof(*colKEY), TRUE, compareREAL, colNR+1, sizeof(*colNR));
+
+    /* Let each column in turn replace a more restricted slack; the pivot row
+       must not be touched by any earlier column, which keeps the basis lower
+       triangular and thereby nonsingular */
+    for(i = 1; (i <= n) && (nbasic < lp->rows); i++) {
+      cx = colNR[i];
+
+      /* Find the column maximum, the best uncovered pivot row and whether
+         the entries in the covered rows are small compared to their pivots */
+      rx = 0;
+      wx = 0;
+      tx = 0;
+      isdominant = TRUE;
+      ii = mat->col_end[cx-1];
+      nz = mat->col_end[cx];
+      rownr = &COL_MAT_ROWNR(ii);
+      value = &COL_MAT_VALUE(ii);
+      for(; ii < nz;
+          ii++, rownr += matRowColStep, value += matValueStep) {
+        ix = *rownr;
+        SETMAX(tx, fabs(*value));
+        if(rowNZ[ix] > 0) {
+          if(fabs(*value) > CRASH_OFFDIAGONAL*rowMAX[ix])
+            isdominant = FALSE;
+        }
+        else if(rowWT[ix] + colWT[cx] > 3) {
+          if((fabs(*value) > wx) ||
+             ((fabs(*value) == wx) && (rowWT[ix] > rowWT[rx]))) {
+            rx = ix;
+            wx = fabs(*value);
+          }
+        }
+      }
+      if((rx == 0) || ((wx < CRASH_PIVOTRATIO*tx) && !isdominant))
+        continue;
+
+      /* Set new basis variable and mark its rows as covered */
+      set_basisvar(lp, rx, lp->rows+cx);
+      nbasic++;
+      ii = mat->col_end[cx-1];
+      rownr = &COL_MAT_ROWNR(ii);
+      value = &COL_MAT_VALUE(ii);
+      for(; ii < nz;
+          ii++, rownr += matRowColStep, value += matValueStep) {
+        ix = *rownr;
+        rowNZ[ix]++;
+        SETMAX(rowMAX[ix], fabs(*value));
+      }
+    }
+    report(lp, DETAILED, "crash_basis: %d structural columns entered the basis\n", nbasic);
+
+    /* Clean up */
+FinishTR:
+    FREE(rowNZ);
+    FREE(rowWT);
+    FREE(rowMAX);
+    FREE(colWT);
+    FREE(colNR);
+    FREE(colKEY);
+  }
   return( ok );
 }
 
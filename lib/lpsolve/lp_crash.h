@@ -10,6 +10,8 @@
 #define CRASH_THRESHOLD  0.167
 #define CRASH_SPACER        10
 #define CRASH_WEIGHT     0.500
+#define CRASH_PIVOTRATIO  0.99   /* Triangular crash pivot relative to the column maximum */
+#define CRASH_OFFDIAGONAL 0.01   /* Triangular crash entries in covered rows relative to their pivots */
 
 
 
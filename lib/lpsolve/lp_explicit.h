@@ -37,6 +37,7 @@ LPSOLVEAPIDEF get_basiscrash_func           *_get_basiscrash;
 LPSOLVEAPIDEF get_bb_depthlimit_func        *_get_bb_depthlimit;
 LPSOLVEAPIDEF get_bb_floorfirst_func        *_get_bb_floorfirst;
 LPSOLVEAPIDEF get_bb_rule_func              *_get_bb_rule;
+LPSOLVEAPIDEF get_BFPmode_func              *_get_BFPmode;
 LPSOLVEAPIDEF get_bounds_tighter_func       *_get_bounds_tighter;
 LPSOLVEAPIDEF get_break_at_value_func       *_get_break_at_value;
 LPSOLVEAPIDEF get_col_name_func             *_get_col_name;
@@ -107,6 +108,7 @@ LPSOLVEAPIDEF get_solutioncount_func        *_get_solutioncount;
 LPSOLVEAPIDEF get_solutionlimit_func        *_get_solutionlimit;
 LPSOLVEAPIDEF get_status_func               *_get_status;
 LPSOLVEAPIDEF get_statustext_func           *_get_statustext;
+LPSOLVEAPIDEF get_threads_func              *_get_threads;
 LPSOLVEAPIDEF get_timeout_func              *_get_timeout;
 LPSOLVEAPIDEF get_total_iter_func           *_get_total_iter;
 LPSOLVEAPIDEF get_total_nodes_func          *_get_total_nodes;
@@ -165,6 +167,7 @@ LPSOLVEAPIDEF put_msgfunc_func              *_put_msgfunc;
 LPSOLVEAPIDEF read_LP_func                  *_read_LP;
 LPSOLVEAPIDEF read_MPS_func                 *_read_MPS;
 LPSOLVEAPIDEF read_XLI_func                 *_read_XLI;
+LPSOLVEAPIDEF read_pseudocosts_func         *_read_pseudocosts;
 LPSOLVEAPIDEF read_params_func              *_read_params;
 LPSOLVEAPIDEF read_basis_func               *_read_basis;
 LPSOLVEAPIDEF reset_basis_func              *_reset_basis;
@@ -180,6 +183,7 @@ LPSOLVEAPIDEF set_bb_depthlimit_func        *_set_bb_depthlimit;
 LPSOLVEAPIDEF set_bb_floorfirst_func        *_set_bb_floorfirst;
 LPSOLVEAPIDEF set_bb_rule_func              *_set_bb_rule;
 LPSOLVEAPIDEF set_BFP_func                  *_set_BFP;
+LPSOLVEAPIDEF set_BFPmode_func              *_set_BFPmode;
 LPSOLVEAPIDEF set_binary_func               *_set_binary;
 LPSOLVEAPIDEF set_bounds_func               *_set_bounds;
 LPSOLVEAPIDEF set_bounds_tighter_func       *_set_bounds_tighter;
@@ -235,6 +239,7 @@ LPSOLVEAPIDEF set_semicont_func             *_set_semicont;
 LPSOLVEAPIDEF set_sense_func                *_set_sense;
 LPSOLVEAPIDEF set_simplextype_func          *_set_simplextype;
 LPSOLVEAPIDEF set_solutionlimit_func        *_set_solutionlimit;
+LPSOLVEAPIDEF set_threads_func              *_set_threads;
 LPSOLVEAPIDEF set_timeout_func              *_set_timeout;
 LPSOLVEAPIDEF set_trace_func                *_set_trace;
 LPSOLVEAPIDEF set_upbo_func                 *_set_upbo;
@@ -258,6 +263,7 @@ LPSOLVEAPIDEF write_freemps_func            *_write_freemps;
 LPSOLVEAPIDEF write_freeMPS_func            *_write_freeMPS;
 LPSOLVEAPIDEF write_XLI_func                *_write_XLI;
 LPSOLVEAPIDEF write_basis_func              *_write_basis;
+LPSOLVEAPIDEF write_pseudocosts_func        *_write_pseudocosts;
 LPSOLVEAPIDEF write_params_func             *_write_params;
 
 #if defined LPSOLVEAPIFROMLPREC
@@ -284,6 +290,7 @@ static int init_lpsolve(lprec *lp)
   _get_bb_depthlimit = lp->get_bb_depthlimit;
   _get_bb_floorfirst = lp->get_bb_floorfirst;
   _get_bb_rule = lp->get_bb_rule;
+  _get_BFPmode = lp->get_BFPmode;
   _get_bounds_tighter = lp->get_bounds_tighter;
   _get_break_at_value = lp->get_break_at_value;
   _get_col_name = lp->get_col_name;
@@ -353,6 +360,7 @@ static int init_lpsolve(lprec *lp)
   _get_solutionlimit = lp->get_solutionlimit;
   _get_status = lp->get_status;
   _get_statustext = lp->get_statustext;
+  _get_threads = lp->get_threads;
   _get_timeout = lp->get_timeout;
   _get_total_iter = lp->get_total_iter;
   _get_total_nodes = lp->get_total_nodes;
@@ -410,6 +418,7 @@ static int init_lpsolve(lprec *lp)
   _read_LP = lp->read_LP;
   _read_MPS = lp->read_MPS;
   _read_XLI = lp->read_XLI;
+  _read_pseudocosts = lp->read_pseudocosts;
   _read_params = lp->read_params;
   _read_basis = lp->read_basis;
   _reset_basis = lp->reset_basis;
@@ -425,6 +434,7 @@ static int init_lpsolve(lprec *lp)
   _set_bb_floorfirst = lp->set_bb_floorfirst;
   _set_bb_rule = lp->set_bb_rule;
   _set_BFP = lp->set_BFP;
+  _set_BFPmode = lp->set_BFPmode;
   _set_binary = lp->set_binary;
   _set_bounds = lp->set_bounds;
   _set_bounds_tighter = lp->set_bounds_tighter;
@@ -480,6 +490,7 @@ static int init_lpsolve(lprec *lp)
   _set_sense = lp->set_sense;
   _set_simplextype = lp->set_simplextype;
   _set_solutionlimit = lp->set_solutionlimit;
+  _set_threads = lp->set_threads;
   _set_timeout = lp->set_timeout;
   _set_trace = lp->set_trace;
   _set_upbo = lp->set_upbo;
@@ -503,6 +514,7 @@ static int init_lpsolve(lprec *lp)
   _write_freeMPS = lp->write_freeMPS;
   _write_XLI = lp->write_XLI;
   _write_basis = lp->write_basis;
+  _write_pseudocosts = lp->write_pseudocosts;
   _write_params = lp->write_params;
 
   return(TRUE);
@@ -575,6 +587,7 @@ static int init_lpsolve(hlpsolve lpsolve)
   _get_bb_depthlimit = (get_bb_depthlimit_func *) AddressOf(lpsolve, "get_bb_depthlimit");
   _get_bb_floorfirst = (get_bb_floorfirst_func *) AddressOf(lpsolve, "get_bb_floorfirst");
   _get_bb_rule = (get_bb_rule_func *) AddressOf(lpsolve, "get_bb_rule");
+  _get_BFPmode = (get_BFPmode_func *) AddressOf(lpsolve, "get_BFPmode");
   _get_bounds_tighter = (get_bounds_tighter_func *) AddressOf(lpsolve, "get_bounds_tighter");
   _get_break_at_value = (get_break_at_value_func *) AddressOf(lpsolve, "get_break_at_value");
   _get_col_name = (get_col_name_func *) AddressOf(lpsolve, "get_col_name");
@@ -645,6 +658,7 @@ static int init_lpsolve(hlpsolve lpsolve)
   _get_solutionlimit = (get_solutionlimit_func *) AddressOf(lpsolve, "get_solutionlimit");
   _get_status = (get_status_func *) AddressOf(lpsolve, "get_status");
   _get_statustext = (get_statustext_func *) AddressOf(lpsolve, "get_statustext");
+  _get_threads = (get_threads_func *) AddressOf(lpsolve, "get_threads");
   _get_timeout = (get_timeout_func *) AddressOf(lpsolve, "get_timeout");
   _get_total_iter = (get_total_iter_func *) AddressOf(lpsolve, "get_total_iter");
   _get_total_nodes = (get_total_nodes_func *) AddressOf(lpsolve, "get_total_nodes");
@@ -703,6 +717,7 @@ static int init_lpsolve(hlpsolve lpsolve)
   _read_LP = (read_LP_func *) AddressOf(lpsolve, "read_LP");
   _read_MPS = (read_MPS_func *) AddressOf(lpsolve, "read_MPS");
   _read_XLI = (read_XLI_func *) AddressOf(lpsolve, "read_XLI");
+  _read_pseudocosts = (read_pseudocosts_func *) AddressOf(lpsolve, "read_pseudocosts");
   _read_params = (read_params_func *) AddressOf(lpsolve, "read_params");
   _read_basis = (read_basis_func *) AddressOf(lpsolve, "read_basis");
   _reset_basis = (reset_basis_func *) AddressOf(lpsolve, "reset_basis");
@@ -718,6 +733,7 @@ static int init_lpsolve(hlpsolve lpsolve)
   _set_bb_floorfirst = (set_bb_floorfirst_func *) AddressOf(lpsolve, "set_bb_floorfirst");
   _set_bb_rule = (set_bb_rule_func *) AddressOf(lpsolve, "set_bb_rule");
   _set_BFP = (set_BFP_func *) AddressOf(lpsolve, "set_BFP");
+  _set_BFPmode = (set_BFPmode_func *) AddressOf(lpsolve, "set_BFPmode");
   _set_binary = (set_binary_func *) AddressOf(lpsolve, "set_binary");
   _set_bounds = (set_bounds_func *) AddressOf(lpsolve, "set_bounds");
   _set_bounds_tighter = (set_bounds_tighter_func *) AddressOf(lpsolve, "set_bounds_tighter");
@@ -773,6 +789,7 @@ static int init_lpsolve(hlpsolve lpsolve)
   _set_sense = (set_sense_func *) AddressOf(lpsolve, "set_sense");
   _set_simplextype = (set_simplextype_func *) AddressOf(lpsolve, "set_simplextype");
   _set_solutionlimit = (set_solutionlimit_func *) AddressOf(lpsolve, "set_solutionlimit");
+  _set_threads = (set_threads_func *) AddressOf(lpsolve, "set_threads");
   _set_timeout = (set_timeout_func *) AddressOf(lpsolve, "set_timeout");
   _set_trace = (set_trace_func *) AddressOf(lpsolve, "set_trace");
   _set_upbo = (set_upbo_func *) AddressOf(lpsolve, "set_upbo");
@@ -796,6 +813,7 @@ static int init_lpsolve(hlpsolve lpsolve)
   _write_freeMPS = (write_freeMPS_func *) AddressOf(lpsolve, "write_freeMPS");
   _write_XLI = (write_XLI_func *) AddressOf(lpsolve, "write_XLI");
   _write_basis = (write_basis_func *) AddressOf(lpsolve, "write_basis");
+  _write_pseudocosts = (write_pseudocosts_func *) AddressOf(lpsolve, "write_pseudocosts");
   _write_params = (write_params_func *) AddressOf(lpsolve, "write_params");
 
   return(TRUE);
@@ -826,6 +844,7 @@ static int init_lpsolve(hlpsolve lpsolve)
 #define get_bb_depthlimit _get_bb_depthlimit
 #define get_bb_floorfirst _get_bb_floorfirst
 #define get_bb_rule _get_bb_rule
+#define get_BFPmode _get_BFPmode
 #define get_bounds_tighter _get_bounds_tighter
 #define get_break_at_value _get_break_at_value
 #define get_col_name _get_col_name
@@ -896,6 +915,7 @@ static int init_lpsolve(hlpsolve lpsolve)
 #define get_solutionlimit _get_solutionlimit
 #define get_status _get_status
 #define get_statustext _get_statustext
+#define get_threads _get_threads
 #define get_timeout _get_timeout
 #define get_total_iter _get_total_iter
 #define get_total_nodes _get_total_nodes
@@ -954,6 +974,7 @@ static int init_lpsolve(hlpsolve lpsolve)
 #define read_LP _read_LP
 #define read_MPS _read_MPS
 #define read_XLI _read_XLI
+#define read_pseudocosts _read_pseudocosts
 #define read_params _read_params
 #define read_basis _read_basis
 #define reset_basis _reset_basis
@@ -969,6 +990,7 @@ static int init_lpsolve(hlpsolve lpsolve)
 #define set_bb_floorfirst _set_bb_floorfirst
 #define set_bb_rule _set_bb_rule
 #define set_BFP _set_BFP
+#define set_BFPmode _set_BFPmode
 #define set_binary _set_binary
 #define set_bounds _set_bounds
 #define set_bounds_tighter _set_bounds_tighter
@@ -1024,6 +1046,7 @@ static int init_lpsolve(hlpsolve lpsolve)
 #define set_sense _set_sense
 #define set_simplextype _set_simplextype
 #define set_solutionlimit _set_solutionlimit
+#define set_threads _set_threads
 #define set_timeout _set_timeout
 #define set_trace _set_trace
 #define set_upbo _set_upbo
@@ -1047,4 +1070,5 @@ static int init_lpsolve(hlpsolve lpsolve)
 #define write_freeMPS _write_freeMPS
 #define write_XLI _write_XLI
 #define write_basis _write_basis
+#define write_pseudocosts _write_pseudocosts
 #define write_params _write_params
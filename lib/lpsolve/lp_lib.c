@@ -40,6 +40,7 @@
 /* ---------------------------------------------------------------------------------- */
 #include "lp_lib.h"
 #include "commonlib.h"
+#include "mythread.h"
 #include "lp_utils.h"
 #include "lp_matrix.h"
 #include "lp_SOS.h"
@@ -394,6 +395,7 @@ void __WINAPI reset_params(lprec *lp)
   lp->crashmode         = CRASH_NONE;
 
   lp->max_pivots        = 0;
+  lp->bfp_mode          = BFPMODE_BARTELSGOLUB;
   lp->simplex_strategy  = SIMPLEX_DUAL_PRIMAL;
 #define PricerDefaultOpt 1
 #if PricerDefaultOpt == 1
@@ -429,6 +431,7 @@ void __WINAPI reset_params(lprec *lp)
 
   lp->sectimeout        = 0;
   lp->solutionlimit     = 1;
+  lp->num_threads       = 1;
 
   set_outputstream(lp, NULL);          /* Set to default output stream */
   lp->verbose           = NORMAL;
@@ -510,6 +513,18 @@ long __WINAPI get_timeout(lprec *lp)
   return(lp->sectimeout);
 }
 
+void __WINAPI set_threads(lprec *lp, int threads)
+{
+  if(threads <= 0)
+    threads = thread_cpucount();
+  lp->num_threads = MIN(threads, THREAD_MAXCOUNT);
+}
+
+int __WINAPI get_threads(lprec *lp)
+{
+  return(lp->num_threads);
+}
+
 void __WINAPI set_verbose(lprec *lp, int verbose)
 {
   lp->verbose = verbose;
@@ -602,6 +617,16 @@ int __WINAPI get_maxpivot(lprec *lp)
   return( lp->bfp_pivotmax(lp) );
 }
 
+void __WINAPI set_BFPmode(lprec *lp, int bfpmode)
+{
+  lp->bfp_mode = bfpmode;
+}
+
+int __WINAPI get_BFPmode(lprec *lp)
+{
+  return( lp->bfp_mode );
+}
+
 void __WINAPI set_bb_rule(lprec *lp, int bb_rule)
 {
   lp->bb_rule = bb_rule;
@@ -1473,10 +1498,14 @@ lprec * __WINAPI make_lp(int rows, int columns)
   lp->P1extraDim        = 0;
   lp->P1extraVal        = 0.0;
   lp->bb_strongbranches = 0;
+  lp->bb_strongprobes   = NULL;
+  lp->bb_strongprobecount = 0;
   lp->current_iter      = 0;
   lp->total_iter        = 0;
   lp->current_bswap     = 0;
   lp->total_bswap       = 0;
+  lp->current_longswap  = 0;
+  lp->total_longswap    = 0;
   lp->solutioncount     = 0;
   lp->solvecount        = 0;
 
@@ -1577,6 +1606,9 @@ void __WINAPI delete_lp(lprec *lp)
 /*    report(lp, SEVERE, "delete_lp: The B&B pseudo-cost array was not cleared on delete\n"); */
     free_pseudocost(lp);
   }
+  if(lp->bb_PseudoStore != NULL)
+    while(free_pseudoclass(&(lp->bb_PseudoStore)) );
+  freeprobes_BB(lp);
   if(lp->bb_bounds != NULL) {
     report(lp, SEVERE, "delete_lp: The stack of B&B levels was not empty (failed at %.0f nodes)\n",
                        (double) lp->bb_totalnodes);
@@ -1724,7 +1756,9 @@ lprec* __WINAPI copy_lp(lprec *lp)
   set_improve(newlp, get_improve(lp));
   set_basiscrash(newlp, get_basiscrash(lp));
   set_maxpivot(newlp, get_maxpivot(lp));
+  set_BFPmode(newlp, get_BFPmode(lp));
   set_timeout(newlp, get_timeout(lp));
+  set_threads(newlp, get_threads(lp));
 
   /* Transfer MILP parameters */
   set_epsint(newlp, get_epsint(lp));
@@ -3540,10 +3574,11 @@ int __WINAPI get_simplextype(lprec *lp)
 
 void __WINAPI set_preferdual(lprec *lp, MYBOOL dodual)
 {
+  /* Keep the concurrent racing flag, it is independent of the simplex types */
   if(dodual & TRUE)
-    lp->simplex_strategy = SIMPLEX_DUAL_DUAL;
+    lp->simplex_strategy = SIMPLEX_DUAL_DUAL | (lp->simplex_strategy & SIMPLEX_CONCURRENT);
   else
-    lp->simplex_strategy = SIMPLEX_PRIMAL_PRIMAL;
+    lp->simplex_strategy = SIMPLEX_PRIMAL_PRIMAL | (lp->simplex_strategy & SIMPLEX_CONCURRENT);
 }
 
 void __WINAPI set_bounds_tighter(lprec *lp, MYBOOL tighten)
@@ -4952,6 +4987,7 @@ MYBOOL set_callbacks(lprec *lp)
   lp->get_bb_depthlimit       = get_bb_depthlimit;
   lp->get_bb_floorfirst       = get_bb_floorfirst;
   lp->get_bb_rule             = get_bb_rule;
+  lp->get_BFPmode             = get_BFPmode;
   lp->get_bounds_tighter      = get_bounds_tighter;
   lp->get_break_at_value      = get_break_at_value;
   lp->get_col_name            = get_col_name;
@@ -5021,6 +5057,7 @@ MYBOOL set_callbacks(lprec *lp)
   lp->get_solutionlimit       = get_solutionlimit;
   lp->get_status              = get_status;
   lp->get_statustext          = get_statustext;
+  lp->get_threads             = get_threads;
   lp->get_timeout             = get_timeout;
   lp->get_total_iter          = get_total_iter;
   lp->get_total_nodes         = get_total_nodes;
@@ -5080,6 +5117,7 @@ MYBOOL set_callbacks(lprec *lp)
   lp->read_XLI                = read_XLI;
   lp->read_basis              = read_basis;
   lp->reset_basis             = reset_basis;
+  lp->read_pseudocosts        = read_pseudocosts;
   lp->read_params             = read_params;
   lp->reset_params            = reset_params;
   lp->resize_lp               = resize_lp;
@@ -5093,6 +5131,7 @@ MYBOOL set_callbacks(lprec *lp)
   lp->set_bb_floorfirst       = set_bb_floorfirst;
   lp->set_bb_rule             = set_bb_rule;
   lp->set_BFP                 = set_BFP;
+  lp->set_BFPmode             = set_BFPmode;
   lp->set_binary              = set_binary;
   lp->set_bounds              = set_bounds;
   lp->set_bounds_tighter      = set_bounds_tighter;
@@ -5147,6 +5186,7 @@ MYBOOL set_callbacks(lprec *lp)
   lp->set_sense               = set_sense;
   lp->set_simplextype         = set_simplextype;
   lp->set_solutionlimit       = set_solutionlimit;
+  lp->set_threads             = set_threads;
   lp->set_timeout             = set_timeout;
   lp->set_trace               = set_trace;
   lp->set_upbo                = set_upbo;
@@ -5170,6 +5210,7 @@ MYBOOL set_callbacks(lprec *lp)
   lp->write_freeMPS           = write_freeMPS;
   lp->write_XLI               = write_XLI;
   lp->write_basis             = write_basis;
+  lp->write_pseudocosts       = write_pseudocosts;
   lp->write_params            = write_params;
 
   /* Utility functions (mainly for BFPs) */
@@ -7545,7 +7586,7 @@ STATIC int find_int_bbvar(lprec *lp, int *count, BBrec *BB, MYBOOL *isfeasible)
   REAL   hold, holdINT, bestval, OFval, randval,
          *lowbo = BB->lowbo, *upbo = BB->upbo;
   MYBOOL reversemode, greedymode, depthfirstmode, breadthfirstmode,
-         randomizemode, rcostmode,
+         randomizemode, rcostmode, reliablemode,
          pseudocostmode, pseudocostsel, pseudostrong, isINT, valINT;
 
   if((lp->int_vars == 0) || (*count > 0))
@@ -7570,8 +7611,11 @@ STATIC int find_int_bbvar(lprec *lp, int *count, BBrec *BB, MYBOOL *isfeasible)
   pseudocostsel  = is_bb_rule(lp, NODE_PSEUDOCOSTSELECT) ||
                    is_bb_rule(lp, NODE_PSEUDONONINTSELECT) ||
                    is_bb_rule(lp, NODE_PSEUDORATIOSELECT);
-  pseudostrong   = FALSE &&
-                   pseudocostsel && !rcostmode && is_bb_mode(lp, NODE_STRONGINIT);
+  reliablemode   = is_bb_mode(lp, NODE_RELIABILITY);
+  pseudostrong   = (MYBOOL) ((lp->bb_level <= 1) && is_bb_mode(lp, NODE_STRONGINIT)) || reliablemode;
+  pseudostrong   = (MYBOOL) pseudostrong && (lp->bb_PseudoCost != NULL) &&
+                   (pseudocostsel || pseudocostmode) &&
+                   (lp->sc_vars == 0) && (SOS_count(lp) == 0);
 
   /* Fill list of non-ints */
   allocINT(lp, &nonint, lp->columns + 1, FALSE);
@@ -7665,6 +7709,35 @@ STATIC int find_int_bbvar(lprec *lp, int *count, BBrec *BB, MYBOOL *isfeasible)
   hold     = 0;
   randval  = 1;
 
+  /* Do a "strong" pseudo-cost initialization of the candidates that are still
+     lacking pseudo-cost observations; all probes are evaluated in one batch.
+     In reliability mode this is done at every node for the candidates that have
+     fewer than "updatelimit" observations in either branch direction, while the
+     pseudo-costs of the other candidates are trusted as they are */
+  if(pseudostrong && !is_bb_rule(lp, NODE_FIRSTSELECT)) {
+    int     *strongvars = NULL, reliable, maxvars;
+    BBPSrec *pc = lp->bb_PseudoCost;
+
+    reliable = pc->updatelimit;
+    if(reliablemode && (reliable <= 0))
+      reliable = DEF_PSEUDOCOSTUPDATES;
+    maxvars = ((lp->bb_level <= 1) ? DEF_STRONGCANDIDATES : DEF_RELIABLECANDIDATES);
+    allocINT(lp, &strongvars, n + 1, FALSE);
+    strongvars[0] = 0;
+    for(i = 1; (i <= n) && (strongvars[0] < maxvars); i++) {
+      ii = nonint[i];
+      if(reliablemode)
+        k = MIN(pc->LOcost[ii].rownr, pc->UPcost[ii].rownr);
+      else
+        k = MAX(pc->LOcost[ii].rownr, pc->UPcost[ii].rownr);
+      if((k < reliable) &&
+         (MAX(pc->LOcost[ii].colnr, pc->UPcost[ii].colnr) < 5*reliable))
+        strongvars[++strongvars[0]] = ii;
+    }
+    strongbranch_BB(lp, BB, strongvars, BB_INT, nonint[0]);
+    FREE(strongvars);
+  }
+
   /* Sort non-ints by depth in case we have breadthfirst or depthfirst modes */
   if((lp->bb_level > 1) && (depthmax > 0) && (depthfirstmode || breadthfirstmode)) {
     int *depths = NULL;
@@ -7693,15 +7766,6 @@ STATIC int find_int_bbvar(lprec *lp, int *count, BBrec *BB, MYBOOL *isfeasible)
     if(n == 1)
       bestvar = i;
 
-    /* Should we do a "strong" pseudo-cost initialization or an incremental update? */
-    if(pseudostrong &&
-       (MAX(lp->bb_PseudoCost->LOcost[ii].rownr,
-            lp->bb_PseudoCost->UPcost[ii].rownr) < lp->bb_PseudoCost->updatelimit) &&
-       (MAX(lp->bb_PseudoCost->LOcost[ii].colnr,
-            lp->bb_PseudoCost->UPcost[ii].colnr) < 5*lp->bb_PseudoCost->updatelimit)) {
-      strongbranch_BB(lp, BB, ii, BB_INT, nonint[0]);
-    }
-
     /* Select default pricing/weighting mode */
     if(pseudocostmode)
       OFval = get_pseudonodecost(lp->bb_PseudoCost, ii, BB_INT, lp->solution[i]);
@@ -7775,9 +7839,9 @@ Done:
 
 STATIC BBPSrec *init_pseudocost(lprec *lp, int pseudotype)
 {
-  int     i;
+  int     i, j;
   REAL    PSinitUP, PSinitLO;
-  BBPSrec *newitem;
+  BBPSrec *newitem, *PSstore;
   MYBOOL  isPSCount;
 
   /* Allocate memory */
@@ -7817,10 +7881,28 @@ STATIC BBPSrec *init_pseudocost(lprec *lp, int pseudotype)
     newitem->UPcost[i].value = PSinitUP;
     newitem->LOcost[i].value = PSinitLO;
   }
+  newitem->columns         = lp->columns;
   newitem->updatelimit     = lp->bb_PseudoUpdates;
   newitem->updatesfinished = 0;
   newitem->restartlimit    = DEF_PSEUDOCOSTRESTART;
 
+  /* Start from the pseudocosts of a previous B&B run on the same model, if any */
+  PSstore = lp->bb_PseudoStore;
+  if((PSstore != NULL) && (PSstore->pseodotype == newitem->pseodotype) &&
+     (PSstore->columns == get_Norig_columns(lp))) {
+    for(i = 1; i <= lp->columns; i++) {
+      j = get_orig_index(lp, lp->rows + i);
+      if((j <= 0) || (j > PSstore->columns) ||
+         (PSstore->LOcost[j].rownr <= 0) || (PSstore->UPcost[j].rownr <= 0))
+        continue;
+      newitem->LOcost[i] = PSstore->LOcost[j];
+      newitem->UPcost[i] = PSstore->UPcost[j];
+      if((newitem->updatelimit > 0) &&
+         (MIN(newitem->LOcost[i].rownr, newitem->UPcost[i].rownr) >= newitem->updatelimit))
+        newitem->updatesfinished++;
+    }
+  }
+
   /* Let the user get an opportunity to initialize pseudocosts */
   if(userabort(lp, MSG_INITPSEUDOCOST))
     lp->spx_status = USERABORT;
@@ -7848,6 +7930,168 @@ STATIC void free_pseudocost(lprec *lp)
   }
 }
 
+STATIC void store_pseudocost(lprec *lp)
+/* Keep the pseudocosts of the finished B&B indexed by original column, so that
+   they can be used to warm-start the next solve or be written to file */
+{
+  int     i, j, n;
+  BBPSrec *pc = lp->bb_PseudoCost,
+          *PSstore = lp->bb_PseudoStore;
+
+  if(pc == NULL)
+    return;
+  n = get_Norig_columns(lp);
+  if((PSstore != NULL) && (PSstore->columns != n))
+    while(free_pseudoclass(&(lp->bb_PseudoStore)) );
+  PSstore = lp->bb_PseudoStore;
+  if(PSstore == NULL) {
+    PSstore = (BBPSrec *) calloc(1, sizeof(*PSstore));
+    if(PSstore == NULL)
+      return;
+    PSstore->lp = lp;
+    PSstore->columns = n;
+    PSstore->LOcost = (MATitem *) calloc(n+1, sizeof(*PSstore->LOcost));
+    PSstore->UPcost = (MATitem *) calloc(n+1, sizeof(*PSstore->UPcost));
+    lp->bb_PseudoStore = PSstore;
+    if((PSstore->LOcost == NULL) || (PSstore->UPcost == NULL)) {
+      while(free_pseudoclass(&(lp->bb_PseudoStore)) );
+      return;
+    }
+  }
+  PSstore->pseodotype  = pc->pseodotype;
+  PSstore->updatelimit = pc->updatelimit;
+  for(i = 1; i <= lp->columns; i++) {
+    j = get_orig_index(lp, lp->rows + i);
+    if((j <= 0) || (j > n))
+      continue;
+    PSstore->LOcost[j] = pc->LOcost[i];
+    PSstore->UPcost[j] = pc->UPcost[i];
+  }
+}
+
+#define PSEUDOCOSTFILEID  "LPSOLVE_PSEUDOCOST"
+#define PSEUDOCOSTVERSION 1
+
+/* The cost records are written and read one field at a time, so that the
+   file layout does not depend on how the compiler pads MATitem */
+STATIC MYBOOL write_pseudorecords(FILE *output, MATitem *cost, int columns)
+{
+  int i;
+
+  for(i = 1; i <= columns; i++)
+    if((fwrite(&cost[i].rownr, sizeof(cost[i].rownr), 1, output) != 1) ||
+       (fwrite(&cost[i].colnr, sizeof(cost[i].colnr), 1, output) != 1) ||
+       (fwrite(&cost[i].value, sizeof(cost[i].value), 1, output) != 1))
+      return( FALSE );
+  return( TRUE );
+}
+
+STATIC MYBOOL read_pseudorecords(FILE *input, MATitem *cost, int columns)
+{
+  int i;
+
+  for(i = 1; i <= columns; i++)
+    if((fread(&cost[i].rownr, sizeof(cost[i].rownr), 1, input) != 1) ||
+       (fread(&cost[i].colnr, sizeof(cost[i].colnr), 1, input) != 1) ||
+       (fread(&cost[i].value, sizeof(cost[i].value), 1, input) != 1) ||
+       (cost[i].rownr < 0) || (cost[i].colnr < 0) || isnan(cost[i].value))
+      return( FALSE );
+  return( TRUE );
+}
+
+
+MYBOOL __WINAPI write_pseudocosts(lprec *lp, char *filename)
+{
+  FILE    *output;
+  int     header[4];
+  MYBOOL  ok;
+  BBPSrec *PSstore = lp->bb_PseudoStore;
+
+  if(PSstore == NULL) {
+    report(lp, IMPORTANT, "write_pseudocosts: No B&B pseudocosts are available\n");
+    return( FALSE );
+  }
+  if((output = fopen(filename, "wb")) == NULL)
+    return( FALSE );
+
+  /* The file is in native binary format; a header identifies the file type
+     and the model dimension, followed by the down and up cost records */
+  header[0] = PSEUDOCOSTVERSION;
+  header[1] = PSstore->columns;
+  header[2] = PSstore->pseodotype;
+  header[3] = PSstore->updatelimit;
+  ok = (MYBOOL) ((fwrite(PSEUDOCOSTFILEID, sizeof(PSEUDOCOSTFILEID), 1, output) == 1) &&
+                 (fwrite(header, sizeof(*header), 4, output) == 4) &&
+                 write_pseudorecords(output, PSstore->LOcost, PSstore->columns) &&
+                 write_pseudorecords(output, PSstore->UPcost, PSstore->columns));
+  if(fclose(output) != 0)
+    ok = FALSE;
+
+  return( ok );
+}
+
+MYBOOL __WINAPI read_pseudocosts(lprec *lp, char *filename)
+{
+  FILE    *input;
+  char    fileid[sizeof(PSEUDOCOSTFILEID)];
+  int     header[4];
+  MYBOOL  ok;
+  BBPSrec *PSstore;
+
+  if((input = fopen(filename, "rb")) == NULL)
+    return( FALSE );
+
+  /* Verify the file header */
+  ok = (MYBOOL) ((fread(fileid, sizeof(fileid), 1, input) == 1) &&
+                 (memcmp(fileid, PSEUDOCOSTFILEID, sizeof(fileid)) == 0) &&
+                 (fread(header, sizeof(*header), 4, input) == 4) &&
+                 (header[0] == PSEUDOCOSTVERSION) &&
+                 (header[2] >= NODE_FIRSTSELECT) && (header[2] <= NODE_STRATEGYMASK) &&
+                 (header[3] >= 0));
+  if(!ok) {
+    report(lp, IMPORTANT, "read_pseudocosts: %s is not a valid pseudocost file\n", filename);
+    fclose(input);
+    return( FALSE );
+  }
+
+  /* The costs are indexed by original column, so the file must be for this model */
+  if(header[1] != get_Norig_columns(lp)) {
+    report(lp, IMPORTANT, "read_pseudocosts: The file has %d columns, the model has %d\n",
+                          header[1], get_Norig_columns(lp));
+    fclose(input);
+    return( FALSE );
+  }
+
+  /* Read the cost records into a new pseudocost store */
+  PSstore = (BBPSrec *) calloc(1, sizeof(*PSstore));
+  ok = (MYBOOL) (PSstore != NULL);
+  if(ok) {
+    PSstore->lp          = lp;
+    PSstore->columns     = header[1];
+    PSstore->pseodotype  = header[2];
+    PSstore->updatelimit = header[3];
+    PSstore->LOcost = (MATitem *) calloc(PSstore->columns+1, sizeof(*PSstore->LOcost));
+    PSstore->UPcost = (MATitem *) calloc(PSstore->columns+1, sizeof(*PSstore->UPcost));
+    ok = (MYBOOL) ((PSstore->LOcost != NULL) && (PSstore->UPcost != NULL) &&
+                   read_pseudorecords(input, PSstore->LOcost, PSstore->columns) &&
+                   read_pseudorecords(input, PSstore->UPcost, PSstore->columns));
+  }
+  fclose(input);
+  if(!ok)
+    report(lp, IMPORTANT, "read_pseudocosts: %s has invalid or missing cost records\n", filename);
+
+  /* Replace any pseudocosts kept from previous solves */
+  if(ok) {
+    if(lp->bb_PseudoStore != NULL)
+      while(free_pseudoclass(&(lp->bb_PseudoStore)) );
+    lp->bb_PseudoStore = PSstore;
+  }
+  else if(PSstore != NULL)
+    while(free_pseudoclass(&PSstore) );
+
+  return( ok );
+}
+
 MYBOOL __WINAPI set_pseudocosts(lprec *lp, REAL *clower, REAL *cupper, int *updatelimit)
 {
   int i;
@@ -7892,25 +8136,32 @@ STATIC REAL get_pseudorange(BBPSrec *pc, int mipvar, int varcode)
 
 STATIC void update_pseudocost(BBPSrec *pc, int mipvar, int varcode, MYBOOL capupper, REAL varsol)
 {
-  REAL     OFsol, uplim;
-  MATitem  *PS;
+  REAL     OFsol;
   MYBOOL   nonIntSelect = is_bb_rule(pc->lp, NODE_PSEUDONONINTSELECT);
 
-  /* Establish input values;
-     Note: The pseudocosts are normalized to the 0-1 range! */
-  uplim = get_pseudorange(pc, mipvar, varcode);
-  varsol = modf(varsol/uplim, &OFsol);
-
   /* Set reference value according to pseudocost mode */
   if(nonIntSelect)
     OFsol = pc->lp->bb_bounds->lastvarcus;    /* The count of MIP infeasibilities */
   else
     OFsol = pc->lp->solution[0];              /* The problem's objective function value */
 
-  if(isnan(varsol)) {
-    pc->lp->bb_parentOF = OFsol;
-    return;
-  }
+  if(!isnan(varsol))
+    update_pseudocostex(pc, mipvar, varcode, capupper, varsol, pc->lp->bb_parentOF-OFsol);
+  pc->lp->bb_parentOF = OFsol;
+}
+
+STATIC void update_pseudocostex(BBPSrec *pc, int mipvar, int varcode, MYBOOL capupper, REAL varsol, REAL OFchange)
+/* Add one observation of the change in the MIP measure (objective function value
+   or count of non-ints) resulting from branching on the given variable; this is
+   shared by the regular B&B update and by strong branching probes */
+{
+  REAL     OFsol, uplim;
+  MATitem  *PS;
+
+  /* Establish input values;
+     Note: The pseudocosts are normalized to the 0-1 range! */
+  uplim = get_pseudorange(pc, mipvar, varcode);
+  varsol = modf(varsol/uplim, &OFsol);
 
   /* Point to the applicable (lower or upper) bound and increment attempted update count */
   if(capupper) {
@@ -7932,7 +8183,7 @@ STATIC void update_pseudocost(BBPSrec *pc, int mipvar, int varcode, MYBOOL capup
      (fabs(varsol) > pc->lp->epspivot)) {
     /* We are interested in the change in the MIP measure (contribution to increase
        or decrease, as the case may be) and not its last value alone. */
-    PS->value = PS->value*PS->rownr + (pc->lp->bb_parentOF-OFsol) / (varsol*uplim);
+    PS->value = PS->value*PS->rownr + OFchange / (varsol*uplim);
     PS->rownr++;
     PS->value /= PS->rownr;
     /* Check if we have enough information to restart */
@@ -7949,7 +8200,6 @@ STATIC void update_pseudocost(BBPSrec *pc, int mipvar, int varcode, MYBOOL capup
       }
     }
   }
-  pc->lp->bb_parentOF = OFsol;
 }
 
 STATIC REAL get_pseudobranchcost(BBPSrec *pc, int mipvar, MYBOOL dofloor)
@@ -8138,8 +8388,7 @@ STATIC MYBOOL performiteration(lprec *lp, int rownr, int varin, LREAL theta, MYB
       mat_multadd(lp->matA, hold, boundvar, deltatheta);
       lp->is_lower[boundvar] = !lp->is_lower[boundvar];
     }
-    lp->current_bswap += boundswaps[0];
-    lp->current_iter  += boundswaps[0];
+    lp->current_longswap += boundswaps[0];
 
     /* Solve for bound flip update vector (note that this does not
        overwrite the stored update vector for the entering variable) */
@@ -8149,8 +8398,9 @@ STATIC MYBOOL performiteration(lprec *lp, int rownr, int varin, LREAL theta, MYB
 
     /* Update the RHS / basic variable values and set revised thetas */
     pivot = lp->bfp_pivotRHS(lp, 1, hold);
-    deltatheta = multi_enteringtheta(lp->longsteps);
-    theta = deltatheta;
+    theta = prow[varin];
+    compute_theta(lp, rownr, &theta, enteringFromUB, 0, primal);
+    deltatheta = theta;
 
     FREE(hold);
   }
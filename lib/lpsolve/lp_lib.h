@@ -241,6 +241,7 @@
 #define SIMPLEX_Phase2_DUAL      8
 #define SIMPLEX_DYNAMIC         16
 #define SIMPLEX_AUTODUALIZE     32
+#define SIMPLEX_CONCURRENT      64    /* Race simplex variants on clones with get_threads() threads */
 
 #define SIMPLEX_PRIMAL_PRIMAL   (SIMPLEX_Phase1_PRIMAL + SIMPLEX_Phase2_PRIMAL)
 #define SIMPLEX_DUAL_PRIMAL     (SIMPLEX_Phase1_DUAL   + SIMPLEX_Phase2_PRIMAL)
@@ -261,8 +262,8 @@
 #define PRESOLVE_ROWS            1
 #define PRESOLVE_COLS            2
 #define PRESOLVE_LINDEP          4
-#define PRESOLVE_AGGREGATE       8  /* Not implemented */
-#define PRESOLVE_SPARSER        16  /* Not implemented */
+#define PRESOLVE_AGGREGATE       8
+#define PRESOLVE_SPARSER        16
 #define PRESOLVE_SOS            32
 #define PRESOLVE_REDUCEMIP      64
 #define PRESOLVE_KNAPSACK      128  /* Implementation not tested completely */
@@ -286,6 +287,11 @@
 #define CRASH_NONBASICBOUNDS     1
 #define CRASH_MOSTFEASIBLE       2
 #define CRASH_LEASTDEGENERATE    3
+#define CRASH_TRIANGULAR         4  /* Bixby-style lower triangular crash of structural columns */
+
+/* Basis factorization update models */
+#define BFPMODE_BARTELSGOLUB     0  /* Row interchanges for stability (LUSOL default) */
+#define BFPMODE_FORRESTTOMLIN    1  /* Row-eta elimination without interchanges */
 
 /* Solution recomputation options (internal) */
 #define INITSOL_SHIFTZERO        0
@@ -463,13 +469,19 @@
 #define PRICER_RANDFACT        0.1
 #define DEVEX_RESTARTLIMIT 1.0e+09    /* Reset the norms if any value exceeds this limit */
 #define DEVEX_MINVALUE       0.000    /* Minimum weight [0..1] for entering variable, consider 0.01 */
+#define HYBRID_WINDOW           50    /* Iterations per PRICE_HYBRID measurement window */
+#define HYBRID_DEGENLIMIT     0.25    /* Degenerate iteration share favouring Steepest Edge */
+#define HYBRID_COSTLIMIT      0.40    /* Norm update time share favouring Devex */
+#define HYBRID_MINTIME        0.05    /* Minimum measured time in seconds for the cost test */
+#define HYBRID_ITERFACTOR        2    /* Devex iterations per row before trying Steepest Edge */
+#define HYBRID_MAXSWITCH         6    /* Maximum number of hybrid rule changes per simplex loop */
 
 /* Pricing strategies */
 #define PRICE_PRIMALFALLBACK     4    /* In case of Steepest Edge, fall back to DEVEX in primal */
 #define PRICE_MULTIPLE           8    /* Enable multiple pricing (primal simplex) */
 #define PRICE_PARTIAL           16    /* Enable partial pricing */
 #define PRICE_ADAPTIVE          32    /* Temporarily use alternative strategy if cycling is detected */
-#define PRICE_HYBRID            64    /* NOT IMPLEMENTED */
+#define PRICE_HYBRID            64    /* Switch between Devex and Steepest Edge based on measured cost */
 #define PRICE_RANDOMIZE        128    /* Adds a small randomization effect to the selected pricer */
 #define PRICE_AUTOPARTIAL      256    /* Detect and use data on the block structure of the model (primal) */
 #define PRICE_AUTOMULTIPLE     512    /* Automatically select multiple pricing (primal simplex) */
@@ -478,6 +490,8 @@
 #define PRICE_HARRISTWOPASS   4096    /* Use Harris' primal pivot logic rather than the default */
 #define PRICE_FORCEFULL       8192    /* Non-user option to force full pricing */
 #define PRICE_TRUENORMINIT   16384    /* Use true norms for Devex and Steepest Edge initializations */
+#define PRICE_PARALLEL       32768    /* Price segments of the entering candidates concurrently (primal) */
+#define PRICE_LONGSTEPDUAL  131072    /* Use the bound-flipping ratio test in the dual phase 2 */
 
 /*#define _PRICE_NOBOUNDFLIP*/
 #if defined _PRICE_NOBOUNDFLIP
@@ -490,7 +504,8 @@
                                   PRICE_RANDOMIZE + PRICE_AUTOPARTIAL + PRICE_AUTOMULTIPLE + \
                                   PRICE_LOOPLEFT + PRICE_LOOPALTERNATE + \
                                   PRICE_HARRISTWOPASS + \
-                                  PRICE_FORCEFULL + PRICE_TRUENORMINIT)
+                                  PRICE_FORCEFULL + PRICE_TRUENORMINIT + \
+                                  PRICE_PARALLEL + PRICE_LONGSTEPDUAL)
 
 /* B&B active variable codes (internal) */
 #define BB_REAL                  0
@@ -523,6 +538,7 @@
 #define NODE_AUTOORDER        8192
 #define NODE_RCOSTFIXING     16384
 #define NODE_STRONGINIT      32768
+#define NODE_RELIABILITY     65536    /* Strong branch until the pseudo-costs are reliable */
 
 #define BRANCH_CEILING           0
 #define BRANCH_FLOOR             1
@@ -722,6 +738,12 @@
                                        experiments indicate that costs tend to stabilize */
 #define DEF_PSEUDOCOSTRESTART 0.15  /* The fraction of price updates required for B&B restart
                                        when the mode is NODE_RESTARTMODE */
+#define DEF_STRONGITERLIMIT     50  /* Minimum simplex iteration limit for a strong branching
+                                       probe; raised to twice the iterations of the node LP */
+#define DEF_STRONGCANDIDATES   100  /* The maximum number of variables probed by strong
+                                       branching at a single B&B node */
+#define DEF_RELIABLECANDIDATES   8  /* The maximum number of unreliable variables probed below
+                                       the root node when the mode is NODE_RELIABILITY */
 #define DEF_MAXPRESOLVELOOPS     0  /* Upper limit to the number of loops during presolve,
                                        <= 0 for no limit. */
 
@@ -763,8 +785,8 @@ typedef struct _presolveundorec
   REAL      *fixed_rhs;         /* rows_alloc+1 : Storage of values of presolved fixed colums */
   REAL      *fixed_obj;         /* columns_alloc+1: Storage of values of presolved fixed rows */
   DeltaVrec *deletedA;          /* A matrix of eliminated data from matA */
-  DeltaVrec *primalundo;        /* Affine translation vectors for eliminated primal variables */
-  DeltaVrec *dualundo;          /* Affine translation vectors for eliminated dual variables */
+  UndoLogrec *primalundo;       /* Affine translation records for eliminated primal variables */
+  UndoLogrec *dualundo;         /* Affine translation records for eliminated dual variables */
   MYBOOL    OFcolsdeleted;
 } presolveundorec;
 
@@ -775,6 +797,7 @@ typedef struct _BBPSrec
   int       pseodotype;
   int       updatelimit;
   int       updatesfinished;
+  int       columns;
   REAL      restartlimit;
   MATitem   *UPcost;
   MATitem   *LOcost;
@@ -782,6 +805,7 @@ typedef struct _BBPSrec
 } BBPSrec;
 
 #include "lp_mipbb.h"
+#include "lp_propagate.h"
 
 
 /* Partial pricing block data */
@@ -835,6 +859,7 @@ typedef int (__WINAPI get_basiscrash_func)(lprec *lp);
 typedef int (__WINAPI get_bb_depthlimit_func)(lprec *lp);
 typedef int (__WINAPI get_bb_floorfirst_func)(lprec *lp);
 typedef int (__WINAPI get_bb_rule_func)(lprec *lp);
+typedef int (__WINAPI get_BFPmode_func)(lprec *lp);
 typedef MYBOOL (__WINAPI get_bounds_tighter_func)(lprec *lp);
 typedef REAL (__WINAPI get_break_at_value_func)(lprec *lp);
 typedef char * (__WINAPI get_col_name_func)(lprec *lp, int colnr);
@@ -907,6 +932,7 @@ typedef int (__WINAPI get_solutioncount_func)(lprec *lp);
 typedef int (__WINAPI get_solutionlimit_func)(lprec *lp);
 typedef int (__WINAPI get_status_func)(lprec *lp);
 typedef char * (__WINAPI get_statustext_func)(lprec *lp, int statuscode);
+typedef int (__WINAPI get_threads_func)(lprec *lp);
 typedef long (__WINAPI get_timeout_func)(lprec *lp);
 typedef COUNTER (__WINAPI get_total_iter_func)(lprec *lp);
 typedef COUNTER (__WINAPI get_total_nodes_func)(lprec *lp);
@@ -967,6 +993,7 @@ typedef lprec * (__WINAPI read_MPS_func)(char *filename, int options);
 typedef lprec * (__WINAPI read_XLI_func)(char *xliname, char *modelname, char *dataname, char *options, int verbose);
 typedef MYBOOL (__WINAPI read_basis_func)(lprec *lp, char *filename, char *info);
 typedef void (__WINAPI reset_basis_func)(lprec *lp);
+typedef MYBOOL (__WINAPI read_pseudocosts_func)(lprec *lp, char *filename);
 typedef MYBOOL (__WINAPI read_params_func)(lprec *lp, char *filename, char *options);
 typedef void (__WINAPI reset_params_func)(lprec *lp);
 typedef MYBOOL (__WINAPI resize_lp_func)(lprec *lp, int rows, int columns);
@@ -979,6 +1006,7 @@ typedef void (__WINAPI set_bb_depthlimit_func)(lprec *lp, int bb_maxlevel);
 typedef void (__WINAPI set_bb_floorfirst_func)(lprec *lp, int bb_floorfirst);
 typedef void (__WINAPI set_bb_rule_func)(lprec *lp, int bb_rule);
 typedef MYBOOL (__WINAPI set_BFP_func)(lprec *lp, char *filename);
+typedef void (__WINAPI set_BFPmode_func)(lprec *lp, int bfpmode);
 typedef MYBOOL (__WINAPI set_binary_func)(lprec *lp, int colnr, MYBOOL must_be_bin);
 typedef MYBOOL (__WINAPI set_bounds_func)(lprec *lp, int colnr, REAL lower, REAL upper);
 typedef void (__WINAPI set_bounds_tighter_func)(lprec *lp, MYBOOL tighten);
@@ -1035,6 +1063,7 @@ typedef MYBOOL (__WINAPI set_semicont_func)(lprec *lp, int colnr, MYBOOL must_be
 typedef void (__WINAPI set_sense_func)(lprec *lp, MYBOOL maximize);
 typedef void (__WINAPI set_simplextype_func)(lprec *lp, int simplextype);
 typedef void (__WINAPI set_solutionlimit_func)(lprec *lp, int limit);
+typedef void (__WINAPI set_threads_func)(lprec *lp, int threads);
 typedef void (__WINAPI set_timeout_func)(lprec *lp, long sectimeout);
 typedef void (__WINAPI set_trace_func)(lprec *lp, MYBOOL trace);
 typedef MYBOOL (__WINAPI set_upbo_func)(lprec *lp, int colnr, REAL value);
@@ -1058,6 +1087,7 @@ typedef MYBOOL (__WINAPI write_freemps_func)(lprec *lp, char *filename);
 typedef MYBOOL (__WINAPI write_freeMPS_func)(lprec *lp, FILE *output);
 typedef MYBOOL (__WINAPI write_XLI_func)(lprec *lp, char *filename, char *options, MYBOOL results);
 typedef MYBOOL (__WINAPI write_basis_func)(lprec *lp, char *filename);
+typedef MYBOOL (__WINAPI write_pseudocosts_func)(lprec *lp, char *filename);
 typedef MYBOOL (__WINAPI write_params_func)(lprec *lp, char *filename, char *options);
 
 
@@ -1134,6 +1164,7 @@ struct _lprec
   get_bb_depthlimit_func        *get_bb_depthlimit;
   get_bb_floorfirst_func        *get_bb_floorfirst;
   get_bb_rule_func              *get_bb_rule;
+  get_BFPmode_func              *get_BFPmode;
   get_bounds_tighter_func       *get_bounds_tighter;
   get_break_at_value_func       *get_break_at_value;
   get_col_name_func             *get_col_name;
@@ -1203,6 +1234,7 @@ struct _lprec
   get_solutionlimit_func        *get_solutionlimit;
   get_status_func               *get_status;
   get_statustext_func           *get_statustext;
+  get_threads_func              *get_threads;
   get_timeout_func              *get_timeout;
   get_total_iter_func           *get_total_iter;
   get_total_nodes_func          *get_total_nodes;
@@ -1261,6 +1293,7 @@ struct _lprec
   read_LP_func                  *read_LP;
   read_MPS_func                 *read_MPS;
   read_XLI_func                 *read_XLI;
+  read_pseudocosts_func         *read_pseudocosts;
   read_params_func              *read_params;
   read_basis_func               *read_basis;
   reset_basis_func              *reset_basis;
@@ -1275,6 +1308,7 @@ struct _lprec
   set_bb_floorfirst_func        *set_bb_floorfirst;
   set_bb_rule_func              *set_bb_rule;
   set_BFP_func                  *set_BFP;
+  set_BFPmode_func              *set_BFPmode;
   set_binary_func               *set_binary;
   set_bounds_func               *set_bounds;
   set_bounds_tighter_func       *set_bounds_tighter;
@@ -1331,6 +1365,7 @@ struct _lprec
   set_sense_func                *set_sense;
   set_simplextype_func          *set_simplextype;
   set_solutionlimit_func        *set_solutionlimit;
+  set_threads_func              *set_threads;
   set_timeout_func              *set_timeout;
   set_trace_func                *set_trace;
   set_upbo_func                 *set_upbo;
@@ -1355,6 +1390,7 @@ struct _lprec
   write_freeMPS_func            *write_freeMPS;
   write_XLI_func                *write_XLI;
   write_basis_func              *write_basis;
+  write_pseudocosts_func        *write_pseudocosts;
   write_params_func             *write_params;
 
   /* Spacer */
@@ -1427,8 +1463,12 @@ struct _lprec
   COUNTER   total_iter;         /* Number of iterations over all B&B steps */
   COUNTER   current_bswap;      /* Number of bound swaps in the current/last simplex */
   COUNTER   total_bswap;        /* Number of bount swaps over all B&B steps */
+  COUNTER   current_longswap;   /* Number of long-step dual bound swaps in the current/last simplex */
+  COUNTER   total_longswap;     /* Number of long-step dual bound swaps over all B&B steps */
   int       solvecount;         /* The number of solve() performed in this model */
   int       max_pivots;         /* Number of pivots between refactorizations of the basis */
+  int       bfp_mode;           /* Basis factorization update model, BFPMODE_* */
+  int       num_threads;        /* Maximum number of threads used by the parallel solver components */
 
   /* Various execution parameters */
   int       simplex_strategy;   /* Set desired combination of primal and dual simplex algorithms */
@@ -1543,9 +1583,12 @@ struct _lprec
   /* Simplex basis indicators */
   int       *rejectpivot;       /* List of unacceptable pivot choices due to division-by-zero */
   BBPSrec   *bb_PseudoCost;     /* Data structure for costing of node branchings */
+  BBPSrec   *bb_PseudoStore;    /* Pseudo-costs by original column kept from the last B&B */
   int       bb_PseudoUpdates;   /* Maximum number of updates for pseudo-costs */
   int       bb_strongbranches;  /* The number of strong B&B branches performed */
   int       is_strongbranch;    /* Are we currently in a strong branch mode? */
+  lprec     **bb_strongprobes;  /* Thread-private LP relaxations kept for strong branching during the B&B */
+  int       bb_strongprobecount; /* The number of allocated strong branching relaxations */
   int       bb_improvements;    /* The number of discrete B&B objective improvement steps */
 
   /* Solver working variables */
@@ -1594,6 +1637,7 @@ struct _lprec
   int       *bb_varactive;      /* The B&B state of the variable; 0 means inactive */
   DeltaVrec *bb_upperchange;    /* Changes to upper bounds during the B&B phase */
   DeltaVrec *bb_lowerchange;    /* Changes to lower bounds during the B&B phase */
+  propagaterec *bb_propagate;   /* Bound propagation at the B&B nodes */
 
   REAL      bb_deltaOF;         /* Minimum OF step value; computed at beginning of solve() */
 
@@ -1872,6 +1916,10 @@ MYBOOL __EXPORT_TYPE __WINAPI get_pseudocosts(lprec *lp, REAL *clower, REAL *cup
 /* Set initial values for, or get computed pseudocost vectors;
    note that setting of pseudocosts can only happen in response to a
    call-back function optionally requesting this */
+MYBOOL __EXPORT_TYPE __WINAPI write_pseudocosts(lprec *lp, char *filename);
+MYBOOL __EXPORT_TYPE __WINAPI read_pseudocosts(lprec *lp, char *filename);
+/* Save the pseudocosts of the last B&B run to a binary file, or load them
+   as the starting pseudocosts of subsequent solves of the same model */
 
 int  __EXPORT_TYPE __WINAPI add_SOS(lprec *lp, char *name, int sostype, int priority, int count, int *sosvars, REAL *weights);
 MYBOOL __EXPORT_TYPE __WINAPI is_SOS_var(lprec *lp, int colnr);
@@ -1991,6 +2039,10 @@ int __EXPORT_TYPE __WINAPI get_verbose(lprec *lp);
 void __EXPORT_TYPE __WINAPI set_timeout(lprec *lp, long sectimeout);
 long __EXPORT_TYPE __WINAPI get_timeout(lprec *lp);
 
+void __EXPORT_TYPE __WINAPI set_threads(lprec *lp, int threads);
+int __EXPORT_TYPE __WINAPI get_threads(lprec *lp);
+/* Set the number of threads for parallel solver components; <= 0 uses all processors */
+
 void __EXPORT_TYPE __WINAPI set_print_sol(lprec *lp, int print_sol);
 int __EXPORT_TYPE __WINAPI get_print_sol(lprec *lp);
 
@@ -2017,6 +2069,9 @@ int __EXPORT_TYPE __WINAPI get_lp_index(lprec *lp, int orig_index);
 void __EXPORT_TYPE __WINAPI set_maxpivot(lprec *lp, int max_num_inv);
 int __EXPORT_TYPE __WINAPI get_maxpivot(lprec *lp);
 
+void __EXPORT_TYPE __WINAPI set_BFPmode(lprec *lp, int bfpmode);
+int __EXPORT_TYPE __WINAPI get_BFPmode(lprec *lp);
+
 void __EXPORT_TYPE __WINAPI set_obj_bound(lprec *lp, REAL obj_bound);
 REAL __EXPORT_TYPE __WINAPI get_obj_bound(lprec *lp);
 
@@ -2268,9 +2323,14 @@ STATIC MYBOOL varmap_validate(lprec *lp, int varno);
 
 /* Pseudo-cost routines (internal) */
 STATIC BBPSrec *init_pseudocost(lprec *lp, int pseudotype);
+STATIC MYBOOL free_pseudoclass(BBPSrec **PseudoClass);
 STATIC void free_pseudocost(lprec *lp);
+STATIC void store_pseudocost(lprec *lp);
+STATIC MYBOOL write_pseudorecords(FILE *output, MATitem *cost, int columns);
+STATIC MYBOOL read_pseudorecords(FILE *input, MATitem *cost, int columns);
 STATIC REAL get_pseudorange(BBPSrec *pc, int mipvar, int varcode);
 STATIC void update_pseudocost(BBPSrec *pc, int mipvar, int varcode, MYBOOL capupper, REAL varsol);
+STATIC void update_pseudocostex(BBPSrec *pc, int mipvar, int varcode, MYBOOL capupper, REAL varsol, REAL OFchange);
 STATIC REAL get_pseudobranchcost(BBPSrec *pc, int mipvar, MYBOOL dofloor);
 STATIC REAL get_pseudonodecost(BBPSrec *pc, int mipvar, int vartype, REAL varsol);
 
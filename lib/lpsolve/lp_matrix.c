@@ -72,6 +72,10 @@ STATIC void mat_free(MATrec **matrix)
 
 #if MatrixRowAccess==RAM_Index
   FREE((*matrix)->row_mat);
+  FREE((*matrix)->row_copy_colnr);
+  FREE((*matrix)->row_copy_value);
+  FREE((*matrix)->row_copy_work);
+  FREE((*matrix)->row_copy_touched);
 #elif MatrixColAccess==CAM_Record
   FREE((*matrix)->row_mat);
 #else /*if MatrixRowAccess==COL_Vector*/
@@ -1945,13 +1949,67 @@ STATIC MYBOOL mat_validate(MATrec *mat)
 
     FREE(rownum);
     mat->row_end_valid = TRUE;
+    mat->row_copy_valid = FALSE;
   }
 
+#if MatrixRowAccess==RAM_Index
+  /* Refresh the full row copy, if one is kept */
+  if((mat->row_access == RAM_FullCopy) && !mat->row_copy_valid) {
+    je = mat_nonzeros(mat);
+    mat->row_copy_work = (REALXP *) realloc(mat->row_copy_work,
+                                            (mat->columns_alloc + 1) * sizeof(*(mat->row_copy_work)));
+    if((mat->row_copy_work != NULL) &&
+       allocINT(mat->lp, &(mat->row_copy_touched), mat->columns_alloc + 1, AUTOMATIC) &&
+       allocINT(mat->lp, &(mat->row_copy_colnr), je + 1, AUTOMATIC) &&
+       allocREAL(mat->lp, &(mat->row_copy_value), je + 1, AUTOMATIC)) {
+      for(i = 0; i < je; i++) {
+        mat->row_copy_colnr[i] = ROW_MAT_COLNR(i);
+        mat->row_copy_value[i] = ROW_MAT_VALUE(i);
+      }
+      mat->row_copy_touched[0] = -1;
+      mat->row_copy_valid = TRUE;
+    }
+  }
+#endif
+
   if(mat == mat->lp->matA)
     mat->lp->model_is_valid = TRUE;
   return( TRUE );
 }
 
+STATIC MYBOOL mat_setrowaccess(MATrec *mat, int row_access)
+/* Select the row storage model; RAM_FullCopy keeps a row-ordered copy of the
+   column indeces and values, which is refreshed by mat_validate, while
+   RAM_Index only maps the rows to the column storage */
+{
+#if MatrixRowAccess==RAM_Index
+  if(row_access == mat->row_access)
+    return( TRUE );
+  mat->row_access = row_access;
+  mat->row_copy_valid = FALSE;
+  if(row_access == RAM_Index) {
+    FREE(mat->row_copy_colnr);
+    FREE(mat->row_copy_value);
+    FREE(mat->row_copy_work);
+    FREE(mat->row_copy_touched);
+    return( TRUE );
+  }
+  return( mat_validate(mat) && mat->row_copy_valid );
+#else
+  return( (MYBOOL) (row_access == MatrixRowAccess) );
+#endif
+}
+
+STATIC MYBOOL mat_hasrowcopy(MATrec *mat)
+/* Check if ROW_COPY_COLNR and ROW_COPY_VALUE can be used */
+{
+#if MatrixRowAccess==RAM_Index
+  return( (MYBOOL) (mat->row_end_valid && mat->row_copy_valid) );
+#else
+  return( mat->row_end_valid );
+#endif
+}
+
 MYBOOL mat_get_data(lprec *lp, int matindex, MYBOOL isrow, int **rownr, int **colnr, REAL **value)
 {
   MATrec *mat = lp->matA;
@@ -2193,6 +2251,7 @@ STATIC MYBOOL mat_additem(MATrec *mat, int row, int column, REAL delta)
     elmnr = mat_findelm(mat, row, column);
     if(elmnr >= 0) {
       COL_MAT_VALUE(elmnr) += delta;
+      mat->row_copy_valid = FALSE;
       return( TRUE );
     }
     else {
@@ -2235,6 +2294,7 @@ STATIC void mat_multrow(MATrec *mat, int row_nr, REAL mult)
     k2 = mat->row_end[row_nr];
     for(i = k1; i < k2; i++)
       ROW_MAT_VALUE(i) *= mult;
+    mat->row_copy_valid = FALSE;
   }
 }
 
@@ -2257,6 +2317,7 @@ STATIC void mat_multcol(MATrec *mat, int col_nr, REAL mult, MYBOOL DoObj)
   ie = mat->col_end[col_nr];
   for(i = mat->col_end[col_nr - 1]; i < ie; i++)
     COL_MAT_VALUE(i) *= mult;
+  mat->row_copy_valid = FALSE;
   if(isA) {
     if(DoObj)
       mat->lp->orig_obj[col_nr] *= mult;
@@ -2345,6 +2406,7 @@ STATIC MYBOOL mat_setvalue(MATrec *mat, int Row, int Column, REAL Value, MYBOOL
           Value = scaled_mat(mat->lp, Value, RowA, ColumnA);
       }
       COL_MAT_VALUE(elmnr) = Value;
+      mat->row_copy_valid = FALSE;
     }
     else { /* setting existing non-zero entry to zero. Remove the entry */
       /* This might remove an entire column, or leave just a bound. No
@@ -2695,19 +2757,16 @@ STATIC int restoreUndoLadder(DeltaVrec *DV, REAL target[])
   if(DV->activelevel > 0) {
     MATrec *mat = DV->tracker;
     int    iB = mat->col_end[DV->activelevel-1],
-           iE = mat->col_end[DV->activelevel],
-           *matRownr = &COL_MAT_ROWNR(iB);
-    REAL   *matValue = &COL_MAT_VALUE(iB),
-           oldvalue;
+           iE = mat->col_end[DV->activelevel];
 
-    /* Restore the values */
+    /* Restore the values; go backwards, so that the oldest value of an
+       item that was changed more than once at this level wins */
     iD = iE-iB;
-    for(; iB < iE; iB++, matValue += matValueStep, matRownr += matRowColStep) {
-      oldvalue = *matValue;
+    for(iE--; iE >= iB; iE--) {
 #ifdef UseMilpSlacksRCF  /* Check if we should include ranged constraints */
-      target[(*matRownr)] = oldvalue;
+      target[COL_MAT_ROWNR(iE)] = COL_MAT_VALUE(iE);
 #else
-      target[DV->lp->rows+(*matRownr)] = oldvalue;
+      target[DV->lp->rows+COL_MAT_ROWNR(iE)] = COL_MAT_VALUE(iE);
 #endif
     }
 
@@ -2738,36 +2797,90 @@ STATIC MYBOOL freeUndoLadder(DeltaVrec **DV)
   return(TRUE);
 }
 
+/* ---------------------------------------------------------------------------------- */
+/* Compact undo log routines                                                          */
+/* ---------------------------------------------------------------------------------- */
+STATIC UndoLogrec *createUndoLog(lprec *lp, int initsize)
+{
+  UndoLogrec *hold;
+
+  hold = (UndoLogrec *) malloc(sizeof(*hold));
+  hold->lp = lp;
+  hold->records = 0;
+  hold->lastrecord = -1;
+  hold->items = 0;
+  hold->items_alloc = MAX(initsize, DELTACOLALLOC);
+  hold->epsvalue = lp->matA->epsvalue;
+  hold->item = (undoitem *) malloc(hold->items_alloc * sizeof(*(hold->item)));
+  return( hold );
+}
+STATIC int appendUndoLog(UndoLogrec *UL, int index, int link, REAL value)
+{
+  undoitem *item;
+
+  /* Grow the arena geometrically to keep appends amortized constant time */
+  if(UL->items >= UL->items_alloc) {
+    UL->items_alloc += MAX(DELTACOLALLOC, UL->items_alloc / RESIZEFACTOR);
+    UL->item = (undoitem *) realloc(UL->item, UL->items_alloc * sizeof(*(UL->item)));
+  }
+  item = UL->item + UL->items;
+  item->index = index;
+  item->link  = link;
+  item->value = value;
+  return( UL->items++ );
+}
+STATIC int countsUndoLog(UndoLogrec *UL)
+{
+  if(UL == NULL)
+    return( 0 );
+  else
+    return( UL->records );
+}
+STATIC MYBOOL memoptUndoLog(UndoLogrec *UL)
+{
+  if((UL == NULL) || (UL->items_alloc <= UL->items) || (UL->items == 0))
+    return( FALSE );
+
+  UL->items_alloc = UL->items;
+  UL->item = (undoitem *) realloc(UL->item, UL->items_alloc * sizeof(*(UL->item)));
+  return( TRUE );
+}
+STATIC MYBOOL freeUndoLog(UndoLogrec **UL)
+{
+  if((UL == NULL) || (*UL == NULL))
+    return(FALSE);
+
+  FREE((*UL)->item);
+  FREE(*UL);
+  return(TRUE);
+}
+
 STATIC MYBOOL appendUndoPresolve(lprec *lp, MYBOOL isprimal, REAL beta, int colnrDep)
 {
-  MATrec *mat;
+  UndoLogrec *UL;
 
   /* Point to correct undo structure */
   if(isprimal)
-    mat = lp->presolve_undo->primalundo->tracker;
+    UL = lp->presolve_undo->primalundo;
   else
-    mat = lp->presolve_undo->dualundo->tracker;
+    UL = lp->presolve_undo->dualundo;
 
-  /* Append the data */
+  /* Append the data; dependencies on slack variables are simply stored
+     with their index beyond the user variables */
   if((colnrDep > 0) && (beta != 0) &&
-     (mat != NULL) && (mat->col_tag[0] > 0)) {
-    int ix = mat->col_tag[0];
+     (UL != NULL) && (UL->records > 0)) {
 #if 0
     report(lp, NORMAL, "appendUndoPresolve: %s %g * x%d\n",
                        ( beta < 0 ? "-" : "+"), fabs(beta), colnrDep);
 #endif
-
-    /* Do normal user variable case */
-    if(colnrDep <= lp->columns)
-      mat_setvalue(mat, colnrDep, ix, beta, FALSE);
-
-    /* Handle case where a slack variable is referenced */
-    else {
-      int ipos, jx = mat->col_tag[ix];
-      mat_setvalue(mat, jx, ix, beta, FALSE);
-      jx = mat_findins(mat, jx, ix, &ipos, FALSE);
-      COL_MAT_ROWNR(ipos) = colnrDep;
-    }
+    /* Reject small coefficients the way the sparse matrix store did */
+    if(fabs(beta) < UL->epsvalue)
+      return( TRUE );
+#ifdef DoMatrixRounding
+    beta = roundToPrecision(beta, UL->epsvalue);
+#endif
+    if(fabs(beta) > UL->epsvalue)
+      appendUndoLog(UL, colnrDep, -1, beta);
     return( TRUE );
   }
   else
@@ -2775,49 +2888,33 @@ STATIC MYBOOL appendUndoPresolve(lprec *lp, MYBOOL isprimal, REAL beta, int coln
 }
 STATIC MYBOOL addUndoPresolve(lprec *lp, MYBOOL isprimal, int colnrElim, REAL alpha, REAL beta, int colnrDep)
 {
-  int       ix;
-  DeltaVrec **DV;
-  MATrec    *mat;
+  UndoLogrec **UL;
   presolveundorec *psdata = lp->presolve_undo;
 
   /* Point to and initialize undo structure at first call */
-  if(isprimal) {
-    DV = &(psdata->primalundo);
-    if(*DV == NULL) {
-      *DV = createUndoLadder(lp, lp->columns+1, lp->columns);
-      mat = (*DV)->tracker;
-      mat->epsvalue = lp->matA->epsvalue;
-      allocINT(lp, &(mat->col_tag), lp->columns+1, FALSE);
-      mat->col_tag[0] = 0;
-    }
-  }
-  else {
-    DV = &(psdata->dualundo);
-    if(*DV == NULL) {
-      *DV = createUndoLadder(lp, lp->rows+1, lp->rows);
-      mat = (*DV)->tracker;
-      mat->epsvalue = lp->matA->epsvalue;
-      allocINT(lp, &(mat->col_tag), lp->rows+1, FALSE);
-      mat->col_tag[0] = 0;
-    }
-  }
-  mat = (*DV)->tracker;
+  if(isprimal)
+    UL = &(psdata->primalundo);
+  else
+    UL = &(psdata->dualundo);
+  if(*UL == NULL)
+    *UL = createUndoLog(lp, (isprimal ? lp->columns : lp->rows) + 1);
 #if 0
   report(lp, NORMAL, "addUndoPresolve: x%d = %g %s %g * x%d\n",
                      colnrElim, alpha, ( beta < 0 ? "-" : "+"), fabs(beta), colnrDep);
 #endif
-  /* Add the data */
-  ix = mat->col_tag[0] = incrementUndoLadder(*DV);
-  mat->col_tag[ix] = colnrElim;
-  if(alpha != 0)
-    mat_setvalue(mat, 0, ix, alpha, FALSE);
-/*    mat_appendvalue(*mat, 0, alpha);*/
-  if((colnrDep > 0) && (beta != 0)) {
-    if(colnrDep > lp->columns)
-      return( appendUndoPresolve(lp, isprimal, beta, colnrDep) );
-    else
-      mat_setvalue(mat, colnrDep, ix, beta, FALSE);
-  }
+  /* Add the record header with the constant term */
+#ifdef DoMatrixRounding
+  if(fabs(alpha) >= (*UL)->epsvalue)
+    alpha = roundToPrecision(alpha, (*UL)->epsvalue);
+#endif
+  if(fabs(alpha) <= (*UL)->epsvalue)
+    alpha = 0;
+  (*UL)->lastrecord = appendUndoLog(*UL, colnrElim, (*UL)->lastrecord, alpha);
+  (*UL)->records++;
+
+  /* Add the first dependency, if any */
+  if((colnrDep > 0) && (beta != 0))
+    return( appendUndoPresolve(lp, isprimal, beta, colnrDep) );
 
   return( TRUE );
 }
@@ -3384,6 +3481,132 @@ STATIC int prod_Ax(lprec *lp, int *coltarget, REAL *input, int *nzinput,
   return(TRUE);
 }
 
+STATIC REALXP *prod_xArows(lprec *lp, int *coltarget, REAL *input, int *nzinput,
+                                      MYBOOL includeOF, REAL ofscalar, int *nztarget)
+/* Compute x'A by rows into a column-indexed work vector when the row copy of A
+   is kept and x is sparse enough for this to visit only a small part of A;
+   otherwise NULL is returned and the caller does the usual column scan.
+   The rows are taken from nzinput (ascending) when given, and only the columns
+   set by the previous call are cleared.  Every column receives the same terms
+   in the same (row) order as in the column scan, so the results are identical.
+   If nztarget is given, it receives the targets at which x'A can be nonzero:
+   the slack targets followed by the target columns that were set, ascending.
+   The vector belongs to the row copy and stays valid until the next call. */
+{
+  int      i, ii, ib, ie, vb, ve, varnr, colnr, n, *rowlist, *touched, nrows = lp->rows;
+  REAL     value;
+  REALXP   *work = NULL;
+  MATrec   *mat = lp->matA;
+
+#if MatrixRowAccess==RAM_Index
+  if(mat->is_roworder || !mat_hasrowcopy(mat))
+    return( work );
+
+  /* List the rows of x that are to be scattered, tallying their lengths */
+  ie = (int) (MAT_ROWWISEMAX*mat_nonzeros(mat));
+  n = 0;
+  if(nzinput == NULL) {
+    rowlist = (int *) mempool_obtainVector(lp->workarrays, nrows+1, sizeof(*rowlist));
+    ii = 0;
+    for(i = 1; (i <= nrows) && (n <= ie); i++)
+      if(input[i] != 0) {
+        rowlist[++ii] = i;
+        n += mat->row_end[i] - mat->row_end[i-1] + 1;
+      }
+    rowlist[0] = ii;
+  }
+  else {
+    rowlist = nzinput;
+    for(ii = 1; (ii <= rowlist[0]) && (n <= ie); ii++) {
+      i = rowlist[ii];
+      if(i > 0)
+        n += mat->row_end[i] - mat->row_end[i-1] + 1;
+    }
+  }
+  if(n > ie)
+    goto Done;
+
+  /* Clear what the previous call left behind */
+  work = mat->row_copy_work;
+  touched = mat->row_copy_touched;
+  if(touched[0] < 0) {
+    for(colnr = 0; colnr <= mat->columns; colnr++)
+      work[colnr] = 0;
+  }
+  else {
+    for(ii = 1; ii <= touched[0]; ii++)
+      work[touched[ii]] = 0;
+  }
+
+  /* The OF comes first, as in the column scan, and only for non-empty columns;
+     a column is recorded when it is first set (possibly twice if it cancels) */
+  n = 0;
+  if(includeOF) {
+    ve = coltarget[0];
+    for(vb = 1; vb <= ve; vb++) {
+      varnr = coltarget[vb];
+      colnr = varnr - nrows;
+      if((colnr <= 0) || (mat->col_end[colnr-1] == mat->col_end[colnr]))
+        continue;
+#ifdef DirectArrayOF
+      value = input[0] * lp->obj[colnr] * ofscalar;
+#else
+      value = input[0] * get_OF_active(lp, varnr, ofscalar);
+#endif
+      if(value == 0)
+        continue;
+      if((work[colnr] == 0) && (++n <= mat->columns))
+        touched[n] = colnr;
+      work[colnr] += value;
+    }
+  }
+
+  /* Then scatter the rows in ascending order */
+  for(ii = 1; ii <= rowlist[0]; ii++) {
+    i = rowlist[ii];
+    value = input[i];
+    if((i <= 0) || (value == 0))
+      continue;
+    ie = mat->row_end[i];
+    for(ib = mat->row_end[i-1]; ib < ie; ib++) {
+      colnr = ROW_COPY_COLNR(ib);
+      if((work[colnr] == 0) && (++n <= mat->columns))
+        touched[n] = colnr;
+      work[colnr] += value * ROW_COPY_VALUE(ib);
+    }
+  }
+  touched[0] = (n <= mat->columns ? n : -1);
+
+  /* Give the targets to visit, if the caller wants them and we know them */
+  if(nztarget != NULL) {
+    ve = coltarget[0];
+    for(vb = 1; (vb <= ve) && (coltarget[vb] <= nrows); vb++)
+      nztarget[vb] = coltarget[vb];
+    n = vb - 1;
+    if(touched[0] < 0)
+      for(; vb <= ve; vb++)
+        nztarget[++n] = coltarget[vb];
+    else if(vb <= ve) {
+      qsortex(touched+1, touched[0], 0, sizeof(*touched), FALSE, compareINT, NULL, 0);
+      for(ii = 1; ii <= touched[0]; ii++) {
+        varnr = nrows + touched[ii];
+        if(((ii == 1) || (touched[ii] != touched[ii-1])) &&
+           (searchFor(varnr, coltarget, ve-vb+1, vb, FALSE) >= 0))
+          nztarget[++n] = varnr;
+      }
+    }
+    nztarget[0] = n;
+  }
+
+Done:
+  if(nzinput == NULL)
+    mempool_releaseVector(lp->workarrays, (char *) rowlist, FALSE);
+  return( work );
+#else
+  return( work );
+#endif
+}
+
 STATIC int prod_xA(lprec *lp, int *coltarget,
                               REAL *input, int *nzinput, REAL roundzero, REAL ofscalar,
                               REAL *output, int *nzoutput, int roundmode)
@@ -3393,9 +3616,9 @@ STATIC int prod_xA(lprec *lp, int *coltarget,
 {
   int      colnr, rownr, varnr, ib, ie, vb, ve, nrows = lp->rows;
   MYBOOL   localset, localnz = FALSE, includeOF, isRC;
-  REALXP   vmax;
+  REALXP   vmax, *work;
   register REALXP v;
-  int      inz, *rowin, countNZ = 0;
+  int      inz, *rowin, *target, *nztarget, countNZ = 0;
   MATrec   *mat = lp->matA;
   register REAL     *matValue;
   register int      *matRownr;
@@ -3434,12 +3657,24 @@ STATIC int prod_xA(lprec *lp, int *coltarget,
   includeOF = (MYBOOL) (((nzinput == NULL) || (nzinput[1] == 0)) &&
                         (input[0] != 0) && lp->obj_in_basis);
 
+  /* Do the product by rows if the input is sparse enough; then only the slack
+     targets and the target columns that it set need to be visited */
+  nztarget = (int *) mempool_obtainVector(lp->workarrays, lp->sum+1, sizeof(*nztarget));
+  work = prod_xArows(lp, coltarget, input, nzinput, includeOF, ofscalar, nztarget);
+  if(work != NULL) {
+    target = nztarget;
+    if(nzoutput != NULL)
+      MEMCLEAR(output+nrows+1, lp->columns);
+  }
+  else
+    target = coltarget;
+
   /* Scan the target colums */
   vmax = 0;
-  ve = coltarget[0];
+  ve = target[0];
   for(vb = 1; vb <= ve; vb++) {
 
-    varnr = coltarget[vb];
+    varnr = target[vb];
 
     if(varnr <= nrows) {
       v = input[varnr];
@@ -3451,11 +3686,15 @@ STATIC int prod_xA(lprec *lp, int *coltarget,
       ie = mat->col_end[colnr];
       if(ib < ie) {
 
+        /* Pick up the row-wise product */
+        if(work != NULL)
+          v = work[colnr];
+
         /* Do dense input vector version */
 #ifdef UseLocalNZ
-        if(localnz || (nzinput == NULL)) {
+        else if(localnz || (nzinput == NULL)) {
 #else
-        if(nzinput == NULL) {
+        else if(nzinput == NULL) {
 #endif
           /* Do the OF */
           if(includeOF)
@@ -3588,6 +3827,7 @@ STATIC int prod_xA(lprec *lp, int *coltarget,
   }
 
   /* Clean up and return */
+  mempool_releaseVector(lp->workarrays, (char *) nztarget, FALSE);
   if(localset)
     mempool_releaseVector(lp->workarrays, (char *) coltarget, FALSE);
   if(localnz)
@@ -3605,7 +3845,7 @@ STATIC MYBOOL prod_xA2(lprec *lp, int *coltarget,
 {
   int      varnr, colnr, ib, ie, vb, ve, nrows = lp->rows;
   MYBOOL   includeOF, isRC;
-  REALXP   dmax, pmax;
+  REALXP   dmax, pmax, *pwork;
   register REALXP d, p;
   MATrec   *mat = lp->matA;
   REAL     value;
@@ -3638,6 +3878,10 @@ STATIC MYBOOL prod_xA2(lprec *lp, int *coltarget,
   includeOF = (MYBOOL) (((prow[0] != 0) || (drow[0] != 0)) &&
                         lp->obj_in_basis);
 
+  /* The pivot row is often very sparse, while the cost row is not;
+     do the former by rows if this pays, leaving only the latter to the column scan */
+  pwork = prod_xArows(lp, coltarget, prow, NULL, includeOF, ofscalar, NULL);
+
   /* Scan the target colums */
   ve = coltarget[0];
   for(vb = 1; vb <= ve; vb++) {
@@ -3673,34 +3917,44 @@ STATIC MYBOOL prod_xA2(lprec *lp, int *coltarget,
         /* Then loop over all regular rows */
         matRownr = &COL_MAT_ROWNR(ib);
         matValue = &COL_MAT_VALUE(ib);
-#ifdef NoLoopUnroll
-        for( ; ib < ie; ib++) {
-          p += prow[*matRownr] * (*matValue);
-          d += drow[*matRownr] * (*matValue);
-          matValue += matValueStep;
-          matRownr += matRowColStep;
+        if(pwork != NULL) {
+          p = pwork[colnr];
+          for( ; ib < ie; ib++) {
+            d += drow[*matRownr] * (*matValue);
+            matValue += matValueStep;
+            matRownr += matRowColStep;
+          }
         }
+        else {
+#ifdef NoLoopUnroll
+          for( ; ib < ie; ib++) {
+            p += prow[*matRownr] * (*matValue);
+            d += drow[*matRownr] * (*matValue);
+            matValue += matValueStep;
+            matRownr += matRowColStep;
+          }
 #else
-        /* Prepare for simple loop unrolling */
-        if(((ie-ib) % 2) == 1) {
-          p += prow[*matRownr] * (*matValue);
-          d += drow[*matRownr] * (*matValue);
-          ib++;
-          matValue += matValueStep;
-          matRownr += matRowColStep;
-        }
+          /* Prepare for simple loop unrolling */
+          if(((ie-ib) % 2) == 1) {
+            p += prow[*matRownr] * (*matValue);
+            d += drow[*matRownr] * (*matValue);
+            ib++;
+            matValue += matValueStep;
+            matRownr += matRowColStep;
+          }
 
-        /* Then loop over remaining pairs of regular rows */
-        while(ib < ie) {
-          p += prow[*matRownr] * (*matValue);
-          p += prow[*(matRownr+matRowColStep)] * (*(matValue+matValueStep));
-          d += drow[*matRownr] * (*matValue);
-          d += drow[*(matRownr+matRowColStep)] * (*(matValue+matValueStep));
-          ib += 2;
-          matValue += 2*matValueStep;
-          matRownr += 2*matRowColStep;
-        }
+          /* Then loop over remaining pairs of regular rows */
+          while(ib < ie) {
+            p += prow[*matRownr] * (*matValue);
+            p += prow[*(matRownr+matRowColStep)] * (*(matValue+matValueStep));
+            d += drow[*matRownr] * (*matValue);
+            d += drow[*(matRownr+matRowColStep)] * (*(matValue+matValueStep));
+            ib += 2;
+            matValue += 2*matValueStep;
+            matRownr += 2*matRowColStep;
+          }
 #endif
+        }
 
       }
       if((roundmode & MAT_ROUNDABS) != 0) {
@@ -100,6 +100,20 @@ typedef struct _MATitem
 
 #endif
 
+/* Access to the optional full row copy that is kept in the RAM_Index model when
+   row_access is RAM_FullCopy; check mat_hasrowcopy before using these */
+#define MAT_ROWCOPYMIN         20000    /* Minimum nonzero count for an automatic row copy */
+#define MAT_ROWWISEMAX          0.25    /* Maximum fraction of the nonzeros of A that a
+                                           row-wise x'A product may visit */
+
+#if MatrixRowAccess==RAM_Index
+#define ROW_COPY_COLNR(item)      (mat->row_copy_colnr[item])
+#define ROW_COPY_VALUE(item)      (mat->row_copy_value[item])
+#else
+#define ROW_COPY_COLNR(item)      ROW_MAT_COLNR(item)
+#define ROW_COPY_VALUE(item)      ROW_MAT_VALUE(item)
+#endif
+
 
 typedef struct _MATrec
 {
@@ -131,6 +145,10 @@ typedef struct _MATrec
 #if MatrixRowAccess==RAM_Index
   int       *row_mat;           /* mat_alloc : From index 0, row_mat contains the
                                    row-ordered index of the elements of col_mat */
+  int       *row_copy_colnr;    /* Row-ordered copy of the column indeces and the */
+  REAL      *row_copy_value;    /* values of col_mat, if row_access is RAM_FullCopy */
+  REALXP    *row_copy_work;     /* Column-indexed accumulator for prod_xArows */
+  int       *row_copy_touched;  /* Columns set in row_copy_work, -1 if not known */
 #elif MatrixColAccess==CAM_Record
   MATitem   *row_mat;           /* mat_alloc : From index 0, row_mat contains the
                                    row-ordered copy of the elements in col_mat */
@@ -150,6 +168,8 @@ typedef struct _MATrec
   REAL      infnorm;            /* The largest absolute value in the matrix */
   REAL      dynrange;
   MYBOOL    row_end_valid;      /* TRUE if row_end & row_mat are valid */
+  MYBOOL    row_copy_valid;     /* TRUE if the row copy matches the column storage */
+  int       row_access;         /* RAM_Index or RAM_FullCopy (maintain a row copy) */
   MYBOOL    is_roworder;        /* TRUE if the current (temporary) matrix order is row-wise */
 
 } MATrec;
@@ -161,6 +181,27 @@ typedef struct _DeltaVrec
   MATrec    *tracker;
 } DeltaVrec;
 
+/* Append-only log of presolve eliminations; a record starts with a header item
+   holding the eliminated index, the position of the previous header and the
+   constant term, and is followed by one item per dependency and coefficient */
+typedef struct _undoitem
+{
+  int       index;
+  int       link;               /* Previous header position in a header, else -1 */
+  REAL      value;
+} undoitem;
+
+typedef struct _UndoLogrec
+{
+  lprec     *lp;
+  int       records;            /* Number of records (header items) in the log */
+  int       lastrecord;         /* Position of the last header, or -1 when empty */
+  int       items;
+  int       items_alloc;
+  REAL      epsvalue;           /* Coefficient rejection threshold */
+  undoitem  *item;
+} UndoLogrec;
+
 
 #ifdef __cplusplus
 __EXTERN_C {
@@ -187,6 +228,8 @@ MYBOOL mat_get_data(lprec *lp, int matindex, MYBOOL isrow, int **rownr, int **co
 MYBOOL mat_set_rowmap(MATrec *mat, int row_mat_index, int rownr, int colnr, int col_mat_index);
 STATIC MYBOOL mat_indexrange(MATrec *mat, int index, MYBOOL isrow, int *startpos, int *endpos);
 STATIC MYBOOL mat_validate(MATrec *mat);
+STATIC MYBOOL mat_setrowaccess(MATrec *mat, int row_access);
+STATIC MYBOOL mat_hasrowcopy(MATrec *mat);
 STATIC MYBOOL mat_equalRows(MATrec *mat, int baserow, int comprow);
 STATIC int mat_findelm(MATrec *mat, int row, int column);
 STATIC int mat_findins(MATrec *mat, int row, int column, int *insertpos, MYBOOL validate);
@@ -218,6 +261,8 @@ STATIC MYBOOL vec_expand(REAL *nzvector, int *nzindex, REAL *densevector, int st
 /* Sparse matrix products */
 STATIC MYBOOL get_colIndexA(lprec *lp, int varset, int *colindex, MYBOOL append);
 STATIC int prod_Ax(lprec *lp, int *coltarget, REAL *input, int *nzinput, REAL roundzero, REAL ofscalar, REAL *output, int *nzoutput, int roundmode);
+STATIC REALXP *prod_xArows(lprec *lp, int *coltarget, REAL *input, int *nzinput,
+                                      MYBOOL includeOF, REAL ofscalar, int *nztarget);
 STATIC int prod_xA(lprec *lp, int *coltarget, REAL *input, int *nzinput, REAL roundzero, REAL ofscalar, REAL *output, int *nzoutput, int roundmode);
 STATIC MYBOOL prod_xA2(lprec *lp, int *coltarget, REAL *prow, REAL proundzero, int *pnzprow,
                                                   REAL *drow, REAL droundzero, int *dnzdrow, REAL ofscalar, int roundmode);
@@ -244,6 +289,13 @@ STATIC int restoreUndoLadder(DeltaVrec *DV, REAL target[]);
 STATIC int decrementUndoLadder(DeltaVrec *DV);
 STATIC MYBOOL freeUndoLadder(DeltaVrec **DV);
 
+/* Compact undo log routines */
+STATIC UndoLogrec *createUndoLog(lprec *lp, int initsize);
+STATIC int appendUndoLog(UndoLogrec *UL, int index, int link, REAL value);
+STATIC int countsUndoLog(UndoLogrec *UL);
+STATIC MYBOOL memoptUndoLog(UndoLogrec *UL);
+STATIC MYBOOL freeUndoLog(UndoLogrec **UL);
+
 /* Specialized presolve undo functions */
 STATIC MYBOOL appendUndoPresolve(lprec *lp, MYBOOL isprimal, REAL beta, int colnrDep);
 STATIC MYBOOL addUndoPresolve(lprec *lp, MYBOOL isprimal, int colnrElim, REAL alpha, REAL beta, int colnrDep);
@@ -33,6 +33,7 @@
 #include "lp_report.h"
 #include "lp_simplex.h"
 #include "lp_mipbb.h"
+#include "mythread.h"
 
 #ifdef FORTIFY
 # include "lp_fortify.h"
@@ -235,8 +236,10 @@ STATIC BBrec *pop_BB(BBrec *BB)
       FREE(lp->bb_varactive);
       freecuts_BB(lp);
     }
-    if(lp->int_vars+lp->sc_vars > 0)
+    if(lp->int_vars+lp->sc_vars > 0) {
+      store_pseudocost(lp);
       free_pseudocost(lp);
+    }
     pop_basis(lp, FALSE);
     lp->rootbounds = NULL;
   }
@@ -274,7 +277,7 @@ STATIC BBrec *pop_BB(BBrec *BB)
     1. A probing routine to see of the best OF can be better than incumbent
     2. A presolve routine to fix other variables and detect infeasibility
 
-   THIS IS INACTIVE CODE, PLACEHOLDERS FOR FUTURE DEVELOPMENT!!! */
+   THE PROBING ROUTINE IS INACTIVE CODE, A PLACEHOLDER FOR FUTURE DEVELOPMENT!!! */
 STATIC REAL probe_BB(BBrec *BB)
 {
   int  i, ii;
@@ -304,9 +307,29 @@ STATIC REAL probe_BB(BBrec *BB)
   return( sum );
 }
 
-STATIC REAL presolve_BB(BBrec *BB)
+STATIC int presolve_BB(BBrec *BB)
 {
-  return( 0 );
+  int   status;
+  lprec *lp = BB->lp;
+
+  if((lp->bb_propagate == NULL) ||
+     ((BB->varno == 0) && !is_presolve(lp, PRESOLVE_PROBEFIX)))
+    return( RUNNING );
+
+  /* Propagate the node bounds; the tightened bounds are recorded at the current
+     level of the undo ladders, and are restored along with the branching bound */
+  status = propagate_run(lp->bb_propagate, BB->lowbo, BB->upbo,
+                         lp->bb_lowerchange, lp->bb_upperchange);
+
+  /* Probe the binary columns at the root node; the fixings hold for the whole
+     tree, and the implications found speed up the propagation at the nodes */
+  if((BB->varno == 0) && (status == RUNNING))
+    status = propagate_probe(lp->bb_propagate, BB->lowbo, BB->upbo,
+                             lp->bb_lowerchange, lp->bb_upperchange, TRUE, PROPAGATE_PROBETIME);
+  if(lp->bb_trace && (lp->bb_propagate->tightened > 0))
+    report(lp, DETAILED, "presolve_BB: Propagation tightened %d bounds at level %d\n",
+                         lp->bb_propagate->tightened, lp->bb_level);
+  return( status );
 }
 
 /* Node and branch management routines */
@@ -764,6 +787,7 @@ STATIC int solve_LP(lprec *lp, BBrec *BB)
   int    tilted, restored, status;
   REAL   testOF, *upbo = BB->upbo, *lowbo = BB->lowbo;
   BBrec  *perturbed = NULL;
+  COUNTER iterstart = get_total_iter(lp);
 
   if(lp->bb_break)
     return(PROCBREAK);
@@ -952,6 +976,7 @@ STATIC int solve_LP(lprec *lp, BBrec *BB)
   /* status can have the following values:
      OPTIMAL, SUBOPTIMAL, TIMEOUT, USERABORT, PROCFAIL, UNBOUNDED and INFEASIBLE. */
 
+  BB->lastiter = (int) (get_total_iter(lp) - iterstart);
   return( status );
 } /* solve_LP */
 
@@ -1305,8 +1330,17 @@ STATIC int solve_BB(BBrec *BB)
 
   }
 
-  /* Solve! */
-  status = solve_LP(lp, BB);
+  /* Solve, unless bound propagation has shown that the node is infeasible;
+     the status is then recorded as solve_LP would have done */
+  if(presolve_BB(BB) == INFEASIBLE) {
+    status = INFEASIBLE;
+    lp->bb_status = status;
+    lp->spx_status = status;
+    if(BB->varno == 0)
+      report(lp, NORMAL, "The model is INFEASIBLE\n");
+  }
+  else
+    status = solve_LP(lp, BB);
 
   /* Do special feasibility assessment of high order SOS'es */
 #if 1
@@ -1317,52 +1351,226 @@ STATIC int solve_BB(BBrec *BB)
   return( status );
 }
 
-/* Routine to compute a "strong" pseudo-cost update for a node */
-STATIC MYBOOL strongbranch_BB(lprec *lp, BBrec *BB, int varno, int vartype, int varcus)
+/* Strong branching work record shared by the probing threads */
+typedef struct _strongBBrec
+{
+  lprec     *lp;
+  BBrec     *BB;
+  lprec     **probelp;     /* Thread-private LP relaxations of the B&B node */
+  int       *basis;        /* The optimal basis of the B&B node, used for warm starts */
+  int       *varlist;      /* Candidate columns, count at index 0 */
+  REAL      *OFchange;     /* 2*count: Change in the MIP measure, floor then ceiling */
+  MYBOOL    *isvalid;      /* 2*count: TRUE if the probe produced a usable measure */
+  int       iterlimit;     /* Maximum number of simplex iterations per probe */
+  REAL      cutoff;        /* Objective value beyond which a branch is fathomed */
+  MYBOOL    usecutoff;
+} strongBBrec;
+
+/* Thread-private state of a single strong branching probe */
+typedef struct _strongproberec
 {
-  MYBOOL   success = FALSE;
-  int      i;
-  BBrec    *strongBB;
+  strongBBrec *SB;
+  REAL      boundOF;       /* The last valid dual bound on the objective */
+  MYBOOL    hasbound;
+  MYBOOL    cutoff;
+} strongproberec;
+
+/* Abort callback of the probes; stops at the iteration limit or as soon as the
+   dual simplex has proven that the branch cannot improve on the incumbent */
+static int __WINAPI strongabort_BB(lprec *lp, void *userhandle)
+{
+  strongproberec *probe = (strongproberec *) userhandle;
+  strongBBrec    *SB = probe->SB;
+
+  if((lp->simplex_mode == SIMPLEX_Phase2_DUAL) && !isP1extra(lp)) {
+    probe->boundOF  = unscaled_value(lp, my_chsign(!is_maxim(lp), lp->rhs[0]), 0);
+    probe->hasbound = TRUE;
+    if(SB->usecutoff &&
+       (my_chsign(is_maxim(lp), probe->boundOF - SB->cutoff) > -lp->epsprimal)) {
+      probe->cutoff = TRUE;
+      return( TRUE );
+    }
+  }
+  return( (int) (get_total_iter(lp) >= SB->iterlimit) );
+}
 
-  /* Create new B&B level and solve each of the branches */
-  lp->is_strongbranch = TRUE;
-  push_basis(lp, lp->var_basic, lp->is_basic, lp->is_lower);
-  strongBB = push_BB(lp, BB, lp->rows+varno, vartype, varcus);
-  if(strongBB == BB)
-    return( success );
+STATIC void strongprobe_BB(void *data, int threadnr, int threadcount)
+/* Worker routine; the candidates are interleaved over the threads and every probe
+   is warm-started from the same node basis, so that the result of a probe does not
+   depend on the thread that happened to compute it */
+{
+  strongBBrec    *SB = (strongBBrec *) data;
+  lprec          *lp = SB->lp,
+                 *probelp = SB->probelp[threadnr];
+  strongproberec probe;
+  int            i, j, k, colnr, status, nonints;
+  REAL           varsol, saveLO, saveUP, OFsol;
+  MYBOOL         isfloor;
+
+  probe.SB = SB;
+  put_abortfunc(probelp, strongabort_BB, &probe);
+  for(i = threadnr + 1; i <= SB->varlist[0]; i += threadcount) {
+    colnr  = SB->varlist[i];
+    varsol = lp->solution[lp->rows + colnr];
+    saveLO = get_lowbo(probelp, colnr);
+    saveUP = get_upbo(probelp, colnr);
+    for(isfloor = TRUE, k = 2*(i-1); k < 2*i; k++, isfloor = !isfloor) {
+
+      /* Impose the branch and solve from the node basis */
+      if(isfloor)
+        set_upbo(probelp, colnr, floor(varsol));
+      else
+        set_lowbo(probelp, colnr, ceil(varsol));
+      probe.hasbound = FALSE;
+      probe.cutoff   = FALSE;
+      probelp->simplex_mode = SIMPLEX_DYNAMIC;  /* Don't let the abort callback see the last phase */
+      set_basis(probelp, SB->basis, TRUE);
+      status = solve(probelp);
+
+      /* Compute the change in the MIP measure; a probe that was stopped before
+         optimality still gives a valid measure if the dual simplex bound was known */
+      SB->isvalid[k] = TRUE;
+      OFsol = 0;
+      if(status == OPTIMAL)
+        OFsol = get_working_objective(probelp);
+      else if(((status == USERABORT) || (status == SUBOPTIMAL)) && probe.hasbound)
+        OFsol = probe.boundOF;
+      else
+        SB->isvalid[k] = FALSE;
+      if(SB->isvalid[k]) {
+        if(is_bb_rule(lp, NODE_PSEUDONONINTSELECT)) {
+          nonints = 0;
+          if(status == OPTIMAL) {
+            for(j = 1; j <= lp->columns; j++)
+              if(is_int(lp, j) && !solution_is_int(probelp, probelp->rows + j, FALSE))
+                nonints++;
+          }
+          SB->OFchange[k] = SB->BB->lastvarcus - nonints;
+        }
+        else
+          SB->OFchange[k] = lp->solution[0] - OFsol;
+      }
 
-  do {
+      /* Restore the bound */
+      if(isfloor)
+        set_upbo(probelp, colnr, saveUP);
+      else
+        set_lowbo(probelp, colnr, saveLO);
+    }
+  }
+  put_abortfunc(probelp, NULL, NULL);
+}
 
-    /* Solve incremental problem to local optimality */
-    lp->bb_strongbranches++;
-/*    set_action(&lp->spx_action, ACTION_REBASE | ACTION_RECOMPUTE); */
-    if(solve_BB(strongBB) == OPTIMAL) {
+/* Delete the strong branching relaxations at the end of the B&B */
+STATIC void freeprobes_BB(lprec *lp)
+{
+  int i;
+
+  if(lp->bb_strongprobes == NULL)
+    return;
+  for(i = 0; i < lp->bb_strongprobecount; i++)
+    if(lp->bb_strongprobes[i] != NULL)
+      delete_lp(lp->bb_strongprobes[i]);
+  FREE(lp->bb_strongprobes);
+  lp->bb_strongprobecount = 0;
+}
 
-      /* Update result indicator*/
-      success |= 1 << strongBB->isfloor;
+/* Routine to compute "strong" pseudo-cost updates for a list of candidate variables;
+   the up and down branches are solved as LP relaxations on private copies of the node
+   model, in parallel if multiple threads are enabled, and the results are then merged
+   serially (in candidate order) into the pseudo-cost tables.  The copies are made the
+   first time they are needed and kept for the rest of the B&B; every call only sets
+   the bounds of the node, and every probe starts from the basis of the node */
+STATIC int strongbranch_BB(lprec *lp, BBrec *BB, int *varlist, int vartype, int varcus)
+{
+  int         i, j, k, threads, success = 0;
+  REAL        value;
+  lprec       *probelp;
+  strongBBrec SB;
 
-      /* Compute new count of non-ints */
-      strongBB->lastvarcus = 0;
-      for(i = 1; i <= lp->columns; i++) {
-        if(is_int(lp, i) && !solution_is_int(lp, lp->rows+i, FALSE))
-          strongBB->lastvarcus++;
-      }
+  if((varlist == NULL) || (varlist[0] == 0) || (lp->bb_PseudoCost == NULL))
+    return( success );
 
-      /* Perform the pseudo-cost update */
-      update_pseudocost(lp->bb_PseudoCost, varno, strongBB->vartype, strongBB->isfloor,
-                                           lp->solution[strongBB->varno]);
+  /* Initialize the shared work record */
+  MEMCLEAR(&SB, 1);
+  SB.lp        = lp;
+  SB.BB        = BB;
+  SB.varlist   = varlist;
+  SB.iterlimit = MAX(DEF_STRONGITERLIMIT, 2*BB->lastiter);
+  SB.usecutoff = (MYBOOL) (lp->solutioncount > 0);
+  SB.cutoff    = lp->best_solution[0];
+  if(lp->bb_strongprobes == NULL) {
+    lp->bb_strongprobecount = MAX(1, lp->num_threads);
+    lp->bb_strongprobes = (lprec **) calloc(lp->bb_strongprobecount, sizeof(*lp->bb_strongprobes));
+    if(lp->bb_strongprobes == NULL) {
+      lp->bb_strongprobecount = 0;
+      return( success );
     }
   }
-  while(nextbranch_BB(strongBB));
+  threads = MIN(lp->bb_strongprobecount, varlist[0]);
+  SETMAX(threads, 1);
+  if(!allocINT(lp, &SB.basis, lp->sum + 1, FALSE) ||
+     !allocREAL(lp, &SB.OFchange, 2*varlist[0], FALSE) ||
+     !allocMYBOOL(lp, &SB.isvalid, 2*varlist[0], TRUE))
+    goto Finish;
+  SB.probelp = lp->bb_strongprobes;
+
+  /* Save the node basis (basic variables first, then the non-basic ones) */
+  for(i = 1; i <= lp->rows; i++) {
+    k = lp->var_basic[i];
+    SB.basis[i] = my_chsign(lp->is_lower[k], k);
+  }
+  for(k = 1; k <= lp->sum; k++) {
+    if(lp->is_basic[k])
+      continue;
+    SB.basis[i] = my_chsign(lp->is_lower[k], k);
+    i++;
+  }
 
-  strongBB = pop_BB(strongBB);
-  if(strongBB != BB)
-    report(lp, SEVERE, "strongbranch_BB: Invalid bound settings restored for variable %d\n",
-                       varno);
-  pop_basis(lp, TRUE);
-  set_action(&lp->spx_action, ACTION_REBASE | ACTION_REINVERT | ACTION_RECOMPUTE);
+  /* Create the private LP relaxations if needed, and give them the bounds of the current node */
+  for(i = 0; i < threads; i++) {
+    probelp = SB.probelp[i];
+    if(probelp == NULL) {
+      probelp = copy_lp(lp);
+      if(probelp == NULL)
+        goto Finish;
+      SB.probelp[i] = probelp;
+      set_verbose(probelp, NEUTRAL);
+      set_presolve(probelp, PRESOLVE_NONE, 0);
+      set_threads(probelp, 1);
+      set_timeout(probelp, 0);
+      for(j = 1; j <= lp->columns; j++)
+        if(is_int(lp, j))
+          set_int(probelp, j, FALSE);
+    }
+    for(j = 1; j <= lp->columns; j++) {
+      k = lp->rows + j;
+      value = unscaled_value(lp, BB->lowbo[k], k);
+      set_lowbo(probelp, j, value);
+      value = unscaled_value(lp, BB->upbo[k], k);
+      set_upbo(probelp, j, value);
+    }
+  }
 
+  /* Solve the branches and do the pseudo-cost updates */
+  lp->is_strongbranch = TRUE;
+  thread_run(threads, strongprobe_BB, &SB);
   lp->is_strongbranch = FALSE;
+  for(i = 1; i <= varlist[0]; i++) {
+    for(k = 2*(i-1), j = TRUE; k < 2*i; k++, j = !j) {
+      lp->bb_strongbranches++;
+      if(!SB.isvalid[k])
+        continue;
+      success++;
+      update_pseudocostex(lp->bb_PseudoCost, varlist[i], vartype, (MYBOOL) j,
+                          lp->solution[lp->rows + varlist[i]], SB.OFchange[k]);
+    }
+  }
+
+Finish:
+  FREE(SB.basis);
+  FREE(SB.OFchange);
+  FREE(SB.isvalid);
 
   return( success );
 }
@@ -1394,6 +1602,8 @@ STATIC int run_BB(lprec *lp)
 #endif
   lp->bb_upperchange = createUndoLadder(lp, varno, 2*MIP_count(lp));
   lp->bb_lowerchange = createUndoLadder(lp, varno, 2*MIP_count(lp));
+  if(lp->int_vars > 0)
+    lp->bb_propagate = create_propagate(lp, lp->orig_lowbo, lp->orig_upbo, NULL, NULL);
   lp->rootbounds = currentBB = push_BB(lp, NULL, 0, BB_REAL, 0);
 
   /* Perform the branch & bound loop */
@@ -1423,6 +1633,8 @@ STATIC int run_BB(lprec *lp)
   /* Finalize */
   freeUndoLadder(&(lp->bb_upperchange));
   freeUndoLadder(&(lp->bb_lowerchange));
+  free_propagate(&(lp->bb_propagate));
+  freeprobes_BB(lp);
 
   /* Check if we should adjust status */
   if(lp->solutioncount > prevsolutions) {
@@ -15,6 +15,7 @@ typedef struct _BBrec
   int       vartype;
   int       lastvarcus;            /* Count of non-int variables of the previous branch */
   int       lastrcf;
+  int       lastiter;              /* Simplex iterations of the last LP solved at this node */
   int       nodesleft;
   int       nodessolved;
   int       nodestatus;
@@ -42,7 +43,8 @@ STATIC BBrec *push_BB(lprec *lp, BBrec *parentBB, int varno, int vartype, int va
 STATIC MYBOOL initbranches_BB(BBrec *BB);
 STATIC MYBOOL fillbranches_BB(BBrec *BB);
 STATIC MYBOOL nextbranch_BB(BBrec *BB);
-STATIC MYBOOL strongbranch_BB(lprec *lp, BBrec *BB, int varno, int vartype, int varcus);
+STATIC int strongbranch_BB(lprec *lp, BBrec *BB, int *varlist, int vartype, int varcus);
+STATIC void freeprobes_BB(lprec *lp);
 STATIC MYBOOL initcuts_BB(lprec *lp);
 STATIC int updatecuts_BB(lprec *lp);
 STATIC MYBOOL freecuts_BB(lprec *lp);
@@ -80,6 +80,13 @@ static struct _values basiscrash[] =
   /* { setvalue(CRASH_NONBASICBOUNDS) }, */ /* not yet implemented */
   { setvalue(CRASH_MOSTFEASIBLE) },
   { setvalue(CRASH_LEASTDEGENERATE) },
+  { setvalue(CRASH_TRIANGULAR) },
+};
+
+static struct _values bfpmode[] =
+{
+  { setvalue(BFPMODE_BARTELSGOLUB) },
+  { setvalue(BFPMODE_FORRESTTOMLIN) },
 };
 
 static struct _values bb_floorfirst[] =
@@ -112,6 +119,7 @@ static struct _values bb_rule[] =
   { setvalue(NODE_AUTOORDER) },
   { setvalue(NODE_RCOSTFIXING) },
   { setvalue(NODE_STRONGINIT) },
+  { setvalue(NODE_RELIABILITY) },
 };
 
 static struct _values improve[] =
@@ -153,12 +161,15 @@ static struct _values pivoting[] =
   { setvalue(PRICE_MULTIPLE) },
   { setvalue(PRICE_PARTIAL) },
   { setvalue(PRICE_ADAPTIVE) },
+  { setvalue(PRICE_HYBRID) },
   { setvalue(PRICE_RANDOMIZE) },
   { setvalue(PRICE_AUTOPARTIAL) },
   { setvalue(PRICE_LOOPLEFT) },
   { setvalue(PRICE_LOOPALTERNATE) },
   { setvalue(PRICE_HARRISTWOPASS) },
   { setvalue(PRICE_TRUENORMINIT) },
+  { setvalue(PRICE_PARALLEL) },
+  { setvalue(PRICE_LONGSTEPDUAL) },
 };
 
 static struct _values presolving[] =
@@ -249,6 +260,7 @@ static struct _values simplextype[] =
   { setvalue(SIMPLEX_DUAL_PRIMAL) },
   { setvalue(SIMPLEX_PRIMAL_DUAL) },
   { setvalue(SIMPLEX_DUAL_DUAL) },
+  { setvalue(SIMPLEX_CONCURRENT) },
 };
 
 static struct _values verbose[] =
@@ -267,6 +279,7 @@ static struct _functions functions[] =
   /* solve options */
   { "ANTI_DEGEN", setintfunction(get_anti_degen, set_anti_degen), setvalues(anti_degen, ~0), WRITE_ACTIVE },
   { "BASISCRASH", setintfunction(get_basiscrash, set_basiscrash), setvalues(basiscrash, ~0), WRITE_ACTIVE },
+  { "BFPMODE", setintfunction(get_BFPmode, set_BFPmode), setvalues(bfpmode, ~0), WRITE_ACTIVE },
   { "IMPROVE", setintfunction(get_improve, set_improve), setvalues(improve, ~0), WRITE_ACTIVE },
   { "MAXPIVOT", setintfunction(get_maxpivot, set_maxpivot), setNULLvalues, WRITE_ACTIVE },
   { "NEGRANGE", setREALfunction(get_negrange, set_negrange), setNULLvalues, WRITE_ACTIVE },
@@ -277,6 +290,7 @@ static struct _functions functions[] =
   { "SCALING", setintfunction(get_scaling, set_scaling), setvalues(scaling, SCALE_CURTISREID), WRITE_ACTIVE },
   { "SIMPLEXTYPE", setintfunction(get_simplextype, set_simplextype), setvalues(simplextype, ~0), WRITE_ACTIVE },
   { "OBJ_IN_BASIS", setMYBOOLfunction(is_obj_in_basis, set_obj_in_basis), setNULLvalues, WRITE_COMMENTED },
+  { "THREADS", setintfunction(get_threads, set_threads), setNULLvalues, WRITE_ACTIVE },
 
   /* B&B options */
   { "BB_DEPTHLIMIT", setintfunction(get_bb_depthlimit, set_bb_depthlimit), setNULLvalues, WRITE_ACTIVE },
@@ -39,6 +39,7 @@
 #include "lp_crash.h"
 #include "lp_scale.h"
 #include "lp_report.h"
+#include "mythread.h"
 
 #ifdef FORTIFY
 # include "lp_fortify.h"
@@ -159,64 +160,58 @@ STATIC MYBOOL presolve_fillUndo(lprec *lp, int orig_rows, int orig_cols, MYBOOL
 }
 STATIC MYBOOL presolve_rebuildUndo(lprec *lp, MYBOOL isprimal)
 {
-  int             ik, ie, ix, j, k, *colnrDep;
-  REAL             hold, *value, *solution, *slacks;
+  int             ik, ie, ix, k, colnrDep, offset;
+  REAL            hold, *solution, *slacks;
   presolveundorec *psdata = lp->presolve_undo;
-  MATrec          *mat = NULL;
+  UndoLogrec      *UL;
+  undoitem        *item;
 
-  /* Point to and initialize undo structure at first call */
+  /* Point to the undo log and the target vectors */
   if(isprimal) {
-    if(psdata->primalundo != NULL)
-      mat = psdata->primalundo->tracker;
-    solution = lp->full_solution + lp->presolve_undo->orig_rows;
+    UL = psdata->primalundo;
+    solution = lp->full_solution + psdata->orig_rows;
     slacks   = lp->full_solution;
+    offset   = psdata->orig_columns;
   }
   else {
-    if(psdata->dualundo != NULL)
-      mat = psdata->dualundo->tracker;
+    UL = psdata->dualundo;
     solution = lp->full_duals;
-    slacks   = lp->full_duals + lp->presolve_undo->orig_rows;
+    slacks   = lp->full_duals + psdata->orig_rows;
+    offset   = psdata->orig_rows;
   }
-  if(mat == NULL)
+  if(UL == NULL)
     return( FALSE );
 
-  /* Loop backward over the undo chain */
-  for(j = mat->col_tag[0]; j > 0; j--) {
-    ix = mat->col_tag[j];
-    ik = mat->col_end[j-1];
-    ie = mat->col_end[j];
-    colnrDep = &COL_MAT_ROWNR(ik);
-    value    = &COL_MAT_VALUE(ik);
-    hold = 0;
-    k = 0;
-    for(; ik < ie; ik++, colnrDep += matRowColStep, value += matValueStep) {
-
-      /* Constant term */
-      if(*colnrDep == 0)
-        hold += *value;
+  /* Stream backward over the record headers; the items of a record
+     extend up to the header of the record that follows it */
+  ie = UL->items;
+  for(ik = UL->lastrecord; ik >= 0; ie = ik, ik = UL->item[ik].link) {
+    item = UL->item + ik;
+    ix   = item->index;
+    hold = item->value;
+    for(k = ik+1, item++; k < ie; k++, item++) {
+      colnrDep = item->index;
 
       /* Special case with dependence on a slack variable */
-      else if(isprimal && (*colnrDep > lp->presolve_undo->orig_columns)) {
-        k = (*colnrDep) - lp->presolve_undo->orig_columns;
-        hold -= (*value) * slacks[k];
-        slacks[k] = 0;
-      }
-      else if(!isprimal && (*colnrDep > lp->presolve_undo->orig_rows)) {
-        k = (*colnrDep) - lp->presolve_undo->orig_rows;
-        hold -= (*value) * slacks[k];
-        slacks[k] = 0;
+      if(colnrDep > offset) {
+        colnrDep -= offset;
+        hold -= item->value * slacks[colnrDep];
+        slacks[colnrDep] = 0;
       }
 
       /* Dependence on other user variable */
       else
-        hold -= (*value) * solution[*colnrDep];
-
-      *value = 0;
+        hold -= item->value * solution[colnrDep];
     }
     if(fabs(hold) > lp->epsvalue)
       solution[ix] = hold;
   }
 
+  /* The records are consumed by the replay */
+  UL->records = 0;
+  UL->lastrecord = -1;
+  UL->items = 0;
+
   return( TRUE );
 }
 STATIC MYBOOL presolve_freeUndo(lprec *lp)
@@ -232,9 +227,9 @@ STATIC MYBOOL presolve_freeUndo(lprec *lp)
   if(psundo->deletedA != NULL)
     freeUndoLadder(&(psundo->deletedA));
   if(psundo->primalundo != NULL)
-    freeUndoLadder(&(psundo->primalundo));
+    freeUndoLog(&(psundo->primalundo));
   if(psundo->dualundo != NULL)
-    freeUndoLadder(&(psundo->dualundo));
+    freeUndoLog(&(psundo->dualundo));
   FREE(lp->presolve_undo);
   return( TRUE );
 }
@@ -751,10 +746,6 @@ INLINE int presolve_nextcol(presolverec *psdata, int rownr, int *previtem)
 {
   return( presolve_nextrecord(psdata->rows, rownr, previtem) );
 }
-INLINE int presolve_lastcol(presolverec *psdata, int rownr)
-{
-  return( presolve_nextrecord(psdata->rows, rownr, NULL) );
-}
 INLINE int presolve_nextrow(presolverec *psdata, int colnr, int *previtem)
 /* Find the first active (non-eliminated) nonzero row in colnr after prevrow */
 {
@@ -765,10 +756,76 @@ INLINE int presolve_lastrow(presolverec *psdata, int colnr)
   return( presolve_nextrecord(psdata->cols, colnr, NULL) );
 }
 
+/* Work list of the rows and columns that must be revisited by the inner
+   presolve loop; an item is queued when its length, bounds or activity
+   range changes */
+INLINE void presolve_markdirty(psrec *ps, int item)
+{
+  /* Helper columns added by presolve_knapsack are not tracked */
+  if((item < ps->allocsize) && !ps->isdirty[item]) {
+    ps->isdirty[item] = TRUE;
+    ps->dirty[++ps->dirty[0]] = item;
+  }
+}
+STATIC void presolve_markall(psrec *ps)
+{
+  int i;
+
+  for(i = 1; i <= ps->dirty[0]; i++)
+    ps->isdirty[ps->dirty[i]] = FALSE;
+  ps->dirty[0] = 0;
+  for(i = firstActiveLink(ps->varmap); i != 0; i = nextActiveLink(ps->varmap, i))
+    presolve_markdirty(ps, i);
+}
+STATIC int presolve_takedirty(psrec *ps, int *list, MYBOOL descending)
+{
+  int i, item, n = 0;
+
+  for(i = 1; i <= ps->dirty[0]; i++) {
+    item = ps->dirty[i];
+    ps->isdirty[item] = FALSE;
+    if(isActiveLink(ps->varmap, item))
+      list[++n] = item;
+  }
+  ps->dirty[0] = 0;
+  list[0] = n;
+  if(n > 1)
+    qsortex(list+1, n, 0, sizeof(*list), descending, compareINT, NULL, 0);
+  return( n );
+}
+STATIC void presolve_touchrow(presolverec *psdata, int rownr)
+{
+  MATrec *mat = psdata->lp->matA;
+  int    *items, ix, ie;
+
+  if((rownr == 0) || ((items = psdata->rows->next[rownr]) == NULL))
+    return;
+  presolve_markdirty(psdata->rows, rownr);
+
+  /* The dual fixing tests of the columns depend on the row as well */
+  ie = items[0];
+  for(ix = 1; ix <= ie; ix++)
+    presolve_markdirty(psdata->cols, ROW_MAT_COLNR(items[ix]));
+}
+STATIC void presolve_touchcol(presolverec *psdata, int colnr)
+{
+  MATrec *mat = psdata->lp->matA;
+  int    *items, ix, ie;
+
+  if((items = psdata->cols->next[colnr]) == NULL)
+    return;
+  presolve_markdirty(psdata->cols, colnr);
+  ie = items[0];
+  for(ix = 1; ix <= ie; ix++)
+    presolve_touchrow(psdata, COL_MAT_ROWNR(items[ix]));
+}
+
 INLINE void presolve_adjustrhs(presolverec *psdata, int rownr, REAL fixdelta, REAL epsvalue)
 {
   lprec *lp = psdata->lp;
 
+  presolve_touchrow(psdata, rownr);
+
   lp->orig_rhs[rownr] -= fixdelta;
   if(epsvalue > 0)
 #if 1
@@ -860,6 +917,7 @@ STATIC void presolve_rowremove(presolverec *psdata, int rownr, MYBOOL allowcolde
       }
     }
     rows[0] = n;
+    presolve_markdirty(psdata->cols, colnr);
 
     /* Make sure we delete columns that have become empty */
 #if 1
@@ -923,6 +981,7 @@ STATIC int presolve_colremove(presolverec *psdata, int colnr, MYBOOL allowrowdel
         }
       }
       cols[0] = n;
+      presolve_touchrow(psdata, rownr);
 
       /* Make sure we delete rows that become empty */
 #if 1
@@ -1494,6 +1553,7 @@ STATIC MYBOOL presolve_coltighten(presolverec *psdata, int colnr, REAL LOnew, RE
       report(lp, NORMAL, "presolve_coltighten: Replaced bounds on column %s to [%g ... %g]\n",
                          get_col_name(lp, colnr), LOnew, UPnew);
     set_bounds(lp, colnr, LOnew, UPnew);
+    presolve_touchcol(psdata, colnr);
   }
   if(count != NULL)
     *count = newcount;
@@ -1784,6 +1844,7 @@ STATIC MYBOOL presolve_colfix(presolverec *psdata, int colnr, REAL newvalue, MYB
   int      *rownr;
 
   /* Set "fixed" value in case we are deleting a variable */
+  presolve_touchcol(psdata, colnr);
   upbound = get_upbo(lp, colnr);
   lobound = get_lowbo(lp, colnr);
   if(remove) {
@@ -1799,6 +1860,9 @@ STATIC MYBOOL presolve_colfix(presolverec *psdata, int colnr, REAL newvalue, MYB
       else
         fixvalue = newvalue;
     }
+    /* An integer column can only be fixed at an integer value */
+    if(is_int(lp, colnr) && (fabs(fixvalue-floor(fixvalue+0.5)) > lp->epsint))
+      return( FALSE );
 #if 1 /* Fast normal version */
     set_bounds(lp, colnr, fixvalue, fixvalue);
 #else /* Slower version that can be used for debugging/control purposes */
@@ -2225,6 +2289,7 @@ STATIC int presolve_probetighten01(presolverec *psdata, int colnr)
       lp->orig_rhs[i] = upLim;
       upLim = value - my_chsign(value < 0, delta);
       COL_MAT_VALUE(ix) = upLim;
+      mat->row_copy_valid = FALSE;
       if(my_sign(value) != my_sign(upLim)) {
         if(chsign) {
           psdata->rows->negcount[i]--;
@@ -2241,153 +2306,189 @@ STATIC int presolve_probetighten01(presolverec *psdata, int colnr)
   return( n );
 }
 
+int CMP_CALLMODEL compSparsity(const UNIONTYPE QSORTrec *current, const UNIONTYPE QSORTrec *candidate);
+
+STATIC int presolve_fingerprint(presolverec *psdata, int index, MYBOOL isrow)
+/* Compute a hash value of the active entries of a row or a column from their
+   positions and their ratios to the first entry, so that parallel rows or
+   columns get identical values; the ratios are rounded to single precision */
+{
+  lprec    *lp = psdata->lp;
+  MATrec   *mat = lp->matA;
+  int      ix, item = 0, pos;
+  unsigned int hash = 0, bits;
+  REAL     value, first = 0;
+  float    ratio;
+
+  for(ix = (isrow ? presolve_nextcol(psdata, index, &item) : presolve_nextrow(psdata, index, &item));
+      ix >= 0;
+      ix = (isrow ? presolve_nextcol(psdata, index, &item) : presolve_nextrow(psdata, index, &item))) {
+    if(isrow) {
+      pos   = ROW_MAT_COLNR(ix);
+      value = ROW_MAT_VALUE(ix);
+    }
+    else {
+      pos   = COL_MAT_ROWNR(ix);
+      value = COL_MAT_VALUE(ix);
+    }
+    if(first == 0)
+      first = value;
+    ratio = (float) (value / first);
+    MEMCOPY(&bits, &ratio, 1);
+    hash = 31*(31*hash + (unsigned int) pos) + bits;
+  }
+  return( (int) (hash & 0x7FFFFFFF) );
+}
+
 STATIC int presolve_mergerows(presolverec *psdata, int *nRows, int *nSum)
 {
   lprec *lp = psdata->lp;
   MYBOOL candelete;
   int    status = RUNNING, item1, item2,
-         firstix, RT1, RT2, i, ix, iix, j, jjx, n = 0;
+         ib, ie, k, RT1, RT2, i, ix, iix, j, jjx, n = 0;
   REAL   Value1, Value2, bound;
   MATrec *mat = lp->matA;
+  UNIONTYPE QSORTrec *QS = (UNIONTYPE QSORTrec *) calloc(lp->rows+1, sizeof(*QS));
 
-  for(i = lastActiveLink(psdata->rows->varmap); (i > 0) && (status == RUNNING); ) {
-
-    /* First scan for rows with identical row lengths */
-    ix = prevActiveLink(psdata->rows->varmap, i);
-    if(ix == 0)
-      break;
+  if(QS == NULL)
+    return( status );
 
-    /* Don't bother about empty rows or row singletons, since they are
-       handled by PRESOLVE_ROWS */
-    j = presolve_rowlength(psdata, i);
-    if(j <= 1) {
-      i = ix;
+  /* Fingerprint the rows and sort them so that the candidate parallel rows
+     become neighbours; don't bother about empty rows or row singletons,
+     since they are handled by PRESOLVE_ROWS */
+  j = 0;
+  for(i = firstActiveLink(psdata->rows->varmap); i != 0; i = nextActiveLink(psdata->rows->varmap, i)) {
+    ix = presolve_rowlength(psdata, i);
+    if(ix <= 1)
       continue;
-    }
-
-#if 0
-    /* Enable this to scan all rows back */
-    RT2 = lp->rows;
-
-    /* Check abort since this section can be pretty "expensive" */
-    if(!presolve_statuscheck(psdata, &status))
-      return( status );
-#else
-    RT2 = 2+1;
-#endif
-    firstix = ix;
-    for(RT1 = 0; (ix > 0) && (RT1 < RT2) && (status == RUNNING);
-        ix = prevActiveLink(psdata->rows->varmap, ix), RT1++)  {
-      candelete = FALSE;
-      if(presolve_rowlength(psdata, ix) != j)
-        continue;
-
-      /* Check if the beginning columns are identical; if not, continue */
-      item1 = 0;
-      iix = presolve_nextcol(psdata, ix, &item1);
-      item2 = 0;
-      jjx = presolve_nextcol(psdata, i,  &item2);
-
-      if(ROW_MAT_COLNR(iix) != ROW_MAT_COLNR(jjx))
-        continue;
-
-      /* We have a candidate row; check if the entries have a fixed non-zero ratio */
-      Value1 = get_mat_byindex(lp, iix, TRUE, FALSE);
-      Value2 = get_mat_byindex(lp, jjx, TRUE, FALSE);
-      bound = Value1 / Value2;
-      Value1 = bound;
+    QS[j].int4.intval  = i;
+    QS[j].int4.intpar1 = presolve_fingerprint(psdata, i, TRUE);
+    QS[j].int4.intpar2 = ix;
+    j++;
+  }
+  QS_execute(QS, j, (findCompare_func *) compSparsity, NULL);
+  RT2 = j;
+
+  /* Compare every row with the preceding rows with the same fingerprint */
+  for(ib = 0; (ib < RT2) && (status == RUNNING); ib = ie) {
+    for(ie = ib+1; (ie < RT2) && (QS[ie].int4.intpar1 == QS[ib].int4.intpar1) &&
+                                 (QS[ie].int4.intpar2 == QS[ib].int4.intpar2); ie++);
+    for(RT1 = ib+1; (RT1 < ie) && (status == RUNNING); RT1++) {
+      i = QS[RT1].int4.intval;
+      for(k = ib; (k < RT1) && (status == RUNNING); k++) {
+        ix = QS[k].int4.intval;
+        candelete = FALSE;
+        if(ix < 0)
+          continue;
 
-      /* Loop over remaining entries */
-      jjx = presolve_nextcol(psdata, i, &item2);
-      for(; (jjx >= 0) && (Value1 == bound);
-          jjx = presolve_nextcol(psdata, i, &item2)) {
+        /* Check if the beginning columns are identical; if not, continue */
+        item1 = 0;
         iix = presolve_nextcol(psdata, ix, &item1);
+        item2 = 0;
+        jjx = presolve_nextcol(psdata, i,  &item2);
+
         if(ROW_MAT_COLNR(iix) != ROW_MAT_COLNR(jjx))
-          break;
+          continue;
+
+        /* We have a candidate row; check if the entries have a fixed non-zero ratio */
         Value1 = get_mat_byindex(lp, iix, TRUE, FALSE);
         Value2 = get_mat_byindex(lp, jjx, TRUE, FALSE);
+        bound = Value1 / Value2;
+        Value1 = bound;
+
+        /* Loop over remaining entries */
+        jjx = presolve_nextcol(psdata, i, &item2);
+        for(; (jjx >= 0) && (Value1 == bound);
+            jjx = presolve_nextcol(psdata, i, &item2)) {
+          iix = presolve_nextcol(psdata, ix, &item1);
+          if(ROW_MAT_COLNR(iix) != ROW_MAT_COLNR(jjx))
+            break;
+          Value1 = get_mat_byindex(lp, iix, TRUE, FALSE);
+          Value2 = get_mat_byindex(lp, jjx, TRUE, FALSE);
+
+          /* If the ratio is different from the reference value we have a mismatch */
+          Value1 = Value1 / Value2;
+          if(bound == lp->infinite)
+            bound = Value1;
+          else if(fabs(Value1 - bound) > psdata->epsvalue)
+            break;
+        }
 
-        /* If the ratio is different from the reference value we have a mismatch */
-        Value1 = Value1 / Value2;
-        if(bound == lp->infinite)
-          bound = Value1;
-        else if(fabs(Value1 - bound) > psdata->epsvalue)
-          break;
-      }
-
-      /* Check if we found a match (we traversed all active columns without a break) */
-      if(jjx < 0) {
+        /* Check if we found a match (we traversed all active columns without a break) */
+        if(jjx < 0) {
 
-        /* Get main reference values */
-        Value1 = lp->orig_rhs[ix];
-        Value2 = lp->orig_rhs[i] * bound;
+          /* Get main reference values */
+          Value1 = lp->orig_rhs[ix];
+          Value2 = lp->orig_rhs[i] * bound;
 
-        /* First check for inconsistent equalities */
-        if((fabs(Value1 - Value2) > psdata->epsvalue) &&
-           ((get_constr_type(lp, ix) == EQ) && (get_constr_type(lp, i) == EQ))) {
-          report(lp, NORMAL, "presolve_mergerows: Inconsistent equalities %d and %d found\n",
-                             ix, i);
-          status = presolve_setstatus(psdata, INFEASIBLE);
-        }
+          /* First check for inconsistent equalities */
+          if((fabs(Value1 - Value2) > psdata->epsvalue) &&
+             ((get_constr_type(lp, ix) == EQ) && (get_constr_type(lp, i) == EQ))) {
+            report(lp, NORMAL, "presolve_mergerows: Inconsistent equalities %d and %d found\n",
+                               ix, i);
+            status = presolve_setstatus(psdata, INFEASIBLE);
+          }
 
-        else {
+          else {
 
-          /* Update lower and upper bounds */
-          if(is_chsign(lp, i) != is_chsign(lp, ix))
-            bound = -bound;
+            /* Update lower and upper bounds */
+            if(is_chsign(lp, i) != is_chsign(lp, ix))
+              bound = -bound;
 
-          Value1 = get_rh_lower(lp, i);
-          if(Value1 <= -lp->infinite)
-            Value1 *= my_sign(bound);
-          else
-            Value1 *= bound;
-          my_roundzero(Value1, lp->epsdual);      /* Extra rounding tolerance *** */
+            Value1 = get_rh_lower(lp, i);
+            if(Value1 <= -lp->infinite)
+              Value1 *= my_sign(bound);
+            else
+              Value1 *= bound;
+            my_roundzero(Value1, lp->epsdual);      /* Extra rounding tolerance *** */
 
-          Value2 = get_rh_upper(lp, i);
-          if(Value2 >= lp->infinite)
-            Value2 *= my_sign(bound);
-          else
-            Value2 *= bound;
-          my_roundzero(Value2, lp->epsdual);      /* Extra rounding tolerance *** */
+            Value2 = get_rh_upper(lp, i);
+            if(Value2 >= lp->infinite)
+              Value2 *= my_sign(bound);
+            else
+              Value2 *= bound;
+            my_roundzero(Value2, lp->epsdual);      /* Extra rounding tolerance *** */
 
-          if((bound < 0))
-            swapREAL(&Value1, &Value2);
+            if((bound < 0))
+              swapREAL(&Value1, &Value2);
 
-          bound = get_rh_lower(lp, ix);
-          if(Value1 > bound + psdata->epsvalue)
-            set_rh_lower(lp, ix, Value1);
-          else
-            Value1 = bound;
-          bound = get_rh_upper(lp, ix);
-          if(Value2 < bound - psdata->epsvalue)
-            set_rh_upper(lp, ix, Value2);
-          else
-            Value2 = bound;
+            bound = get_rh_lower(lp, ix);
+            if(Value1 > bound + psdata->epsvalue)
+              set_rh_lower(lp, ix, Value1);
+            else
+              Value1 = bound;
+            bound = get_rh_upper(lp, ix);
+            if(Value2 < bound - psdata->epsvalue)
+              set_rh_upper(lp, ix, Value2);
+            else
+              Value2 = bound;
 
-          /* Check results and make equality if appropriate */
-          if(fabs(Value2-Value1) < psdata->epsvalue)
-            presolve_setEQ(psdata, ix);
-          else if(Value2 < Value1) {
-            status = presolve_setstatus(psdata, INFEASIBLE);
-          }
+            /* Check results and make equality if appropriate */
+            if(fabs(Value2-Value1) < psdata->epsvalue)
+              presolve_setEQ(psdata, ix);
+            else if(Value2 < Value1) {
+              status = presolve_setstatus(psdata, INFEASIBLE);
+            }
 
-          /* Verify if we can continue */
-          candelete = (MYBOOL) (status == RUNNING);
-          if(!candelete) {
-            report(lp, NORMAL, "presolve: Range infeasibility found involving rows %s and %s\n",
-                                get_row_name(lp, ix), get_row_name(lp, i));
+            /* Verify if we can continue */
+            candelete = (MYBOOL) (status == RUNNING);
+            if(!candelete) {
+              report(lp, NORMAL, "presolve: Range infeasibility found involving rows %s and %s\n",
+                                  get_row_name(lp, ix), get_row_name(lp, i));
+            }
           }
         }
-      }
-      /* Perform i-row deletion if authorized */
-      if(candelete) {
-        presolve_rowremove(psdata, i, TRUE);
-        n++;
-        break;
+        /* Perform i-row deletion if authorized */
+        if(candelete) {
+          presolve_rowremove(psdata, i, TRUE);
+          QS[RT1].int4.intval = -i;
+          n++;
+          break;
+        }
       }
     }
-    i = firstix;
   }
+  FREE(QS);
   (*nRows) += n;
   (*nSum)  += n;
 
@@ -2426,6 +2527,7 @@ STATIC MYBOOL presolve_reduceGCD(presolverec *psdata, int *nn, int *nb, int *nsu
         *Avalue /= GCDvalue;
         in++;
       }
+      mat->row_copy_valid = FALSE;
       Rvalue = (lp->orig_rhs[i] / GCDvalue) + epsvalue;
       lp->orig_rhs[i] = floor(Rvalue);
       Rvalue = fabs(lp->orig_rhs[i]-Rvalue);
@@ -2880,10 +2982,6 @@ STATIC int presolve_elimeq2(presolverec *psdata, int *nn, int *nr, int *nc, int
     negcount = psdata->rows->negcount;
     colplu = 0;
     colneg = 0;
-    /* Count of non-zeros in the independent column jjx */
-    item = presolve_collength(psdata, jjx) - 1;
-    if(isnz_origobj(lp, jjx))
-      item++;
     for(k = 0; k <= nrows; k++, colitem++) {
 
       bound = delvalue[k];
@@ -2911,7 +3009,6 @@ STATIC int presolve_elimeq2(presolverec *psdata, int *nn, int *nr, int *nc, int
           psdata->cols->pluneg[jjx]--;
           psdata->rows->pluneg[k]--;
         }
-        item--;
       }
       (*colitem) -= bound*Value2;
       iCoeffChanged++;
@@ -2930,7 +3027,6 @@ STATIC int presolve_elimeq2(presolverec *psdata, int *nn, int *nr, int *nc, int
           psdata->cols->pluneg[jjx]++;
           psdata->rows->pluneg[k]++;
         }
-        item++;
       }
       else {
         *colitem = 0;
@@ -2968,16 +3064,10 @@ STATIC int presolve_elimeq2(presolverec *psdata, int *nn, int *nr, int *nc, int
     jx = presolve_colremove(psdata, jx, FALSE);
     iVarsFixed++;
 
-    /* Check if we have been lucky enough to have eliminated the independent
-       variable via substitution of the dependent variable */
-    if(item == 0) {
-#ifdef Paranoia
-      report(lp, DETAILED, "presolve_elimeq2: Was able to remove variables %d and %d in row %s\n",
-                         jx, jjx, get_row_name(lp, i));
-#endif
-      if(presolve_colfix(psdata, jjx, 0.0, TRUE, nc))
-        jjx = presolve_colremove(psdata, jjx, FALSE);
-    }
+    /* If the substitution also eliminated the independent variable, then its
+       column is empty once the updates below are applied; it is left to
+       presolve_columns, since fixing it here would adjust the rhs by the
+       stale coefficients that are still in the matrix. */
 
     /* Delete the row */
     presolve_rowremove(psdata, i, FALSE);
@@ -3271,6 +3361,10 @@ STATIC psrec *presolve_initpsrec(lprec *lp, int size)
   allocINT(lp,  &ps->negcount,  size, TRUE);
   allocINT(lp,  &ps->pluneg,    size, TRUE);
 
+  allocINT(lp,  &ps->dirty,     size, FALSE);
+  ps->dirty[0] = 0;
+  allocMYBOOL(lp, &ps->isdirty, size, TRUE);
+
   ps->allocsize = size;
 
   return( ps );
@@ -3281,6 +3375,8 @@ STATIC void presolve_freepsrec(psrec **ps)
   FREE((*ps)->negcount);
   FREE((*ps)->pluneg);
   FREE((*ps)->infcount);
+  FREE((*ps)->dirty);
+  FREE((*ps)->isdirty);
 
   if((*ps)->next != NULL) {
     int i, n = (*ps)->allocsize;
@@ -3402,6 +3498,7 @@ STATIC presolverec *presolve_init(lprec *lp)
       for(; ix < ixx; ix++) {
         ROW_MAT_VALUE(ix) *= hold;
       }
+      mat->row_copy_valid = FALSE;
       lp->orig_rhs[i] *= hold;
       if(!my_infinite(lp, lp->orig_upbo[i]))
         lp->orig_upbo[i] *= hold; /* KE: Fix due to Andy Loto - 20070619 */
@@ -3582,11 +3679,9 @@ STATIC MYBOOL presolve_finalize(presolverec *psdata)
     varmap_compact(lp, lp->presolve_undo->orig_rows,
                        lp->presolve_undo->orig_columns);
 
-  /* Reduce memory usage of postsolve matrices */
-  if(lp->presolve_undo->primalundo != NULL)
-    mat_memopt(lp->presolve_undo->primalundo->tracker, 0, 0, 0);
-  if(lp->presolve_undo->dualundo != NULL)
-    mat_memopt(lp->presolve_undo->dualundo->tracker, 0, 0, 0);
+  /* Reduce memory usage of the postsolve undo logs */
+  memoptUndoLog(lp->presolve_undo->primalundo);
+  memoptUndoLog(lp->presolve_undo->dualundo);
 
   /* Round near-zero objective function coefficients and RHS values */
   ke = lp->columns;
@@ -3676,42 +3771,29 @@ int CMP_CALLMODEL compSparsity(const UNIONTYPE QSORTrec *current, const UNIONTYP
   }
   return( result );
 }
-int CMP_CALLMODEL compAggregate(const UNIONTYPE QSORTrec *current, const UNIONTYPE QSORTrec *candidate)
-{
-  int  index1 = (int) (current->pvoidint2.intval),
-       index2 = (int) (candidate->pvoidint2.intval);
-  lprec *lp   = (lprec *) current->pvoidint2.ptr;
-  REAL value1 = lp->orig_obj[index1],
-       value2 = lp->orig_obj[index2];
-
-  /* Smallest objective coefficient (largest contribution to OF) */
-  int  result = CMP_COMPARE(value1, value2);
 
-  /* Smallest lower variable bound */
-  if(result == 0) {
-    index1 += lp->rows;
-    index2 += lp->rows;
-    value1 = lp->orig_lowbo[index1];
-    value2 = lp->orig_lowbo[index2];
-    result = CMP_COMPARE(value1, value2);
-  }
+STATIC unsigned LLONG presolve_rowsignature(presolverec *psdata, int rownr)
+/* Bloom-style 64-bit signature of the set of active columns in a row; a row
+   can only be a subset of another row if its signature is a subset as well */
+{
+  MATrec        *mat = psdata->lp->matA;
+  int           ix, item = 0;
+  unsigned LLONG sig = 0;
 
-  /* Largest upper variable bound */
-  if(result == 0) {
-    value1 = lp->orig_upbo[index1];
-    value2 = lp->orig_upbo[index2];
-    result = -CMP_COMPARE(value1, value2);
-  }
-  return( result );
+  for(ix = presolve_nextcol(psdata, rownr, &item); ix >= 0; ix = presolve_nextcol(psdata, rownr, &item))
+    sig |= ((unsigned LLONG) 1) << ((((unsigned int) ROW_MAT_COLNR(ix)) * 2654435761u) >> 26);
+  return( sig );
 }
 
 STATIC int presolve_rowdominance(presolverec *psdata, int *nCoeffChanged, int *nRowsRemoved, int *nVarsFixed, int *nSum)
 {
   lprec    *lp = psdata->lp;
   MATrec   *mat = lp->matA;
-  int      i, ii, ib, ie, n, jb, je, jx, *coldel = NULL, status = RUNNING, item,
+  MYBOOL   *stale = NULL;
+  int      i, ii, ib, ie, n, jb, je, jx, *coldel = NULL, status = RUNNING, item, item2,
            iCoeffChanged = 0, iRowRemoved = 0, iVarFixed = 0;
-  REAL     ratio, *rowvalues = NULL;
+  REAL     ratio;
+  unsigned LLONG *sig = NULL;
   UNIONTYPE QSORTrec *QS = (UNIONTYPE QSORTrec *) calloc(lp->rows+1, sizeof(*QS));
 
   /* Check if we were able to obtain working memory */
@@ -3750,10 +3832,18 @@ STATIC int presolve_rowdominance(presolverec *psdata, int *nCoeffChanged, int *n
   QS_execute(QS, n, (findCompare_func *) compRedundant, NULL);
 
   /* Let us start from the top of the list, going forward and looking
-    for the longest possible dominating row */
-  if(!allocREAL(lp, &rowvalues, lp->columns + 1, TRUE) ||
+    for the longest possible dominating row; the column set signatures
+    reject most of the candidate pairs without looking at the rows */
+  sig = (unsigned LLONG *) calloc(lp->rows+1, sizeof(*sig));
+  if((sig == NULL) ||
+     !allocMYBOOL(lp, &stale, lp->rows + 1, FALSE) ||
      !allocINT(lp, &coldel, lp->columns + 1, FALSE))
     goto Finish;
+  for(ib = 0; ib < n; ib++) {
+    i = QS[ib].int4.intval;
+    sig[i] = presolve_rowsignature(psdata, i);
+    stale[i] = FALSE;
+  }
 
   for(ib = 0; ib < n; ib++) {
 
@@ -3761,13 +3851,9 @@ STATIC int presolve_rowdominance(presolverec *psdata, int *nCoeffChanged, int *n
     i = QS[ib].int4.intval;
     if(i < 0)
       continue;
-
-    /* Load the non-zero row values */
-    item = 0;
-    for(jb = presolve_nextcol(psdata, i, &item); jb >= 0;
-        jb = presolve_nextcol(psdata, i, &item)) {
-      jx = ROW_MAT_COLNR(jb);
-      rowvalues[jx] = ROW_MAT_VALUE(jb);
+    if(stale[i]) {
+      sig[i] = presolve_rowsignature(psdata, i);
+      stale[i] = FALSE;
     }
 
     for(ie = ib+1; ie < n; ie++) {
@@ -3783,8 +3869,23 @@ STATIC int presolve_rowdominance(presolverec *psdata, int *nCoeffChanged, int *n
         report(lp, SEVERE, "presolve_rowdominance: Invalid sorted row order\n");
 #endif
 
+      /* Reject candidates that are longer or that have columns outside the
+        range or the signature of the dominating row */
+      jb = presolve_rowlength(psdata, ii);
+      if((jb > presolve_rowlength(psdata, i)) ||
+         ((jb > 0) && (ROW_MAT_COLNR(presolve_nextrecord(psdata->rows, ii, NULL)) >
+                       ROW_MAT_COLNR(presolve_nextrecord(psdata->rows, i, NULL)))))
+        continue;
+      if(stale[ii]) {
+        sig[ii] = presolve_rowsignature(psdata, ii);
+        stale[ii] = FALSE;
+      }
+      if((sig[ii] & ~sig[i]) != 0)
+        continue;
+
       /* Loop over every row member to confirm that the candidate
-        actually dominates in every position */
+        actually dominates in every position; both rows are sorted by
+        column, so this is a merge of the two */
       if((lp->orig_rhs[i] == 0) && (lp->orig_rhs[ii] == 0))
         ratio = 0;
       else if((lp->orig_rhs[i] != 0) && (lp->orig_rhs[ii] != 0))
@@ -3792,14 +3893,18 @@ STATIC int presolve_rowdominance(presolverec *psdata, int *nCoeffChanged, int *n
       else
         continue;
       item = 0;
-      for(jb = presolve_nextcol(psdata, ii, &item); jb >= 0;
-          jb = presolve_nextcol(psdata, ii, &item)) {
+      je = presolve_nextcol(psdata, i, &item);
+      item2 = 0;
+      for(jb = presolve_nextcol(psdata, ii, &item2); jb >= 0;
+          jb = presolve_nextcol(psdata, ii, &item2)) {
         jx = ROW_MAT_COLNR(jb);
-        if(rowvalues[jx] == 0)
+        while((je >= 0) && (ROW_MAT_COLNR(je) < jx))
+          je = presolve_nextcol(psdata, i, &item);
+        if((je < 0) || (ROW_MAT_COLNR(je) != jx))
           break;
         if(ratio == 0)
-          ratio = rowvalues[jx] / ROW_MAT_VALUE(jb);
-        else if(fabs(rowvalues[jx] - ratio*ROW_MAT_VALUE(jb)) > psdata->epsvalue)
+          ratio = ROW_MAT_VALUE(je) / ROW_MAT_VALUE(jb);
+        else if(fabs(ROW_MAT_VALUE(je) - ratio*ROW_MAT_VALUE(jb)) > psdata->epsvalue)
           break;
       }
 
@@ -3810,41 +3915,45 @@ STATIC int presolve_rowdominance(presolverec *psdata, int *nCoeffChanged, int *n
         /* Need to fix any superset columns, but require that they have equal signs */
         coldel[0] = 0;
         item = 0;
+        item2 = 0;
+        je = presolve_nextcol(psdata, ii, &item2);
         for(jb = presolve_nextcol(psdata, i, &item); jb >= 0;
             jb = presolve_nextcol(psdata, i, &item)) {
           jx = ROW_MAT_COLNR(jb);
-          if(mat_findelm(mat, ii, jx) <= 0) {
+          if((je >= 0) && (ROW_MAT_COLNR(je) == jx)) {
+            je = presolve_nextcol(psdata, ii, &item2);
+            continue;
+          }
 
-            /* Cancel if we detect a free or "quasi-free" variable */
-            if((lp->orig_lowbo[lp->rows + jx] < 0) &&
-               (lp->orig_upbo[lp->rows + jx] > 0)) {
-              coldel[0] = -1;
-              break;
-            }
+          /* Cancel if we detect a free or "quasi-free" variable */
+          if((lp->orig_lowbo[lp->rows + jx] < 0) &&
+             (lp->orig_upbo[lp->rows + jx] > 0)) {
+            coldel[0] = -1;
+            break;
+          }
 
-            /* Ensure that we are feasible */
-            else if((lp->orig_lowbo[lp->rows + jx] > 0) ||
-               (lp->orig_upbo[lp->rows + jx] < 0)) {
-              report(lp, DETAILED, "presolve_rowdominate: Column %s is infeasible due to conflict in rows %s and %s\n",
-                                    get_col_name(lp, jx), get_row_name(lp, i), get_row_name(lp, ii));
-              coldel[0] = -1;
-              break;
-            }
+          /* Ensure that we are feasible */
+          else if((lp->orig_lowbo[lp->rows + jx] > 0) ||
+             (lp->orig_upbo[lp->rows + jx] < 0)) {
+            report(lp, DETAILED, "presolve_rowdominate: Column %s is infeasible due to conflict in rows %s and %s\n",
+                                  get_col_name(lp, jx), get_row_name(lp, i), get_row_name(lp, ii));
+            coldel[0] = -1;
+            break;
+          }
 
-            /* Check consistency / uniformity of signs */
-            sign_j = my_sign(ROW_MAT_VALUE(jb));
-            sign_j = my_chsign(is_negative(lp, jx), sign_j);
-            if(coldel[0] == 0) {
-              sign_1 = sign_j;
-              coldel[++coldel[0]] = jx;
-            }
-            else if(sign_j == sign_1) {
-              coldel[++coldel[0]] = jx;
-            }
-            else {
-              coldel[0] = -1;
-              break;
-            }
+          /* Check consistency / uniformity of signs */
+          sign_j = my_sign(ROW_MAT_VALUE(jb));
+          sign_j = my_chsign(is_negative(lp, jx), sign_j);
+          if(coldel[0] == 0) {
+            sign_1 = sign_j;
+            coldel[++coldel[0]] = jx;
+          }
+          else if(sign_j == sign_1) {
+            coldel[++coldel[0]] = jx;
+          }
+          else {
+            coldel[0] = -1;
+            break;
           }
         }
 
@@ -3852,15 +3961,18 @@ STATIC int presolve_rowdominance(presolverec *psdata, int *nCoeffChanged, int *n
         if(coldel[0] < 0)
           continue;
 
-        /* Do the column fixing and deletion (check for infeasibility in the process) */
+        /* Do the column fixing and deletion (check for infeasibility in the process);
+          the signatures of the other rows of the columns become outdated */
         for(jb = 1; jb <= coldel[0]; jb++) {
           jx = coldel[jb];
+          item = 0;
+          for(je = presolve_nextrow(psdata, jx, &item); je >= 0; je = presolve_nextrow(psdata, jx, &item))
+            stale[COL_MAT_ROWNR(je)] = TRUE;
           if(!presolve_colfix(psdata, jx, 0, TRUE, &iVarFixed)) {
              status = presolve_setstatus(psdata, INFEASIBLE);
              goto Finish;
           }
           presolve_colremove(psdata, jx, TRUE);
-          rowvalues[jx] = 0;
         }
 
         /* Then delete the row */
@@ -3870,16 +3982,11 @@ STATIC int presolve_rowdominance(presolverec *psdata, int *nCoeffChanged, int *n
       }
     }
 
-    /* Clear the non-zero row values ahead of the next row candidate */
-    ie = mat->row_end[i-1];
-    ii = mat->row_end[i];
-    for(; ie < ii; ie++)
-      rowvalues[ROW_MAT_COLNR(ie)] = 0;
-
   }
 Finish:
   FREE(QS);
-  FREE(rowvalues);
+  FREE(sig);
+  FREE(stale);
   FREE(coldel);
 
   (*nCoeffChanged) += iCoeffChanged;
@@ -4265,480 +4372,410 @@ Finish:
 
 #endif
 
-STATIC int presolve_aggregate(presolverec *psdata, int *nConRemoved, int *nVarsFixed, int *nSum)
-/* This routine combines compatible or identical columns */
+STATIC MYBOOL presolve_duplicatefix(presolverec *psdata, int colnr, int partner, REAL ratio, REAL delta, int *nVarsFixed, int *status)
+/* Column colnr is parallel to column partner with colnr = ratio * partner, and its
+   objective coefficient relative to the partner is delta; fix colnr at the bound
+   that is favoured by delta if the partner has room to absorb the difference */
 {
   lprec    *lp = psdata->lp;
-  MATrec   *mat = lp->matA;
-  MYBOOL   first;
-  int      i, ii, ib, ie, ix, n, jb, je, jx, jj, item, item2,
-           *coldel = NULL, status = RUNNING, iVarFixed = 0;
-  REAL     scale, *colvalues = NULL;
-  UNIONTYPE QSORTrec *QScand = (UNIONTYPE QSORTrec *) calloc(lp->columns+1, sizeof(*QScand));
+  REAL     lobound = lp->orig_lowbo[lp->rows + colnr],
+           upbound = lp->orig_upbo[lp->rows + colnr];
+  MYBOOL   lofree = (MYBOOL) (lp->orig_lowbo[lp->rows + partner] <= -lp->infinite),
+           upfree = (MYBOOL) (lp->orig_upbo[lp->rows + partner] >= lp->infinite),
+           fixed;
+
+  if((delta > -psdata->epsvalue) && (lobound > -lp->infinite) &&
+     ((ratio > 0) ? upfree : lofree))
+    upbound = lobound;
+  else if((delta < psdata->epsvalue) && (upbound < lp->infinite) &&
+          ((ratio > 0) ? lofree : upfree))
+    lobound = upbound;
+  else
+    return( FALSE );
 
-  /* Check if we were able to obtain working memory */
-  if(QScand == NULL)
-    return( status);
+  fixed = presolve_colfix(psdata, colnr, lobound, TRUE, nVarsFixed);
+  if(!fixed)
+    *status = presolve_setstatus(psdata, INFEASIBLE);
+  else
+    presolve_colremove(psdata, colnr, TRUE);
+  return( fixed );
+}
 
-  /* Obtain the list of qualifying columns to be sorted */
-  n = 0;
-  for(i = firstActiveLink(psdata->cols->varmap); i != 0; i = nextActiveLink(psdata->cols->varmap, i))
-    if(!is_semicont(lp, i) && !SOS_is_member(lp->SOS, 0, i)) {
-      QScand[n].int4.intval = i;
-      item = 0;
-      ii = presolve_nextrow(psdata, i, &item);
-      QScand[n].int4.intpar1 = COL_MAT_ROWNR(ii);
-      ii = presolve_collength(psdata, i);
-      QScand[n].int4.intpar2 = ii;
-      n++;
-    }
-  if(n <= 1) {
-    FREE(QScand);
+STATIC int presolve_duplicatecols(presolverec *psdata, int *nVarsFixed, int *nSum)
+/* Eliminate continuous columns that are parallel to another column and that
+   are dominated by it; the columns are fingerprinted and sorted so that only
+   columns with the same fingerprint and length need to be compared */
+{
+  lprec    *lp = psdata->lp;
+  MATrec   *mat = lp->matA;
+  int      ib, ie, ii, jj, i, ix, item1, item2, iix, jjx,
+           n = 0, iVarFixed = 0, status = RUNNING;
+  REAL     ratio, value;
+  UNIONTYPE QSORTrec *QS = (UNIONTYPE QSORTrec *) calloc(lp->columns+1, sizeof(*QS));
+
+  if(QS == NULL)
     return( status );
-  }
-  QS_execute(QScand, n, (findCompare_func *) compRedundant, NULL);
 
-  /* Let us start from the top of the list, going forward and looking
-    for the longest possible identical column */
-  if(!allocREAL(lp, &colvalues, lp->rows + 1, TRUE) ||
-     !allocINT(lp, &coldel, lp->columns + 1, FALSE))
-    goto Finish;
+  for(i = firstActiveLink(psdata->cols->varmap); i != 0; i = nextActiveLink(psdata->cols->varmap, i)) {
+    ix = presolve_collength(psdata, i);
+    if((ix == 0) || is_int(lp, i) || is_semicont(lp, i) || SOS_is_member(lp->SOS, 0, i))
+      continue;
+    QS[n].int4.intval  = i;
+    QS[n].int4.intpar1 = presolve_fingerprint(psdata, i, FALSE);
+    QS[n].int4.intpar2 = ix;
+    n++;
+  }
+  QS_execute(QS, n, (findCompare_func *) compSparsity, NULL);
 
-  for(ib = 0; ib < n; ib++) {
+  for(ib = 0; (ib < n) && (status == RUNNING); ib = ie) {
+    for(ie = ib+1; (ie < n) && (QS[ie].int4.intpar1 == QS[ib].int4.intpar1) &&
+                              (QS[ie].int4.intpar2 == QS[ib].int4.intpar2); ie++);
+    for(ii = ib+1; (ii < ie) && (status == RUNNING); ii++) {
+      i = QS[ii].int4.intval;
+      for(jj = ib; (jj < ii) && (status == RUNNING); jj++) {
+        ix = QS[jj].int4.intval;
+        if(ix < 0)
+          continue;
 
-    /* Get column and check if it was previously eliminated */
-    i = QScand[ib].int4.intval;
-    if(i < 0)
-      continue;
+        /* Verify that the columns have a constant non-zero ratio in identical rows */
+        ratio = 0;
+        item1 = 0;
+        item2 = 0;
+        for(iix = presolve_nextrow(psdata, i, &item1), jjx = presolve_nextrow(psdata, ix, &item2);
+            iix >= 0;
+            iix = presolve_nextrow(psdata, i, &item1), jjx = presolve_nextrow(psdata, ix, &item2)) {
+          if(COL_MAT_ROWNR(iix) != COL_MAT_ROWNR(jjx))
+            break;
+          value = COL_MAT_VALUE(iix) / COL_MAT_VALUE(jjx);
+          if(ratio == 0)
+            ratio = value;
+          else if(fabs(value - ratio) > psdata->epsvalue)
+            break;
+        }
+        if(iix >= 0)
+          continue;
 
-    /* Load the non-zero column values of this active/reference column */
-    item = 0;
-    for(jb = presolve_nextrow(psdata, i, &item); jb >= 0;
-        jb = presolve_nextrow(psdata, i, &item)) {
-      jx = COL_MAT_ROWNR(jb);
-      colvalues[jx] = COL_MAT_VALUE(jb);
+        /* Try to fix the later column first, then its partner */
+        value = lp->orig_obj[i] - ratio*lp->orig_obj[ix];
+        if(presolve_duplicatefix(psdata, i, ix, ratio, value, &iVarFixed, &status)) {
+          QS[ii].int4.intval = -i;
+          break;
+        }
+        if(status != RUNNING)
+          break;
+        if(presolve_duplicatefix(psdata, ix, i, 1/ratio, -value/ratio, &iVarFixed, &status))
+          QS[jj].int4.intval = -ix;
+      }
     }
+  }
+  FREE(QS);
 
-    coldel[0] = 0;
-    for(ie = ib+1; ie < n; ie++) {
+  (*nVarsFixed) += iVarFixed;
+  (*nSum)       += iVarFixed;
 
-      /* Insist on identical column lengths (sort is decending in column lengths) */
-      ii = QScand[ib].int4.intpar2 - QScand[ie].int4.intpar2;
-      if(ii != 0)
-        break;
+  return( status );
+}
 
-      /* Also insist on identical starting positions */
-      ii = QScand[ib].int4.intpar1 - QScand[ie].int4.intpar1;
-      if(ii != 0)
-        break;
+STATIC int presolve_aggregate(presolverec *psdata, int *nCoeffChanged, int *nConRemoved, int *nVarsFixed, int *nSum)
+/* Aggregate continuous, implied free variables out of the model.  When such a
+   variable appears in an equality and in at most two other constraints, it is
+   substituted by the equality in the other constraints and in the objective,
+   whereafter the equality and the variable are deleted; the fill-in is limited
+   to the number of deleted non-zeros.  The variable is recovered from the undo
+   chain at postsolve. */
+{
+  lprec     *lp = psdata->lp;
+  MATrec    *mat = lp->matA, *rev = NULL;
+  DeltaVrec *DV = NULL;
+  MYBOOL    undoadded, *coltouched = NULL, *rowtouched = NULL;
+  int       i, ix, j, jnext, k, n, item, item2, collen, rowlen, rownr, nrows = lp->rows,
+            status = RUNNING, iCoeffChanged = 0, iConRemoved = 0, iVarsFixed = 0;
+  REAL      pivot, ratio, value, losum, upsum, lobound, upbound,
+            *colvalue = NULL, *pivvalue = NULL;
 
-      /* Get column and check if it was previously eliminated */
-      ii = QScand[ie].int4.intval;
-      if(ii < 0)
+  /* See if there is anything to do */
+  if(psdata->EQmap->count == 0)
+    return( status );
+  if(!allocMYBOOL(lp, &coltouched, lp->columns+1, TRUE) ||
+     !allocMYBOOL(lp, &rowtouched, nrows+1, TRUE) ||
+     !allocREAL(lp, &colvalue, nrows+1, FALSE) ||
+     !allocREAL(lp, &pivvalue, nrows+1, FALSE))
+    goto Finish;
+
+  for(j = firstActiveLink(psdata->cols->varmap); j != 0; j = jnext) {
+    jnext = nextActiveLink(psdata->cols->varmap, j);
+    collen = presolve_collength(psdata, j);
+    if(coltouched[j] || (collen < 2) || (collen > 3) ||
+       is_int(lp, j) || is_semicont(lp, j) || SOS_is_member(lp->SOS, 0, j))
+      continue;
+
+    /* Find an unchanged equality with a stable pivot and with columns that are unchanged
+       in this pass, and which by itself implies the bounds of the variable */
+    rownr = 0;
+    item = 0;
+    for(ix = presolve_nextrow(psdata, j, &item); (ix >= 0) && (rownr == 0);
+        ix = presolve_nextrow(psdata, j, &item)) {
+      i = COL_MAT_ROWNR(ix);
+      if(rowtouched[i] || !isActiveLink(psdata->EQmap, i))
+        continue;
+      rowlen = presolve_rowlength(psdata, i);
+      if((rowlen < 2) || ((collen-1)*(rowlen-1) > collen+rowlen-1))
+        continue;
+      pivot = COL_MAT_VALUE(ix);
+      if((fabs(pivot) < psdata->epspivot*mat->colmax[j]) ||
+         (fabs(pivot) < psdata->epspivot*mat->rowmax[i]))
         continue;
 
-      /* Loop over every column member to confirm that the candidate is
-        relatively identical in every position */
-      first = TRUE;
-      item = 0;
+      /* Compute the activity range of the other columns of the equality */
+      losum = 0;
+      upsum = 0;
       item2 = 0;
-      scale = 1;
-      for(jb = presolve_nextrow(psdata, ii, &item),
-          jj = presolve_nextrow(psdata, i, &item2); jb >= 0;
-          jb = presolve_nextrow(psdata, ii, &item),
-          jj = presolve_nextrow(psdata, i, &item2)) {
-        jx = COL_MAT_ROWNR(jb);
-        if(jx != COL_MAT_ROWNR(jj))
+      for(k = presolve_nextcol(psdata, i, &item2); k >= 0; k = presolve_nextcol(psdata, i, &item2)) {
+        n = ROW_MAT_COLNR(k);
+        if(n == j)
+          continue;
+        if(coltouched[n] || is_semicont(lp, n) || SOS_is_member(lp->SOS, 0, n))
           break;
-        if(first) {
-          first = !first;
-          scale = colvalues[jx] / COL_MAT_VALUE(jb);
-        }
-        else {
-          if(fabs(colvalues[jx] - scale * COL_MAT_VALUE(jb)) > psdata->epsvalue)
-            break;
-        }
-      }
+        value = ROW_MAT_VALUE(k);
+        lobound = get_lowbo(lp, n);
+        upbound = get_upbo(lp, n);
+        if(value < 0)
+          swapREAL(&lobound, &upbound);
+        losum += (my_infinite(lp, lobound) ? -lp->infinite : value*lobound);
+        upsum += (my_infinite(lp, upbound) ? lp->infinite : value*upbound);
+      }
+      if(k >= 0)
+        continue;
 
-      /* "We have contact", store the column in the aggregation list */
-      if(jb < 0) {
-        coldel[++coldel[0]] = ii;
-        QScand[ie].int4.intval = -ii;
+      /* Check that the variable bounds are implied */
+      if(pivot < 0)
+        swapREAL(&losum, &upsum);
+      lobound = (my_infinite(lp, upsum) ? -lp->infinite : (lp->orig_rhs[i] - upsum) / pivot);
+      upbound = (my_infinite(lp, losum) ? lp->infinite : (lp->orig_rhs[i] - losum) / pivot);
+      if((lobound > get_lowbo(lp, j) - psdata->epsvalue) &&
+         (upbound < get_upbo(lp, j) + psdata->epsvalue))
+        rownr = i;
+    }
+    if(rownr == 0)
+      continue;
+
+    /* Add the undo information for the constant term of the eliminated variable */
+    mat_expandcolumn(mat, j, pivvalue, NULL, TRUE);
+    pivot = pivvalue[rownr];
+    ratio = my_chsign(is_chsign(lp, rownr), lp->orig_rhs[rownr]) / pivot;
+    undoadded = FALSE;
+    if(ratio != 0)
+      undoadded = addUndoPresolve(lp, TRUE, j, ratio, 0.0, 0);
+
+    /* Update the RHS of the other rows and the objective constant */
+    pivvalue[rownr] = 0;
+    for(i = 0; i <= nrows; i++) {
+      if((pivvalue[i] == 0) || ((i > 0) && !isActiveLink(psdata->rows->varmap, i))) {
+        pivvalue[i] = 0;
+        continue;
       }
+      presolve_adjustrhs(psdata, i, my_chsign(is_chsign(lp, i), pivvalue[i]*ratio), psdata->epsvalue);
+      rowtouched[i] = TRUE;
     }
 
-    /* Sort the aggregation list if we have aggregation candidates */
-    if(coldel[0] > 1) {
-      REAL     of, ofelim, fixvalue;
-      MYBOOL   isint;
-      UNIONTYPE QSORTrec *QSagg = (UNIONTYPE QSORTrec *) calloc(coldel[0], sizeof(*QSagg));
-
-      for(jb = 1; jb <= coldel[0]; jb++) {
-        ii = jb - 1;
-        QSagg[ii].pvoidint2.intval = coldel[jb];
-        QSagg[ii].pvoidint2.ptr    = (void *) lp;
-      }
-      QS_execute(QSagg, coldel[0], (findCompare_func *) compAggregate, NULL);
-
-      /* Process columns with identical OF coefficients */
-      jb = 0;
-      while((status == RUNNING) && (jb < coldel[0])) {
-        ii = QSagg[jb].pvoidint2.intval;
-        of = lp->orig_obj[ii];
-        isint = is_int(lp, ii);
-        je = jb + 1;
-        while((status == RUNNING) && (je < coldel[0]) &&
-              (fabs(lp->orig_obj[ix = QSagg[je].pvoidint2.intval] - of) < psdata->epsvalue)) {
-           /* We now have two columns with equal OFs; the following cases are possible:
-
-             1) The first column has Inf upper bound, which means that it can
-                "absorb" compatible columns, which are then fixed at the appropriate
-                bounds (or zero in case of free variables).
-             2) The first column has a -Inf lower bound, and further columns are
-                Inf upper bounds, which means steps towards forming a free variable
-                can be made.
-             3) The first column is a non-Inf upper bound, in which case the bounds
-                are summed into a helper variable and the variable simply deleted.
-                The deleted variables' value are allocated/distributed via a simple
-                linear programming routine at postsolve.
-
-             In the current version of this code, we only handle case 1. */
-          if(is_int(lp, ix) == isint) {
-            ofelim = lp->orig_obj[ix];
-            if(of == 0)
-              scale = 1;
-            else
-              scale = ofelim / of;
-
-            if(my_infinite(lp, lp->orig_upbo[lp->rows+ii])) { /* Case 1 (recipe.mps) */
-              if(is_unbounded(lp, ix))
-                fixvalue = 0;
-              else if(ofelim < 0)
-                fixvalue = lp->orig_upbo[lp->rows+ix];
-              else
-                fixvalue = lp->orig_lowbo[lp->rows+ix];
-              if(my_infinite(lp, fixvalue))
-                status = presolve_setstatus(psdata, UNBOUNDED);
-              else if(!presolve_colfix(psdata, ix, fixvalue, TRUE, &iVarFixed))
-                status = presolve_setstatus(psdata, INFEASIBLE);
-              else
-                presolve_colremove(psdata, ix, TRUE);
-            }
+    /* Substitute the variable in the other columns of the equality */
+    item = 0;
+    for(ix = presolve_nextcol(psdata, rownr, &item); ix >= 0; ix = presolve_nextcol(psdata, rownr, &item)) {
+      k = ROW_MAT_COLNR(ix);
+      if(k == j)
+        continue;
+      mat_expandcolumn(mat, k, colvalue, NULL, TRUE);
+      ratio = colvalue[rownr] / pivot;
+      for(i = 0; i <= nrows; i++) {
+        if(pivvalue[i] == 0)
+          continue;
+        colvalue[i] -= pivvalue[i]*ratio;
+        if(fabs(colvalue[i]) < mat->epsvalue)
+          colvalue[i] = 0;
+        iCoeffChanged++;
+      }
+
+      /* Save the new column */
+      if(rev == NULL) {
+        DV = createUndoLadder(lp, nrows, lp->columns / RESIZEFACTOR);
+        rev = DV->tracker;
+        rev->epsvalue = mat->epsvalue;
+        allocINT(lp, &(rev->col_tag), mat->columns_alloc+1, FALSE);
+        rev->col_tag[0] = 0;
+      }
+      n = rev->col_tag[0] = incrementUndoLadder(DV);
+      mat_setcol(rev, n, 0, colvalue, NULL, FALSE, FALSE);
+      rev->col_tag[n] = k;
+      coltouched[k] = TRUE;
+
+      /* Add the reconstruction term of the eliminated variable */
+      if(!undoadded)
+        undoadded = addUndoPresolve(lp, TRUE, j, 0.0, ratio, k);
+      else
+        appendUndoPresolve(lp, TRUE, ratio, k);
+    }
 
-            else if(my_infinite(lp, lp->orig_lowbo[lp->rows+ii])) { /* Case 2 */
-              /* Do nothing */
-            }
+    /* Delete the variable and the equality */
+    coltouched[j] = TRUE;
+    presolve_colremove(psdata, j, FALSE);
+    presolve_rowremove(psdata, rownr, FALSE);
+    iVarsFixed++;
+    iConRemoved++;
+  }
 
-            else {                                            /* Case 3 */
-#if 0
-              /* Do nothing */
-#else
-              if(ofelim >= 0) {
-                fixvalue = lp->orig_lowbo[lp->rows+ix];
-                lp->orig_upbo[lp->rows+ii] += scale * (lp->orig_upbo[lp->rows+ix] - fixvalue);
-              }
-              else {
-                fixvalue = lp->orig_upbo[lp->rows+ix];
-                lp->orig_upbo[lp->rows+ii] -= scale * (fixvalue - lp->orig_lowbo[lp->rows+ix]);
-              }
-              if(my_infinite(lp, fixvalue))
-                status = presolve_setstatus(psdata, UNBOUNDED);
-              else if(!presolve_colfix(psdata, ix, fixvalue, TRUE, &iVarFixed))
-                status = presolve_setstatus(psdata, INFEASIBLE);
-              else
-                presolve_colremove(psdata, ix, TRUE);
-#ifdef xxParanoia
-              if(presolve_rowlengthdebug(psdata) > 0)
-                report(lp, SEVERE, "presolve_aggregate: Invalid row count\n");
-#endif
-              psdata->forceupdate = TRUE;
+  /* Perform the column updates collected above */
+  if(rev != NULL) {
+    mat_mapreplace(mat, psdata->rows->varmap, psdata->cols->varmap, rev);
+    presolve_validate(psdata, TRUE);
+#ifdef PresolveForceUpdateMax
+    mat_computemax(mat /* , FALSE */);
 #endif
-            }
-          }
-          je++;
-        }
-        jb = je;
-      }
-      FREE(QSagg);
-    }
-
-    /* Clear the non-zero row values ahead of the next row candidate */
-    if(ib + 1 < n) {
-      ie = mat->col_end[i-1];
-      ii = mat->col_end[i];
-      for(; ie < ii; ie++)
-        colvalues[COL_MAT_ROWNR(ie)] = 0;
-    }
   }
+  if(iVarsFixed > 0)
+    psdata->forceupdate = TRUE;
+
 Finish:
-  FREE(QScand);
-  FREE(colvalues);
-  FREE(coldel);
+  if(DV != NULL)
+    freeUndoLadder(&DV);
+  FREE(coltouched);
+  FREE(rowtouched);
+  FREE(colvalue);
+  FREE(pivvalue);
 
-  (*nVarsFixed) += iVarFixed;
-  (*nSum)       += iVarFixed;
+  (*nCoeffChanged) += iCoeffChanged;
+  (*nConRemoved)   += iConRemoved;
+  (*nVarsFixed)    += iVarsFixed;
+  (*nSum)          += iCoeffChanged + iConRemoved + iVarsFixed;
 
   return( status );
 }
 
 STATIC int presolve_makesparser(presolverec *psdata, int *nCoeffChanged, int *nConRemove, int *nVarFixed, int *nSum)
+/* Increase the sparsity of the constraint matrix and of the objective by adding
+   multiples of the equality constraints.  A target row must contain every column
+   of the equality so that there is no fill-in, and the multiplier is the ratio
+   that cancels the largest number of coefficients.  The multiple must keep the
+   coefficients of integer columns integral.  Targets that are parallel to the
+   equality are left to PRESOLVE_MERGEROWS. */
 {
   lprec    *lp = psdata->lp;
   MATrec   *mat = lp->matA;
-  MYBOOL   chsign;
-  int      i, ii, ib, ix, k, n, jb, je, jl, jjb, jje, jjl, jx, jjx, item, itemEQ,
-           *nzidx = NULL, status = RUNNING, iObjChanged = 0, iCoeffChanged = 0, iConRemove = 0;
-  REAL     test, ratio, value, valueEQ, *valptr;
-  LLrec    *EQlist = NULL;
-  UNIONTYPE QSORTrec *QS = (UNIONTYPE QSORTrec *) calloc(lp->rows, sizeof(*QS));
+  int      e, i, ix, k, kk, m, n, nz, item, best, count, *eqcols = NULL, *rowindex = NULL,
+           *targets = NULL, status = RUNNING, iCoeffChanged = 0;
+  REAL     lambda, value, *eqvalue = NULL, *ratio = NULL, *rowvalue = NULL, *valptr;
 
-  /* Check if we were able to obtain working memory */
-  if((QS == NULL) || (psdata->rows->varmap->count == 0) || (psdata->EQmap->count == 0))
-    return( status);
+  /* See if there is anything to do */
+  if(psdata->EQmap->count == 0)
+    return( status );
+  if(!allocINT(lp, &eqcols, lp->columns+1, FALSE) ||
+     !allocINT(lp, &rowindex, lp->columns+1, FALSE) ||
+     !allocINT(lp, &targets, lp->rows+2, FALSE) ||
+     !allocREAL(lp, &eqvalue, lp->columns+1, FALSE) ||
+     !allocREAL(lp, &ratio, lp->columns+1, FALSE) ||
+     !allocREAL(lp, &rowvalue, lp->columns+1, TRUE))
+    goto Finish;
 
-  /* Sort rows in 1) increasing order of start index, 2) decreasing length, and
-     3) non-equalities (i.e. equalities last) */
-  n = 0;
-  for(i = firstActiveLink(psdata->rows->varmap); i != 0; i = nextActiveLink(psdata->rows->varmap, i)) {
-    k = presolve_rowlength(psdata, i);
-    if(k >= 2) {
-      item = 0;
-      ii = presolve_nextcol(psdata, i, &item);
-#ifdef Paranoia
-      if((ii < 0) || (item == 0)) {
-        report(lp, SEVERE, "presolve_makesparser: Unexpected zero-length row %d\n", i);
+  for(e = firstActiveLink(psdata->EQmap); e != 0; e = nextActiveLink(psdata->EQmap, e)) {
+
+    /* Collect the equality, and pick its shortest column for the target rows */
+    n = 0;
+    kk = 0;
+    value = lp->infinite;
+    item = 0;
+    for(ix = presolve_nextcol(psdata, e, &item); ix >= 0; ix = presolve_nextcol(psdata, e, &item)) {
+      if(ROW_MAT_VALUE(ix) == 0)
         continue;
-      }
-#endif
-      QS[n].int4.intval  = my_chsign(is_constr_type(lp, i, EQ), i);
-      QS[n].int4.intpar1 = ROW_MAT_COLNR(ii);
-      QS[n].int4.intpar2 = k;
       n++;
+      eqcols[n]  = ROW_MAT_COLNR(ix);
+      eqvalue[n] = ROW_MAT_VALUE(ix);
+      SETMIN(value, fabs(eqvalue[n]));
+      if((kk == 0) || (presolve_collength(psdata, eqcols[n]) < presolve_collength(psdata, kk)))
+        kk = eqcols[n];
     }
-  }
-  if(n <= 1) {
-    FREE(QS);
-    return( status );
-  }
-  QS_execute(QS, n, (findCompare_func *) compSparsity, NULL);
-
-  /* Create associated sorted map of indeces to equality constraints;
-     note that we need to have a unit offset for compatibility. */
-  allocINT(lp, &nzidx, lp->columns + 1, FALSE);
-  createLink(lp->rows, &EQlist, NULL);
-  for(ib = 0; ib < n; ib++) {
-    i = QS[ib].int4.intval;
-    if(i < 0)
-      appendLink(EQlist, ib + 1);
-  }
+    if((n < 2) || (value < psdata->epspivot*mat->rowmax[e]))
+      continue;
 
-  /* Loop over all equality masks */
-  for(ix = firstActiveLink(EQlist); ix != 0; ) {
+    /* List the objective and the other rows of the shortest column as targets */
+    targets[0] = 1;
+    targets[1] = 0;
+    item = 0;
+    for(ix = presolve_nextrow(psdata, kk, &item); ix >= 0; ix = presolve_nextrow(psdata, kk, &item)) {
+      i = COL_MAT_ROWNR(ix);
+      if((i != e) && !isActiveLink(psdata->INTmap, i))
+        targets[++targets[0]] = i;
+    }
 
-    /* Get row starting and ending positions of the mask */
-    ii = abs(QS[ix-1].int4.intval);
-    jjb = QS[ix-1].int4.intpar1;
-    jje = presolve_lastcol(psdata, ii);
-    jje = ROW_MAT_COLNR(jje);
-    jjl = QS[ix-1].int4.intpar2;
+    for(ix = 1; ix <= targets[0]; ix++) {
+      i = targets[ix];
 
-    /* Scan the OF */
-    i = 0;
-    chsign = is_chsign(lp, i);
-    test = ratio = 0.0;
-    itemEQ = 0;
-    nzidx[0] = 0;
-    while(((jjx = presolve_nextcol(psdata, ii, &itemEQ)) >= 0) && /*(itemEQ > 0) && */
-           (fabs(test-ratio) < psdata->epsvalue)) {
-      valueEQ = ROW_MAT_VALUE(jjx);
-      if(valueEQ == 0)
-        continue;
-      k = ROW_MAT_COLNR(jjx);
-      value = lp->orig_obj[k];
-      if(fabs(value) < psdata->epsvalue)
-        break;
-      if(ratio == 0.0) {
-        test = ratio = value / valueEQ;
-      }
-      else
-        test = value / valueEQ;
-      /* Store nz index */
-      nzidx[++nzidx[0]] = k;
-    }
-
-    /* We were successful if the equality was completely traversed; we will
-      then zero-out the OF coefficients and update the constant term. */
-    if((itemEQ == 0) && (nzidx[0] > 0) && (fabs(test-ratio) < psdata->epsvalue)) {
-      for(k = 1; k <= nzidx[0]; k++) {
-        /* We should add recovery data for the zero'ed coefficient here */
-        jx = nzidx[k];
-        value = lp->orig_obj[jx];
-        lp->orig_obj[jx] = 0.0;
-        /* Update counts */
-        value = my_chsign(chsign, value);
-        if(value < 0) {
-          psdata->rows->negcount[i]--;
-          psdata->cols->negcount[jx]--;
-        }
-        else {
-          psdata->rows->plucount[i]--;
-          psdata->cols->plucount[jx]--;
+      /* Scatter the target row and check that it covers the equality */
+      nz = 0;
+      if(i > 0) {
+        k = 0;
+        for(m = presolve_nextcol(psdata, i, &k); m >= 0; m = presolve_nextcol(psdata, i, &k)) {
+          if(ROW_MAT_VALUE(m) == 0)
+            continue;
+          rowvalue[ROW_MAT_COLNR(m)] = ROW_MAT_VALUE(m);
+          rowindex[ROW_MAT_COLNR(m)] = m;
+          nz++;
         }
-        iObjChanged++;
-      }
-      value = ratio * lp->orig_rhs[ii];
-      presolve_adjustrhs(psdata, i, value, psdata->epsvalue);
-    }
-
-    /* Scan for compatible constraints that can be masked for sparsity elimination */
-    for(ib = 1; ib < ix; ib++) {
-
-      /* Get row starting and ending positions of the target constraint */
-      i  = abs(QS[ib-1].int4.intval);
-      jb = QS[ib-1].int4.intpar1;
-      je = presolve_lastcol(psdata, i);
-      je = ROW_MAT_COLNR(je);
-      jl = QS[ib-1].int4.intpar2;
-
-      /* Check if there is a window mismatch */
-      if((jjb < jb) || (jje > je) || (jjl > jl))
-        goto NextEQ;
-
-      /* We have a window match; now check if there is a (scalar) member-by-member
-        match as well.  We approach this in the following manner:
-          1) Get first (or next) member of active equality
-          2) Loop to matching member in the target constraint, but abandon if no match
-          3) Set ratio if this is the first match, otherwise compare ratio and abandon
-             on mismatch
-          4) Go to 1) of there are more elements in the active equality
-          5) Proceed to do sparsity elimination if we were successful. */
-      chsign = is_chsign(lp, i);
-      test = ratio = 0.0;
-      itemEQ = 0;
-      item = 0;
-      nzidx[0] = 0;
-      while(((jjx = presolve_nextcol(psdata, ii, &itemEQ)) >= 0) && /*(itemEQ > 0) &&*/
-             (fabs(test-ratio) < psdata->epsvalue)) {
-        valueEQ = ROW_MAT_VALUE(jjx);
-        if(valueEQ == 0)
-          continue;
-        jx = 0;
-        jjx = ROW_MAT_COLNR(jjx);
-        for(k = presolve_nextcol(psdata, i, &item);
-            (jx < jjx) && (item > 0);
-            k = presolve_nextcol(psdata, i, &item)) {
-          jx = ROW_MAT_COLNR(k);
-          /* Do we have a column index match? */
-          if(jx == jjx) {
-            value = ROW_MAT_VALUE(k);
-            /* Abandon if we have a zero value */
-            if(value == 0)
-              goto NextEQ;
-            if(ratio == 0.0) {
-              test = ratio = value / valueEQ;
-            }
-            else
-              test = value / valueEQ;
-           /* Store nz index */
-            nzidx[++nzidx[0]] = k;
-            break;
+      }
+      for(m = 1; m <= n; m++) {
+        value = (i == 0 ? lp->orig_obj[eqcols[m]] : rowvalue[eqcols[m]]);
+        if(value == 0)
+          break;
+        ratio[m] = value / eqvalue[m];
+      }
+      if(m > n) {
+
+        /* Find the multiplier that cancels the most coefficients */
+        qsortex(ratio+1, n, 0, sizeof(*ratio), FALSE, compareREAL, NULL, 0);
+        best = 0;
+        count = 0;
+        for(m = 1, k = 1; m <= n; m++) {
+          if(ratio[m] - ratio[k] > psdata->epsvalue)
+            k = m;
+          if(m - k + 1 > count) {
+            count = m - k + 1;
+            best = k;
           }
-          /* Give up matching if there is overshooting */
-          else if(jx > jjx)
-            goto NextEQ;
         }
-      }
-
-      /* We were successful if the equality was completely traversed */
-      if((itemEQ == 0) && (nzidx[0] > 0) && (fabs(test-ratio) < psdata->epsvalue)) {
-
-        /* Check if we have found parametrically indentical constraints */
-        if(presolve_rowlength(psdata, i) == presolve_rowlength(psdata,ii)) {
-
-          value = lp->orig_rhs[i];
-          valueEQ = lp->orig_rhs[ii];
+        lambda = ratio[best];
 
-          /* Are they both equalities? */
-          if(is_constr_type(lp, i, EQ)) {
-            /* Determine applicable ratio for the RHS */
-            if(fabs(valueEQ) < psdata->epsvalue) {
-              if(fabs(value) < psdata->epsvalue)
-                test = ratio;
-              else
-                test = lp->infinite;
-            }
-            else
-              test = value / valueEQ;
-            /* Check for infeasibility */
-            if(fabs(test-ratio) > psdata->epsvalue) {
-              report(lp, NORMAL, "presolve_sparser: Infeasibility of relatively equal constraints %d and %d\n",
-                                 i, ii);
-              status = presolve_setstatus(psdata, INFEASIBLE);
-              goto Finish;
-            }
-            /* Otherwise we can delete a redundant constraint */
-            else {
-              removeLink(EQlist, i);
-              presolve_rowremove(psdata, i, TRUE);
-              MEMCOPY(&QS[ib-1], &QS[ib], n-ib);
-              n--;
-              iConRemove++;
-            }
-          }
-          /* ... if not, then delete the inequality, since the equality dominates */
-          else {
-            /* First verify feasibility of the RHS */
-            if((value+psdata->epsvalue < valueEQ) ||
-               (value-get_rh_range(lp, i)-psdata->epsvalue > valueEQ)) {
-              report(lp, NORMAL, "presolve_sparser: Infeasibility of relatively equal RHS values for %d and %d\n",
-                                 i, ii);
-              status = presolve_setstatus(psdata, INFEASIBLE);
-              goto Finish;
-            }
-            presolve_rowremove(psdata, i, TRUE);
-            MEMCOPY(&QS[ib-1], &QS[ib], n-ib);
-            n--;
-            iConRemove++;
-          }
+        /* Keep the coefficients of the integer columns integral */
+        for(m = 1; m <= n; m++) {
+          value = lambda*eqvalue[m];
+          if(is_int(lp, eqcols[m]) && (fabs(value-floor(value+0.5)) > lp->epsint))
+            break;
         }
 
-        /* Otherwise zero-out the target constraint coefficients and update the RHS */
-        else {
-          for(k = 1; k <= nzidx[0]; k++) {
-            /* We should add recovery data for the zero'ed coefficient here */
-            jjx = nzidx[k];
-            jx = ROW_MAT_COLNR(jjx);
-            valptr = &ROW_MAT_VALUE(jjx);
-            value  = *valptr;
-            *valptr = 0.0;
-            /* Update counts */
-            value = my_chsign(chsign, value);
-            if(value < 0) {
-              psdata->rows->negcount[i]--;
-              psdata->cols->negcount[jx]--;
+        /* Update the target unless it is a parallel row */
+        if((m > n) && ((i == 0) || (count < n) || (nz > n))) {
+          presolve_adjustrhs(psdata, i, lambda*lp->orig_rhs[e], psdata->epsvalue);
+          for(m = 1; m <= n; m++) {
+            k = eqcols[m];
+            valptr = (i == 0 ? &lp->orig_obj[k] : &ROW_MAT_VALUE(rowindex[k]));
+            if(fabs(*valptr / eqvalue[m] - lambda) <= psdata->epsvalue) {
+              *valptr = 0;
+              iCoeffChanged++;
             }
-            else {
-              psdata->rows->plucount[i]--;
-              psdata->cols->plucount[jx]--;
-            }
-            iCoeffChanged++;
+            else
+              *valptr -= lambda*eqvalue[m];
           }
-          value = ratio * lp->orig_rhs[ii];
-          presolve_adjustrhs(psdata, i, value, psdata->epsvalue);
+          if(i > 0)
+            mat->row_copy_valid = FALSE;
         }
       }
 
+      /* Clear the scattered target row */
+      if(i > 0) {
+        k = 0;
+        for(m = presolve_nextcol(psdata, i, &k); m >= 0; m = presolve_nextcol(psdata, i, &k))
+          rowvalue[ROW_MAT_COLNR(m)] = 0;
+      }
     }
-    /* Get next equality index */
-NextEQ:
-    ix = nextActiveLink(EQlist, ix);
   }
 
-Finish:
-  FREE(QS);
-  freeLink(&EQlist);
-  FREE(nzidx);
-
   /* Let us condense the matrix if we modified the constraint matrix */
   if(iCoeffChanged > 0) {
     mat->row_end_valid = FALSE;
@@ -4750,9 +4787,67 @@ Finish:
     psdata->forceupdate = TRUE;
   }
 
-  (*nConRemove)    += iConRemove;
-  (*nCoeffChanged) += iCoeffChanged + iObjChanged;
-  (*nSum)          += iCoeffChanged + iObjChanged + iConRemove;
+Finish:
+  FREE(eqcols);
+  FREE(rowindex);
+  FREE(targets);
+  FREE(eqvalue);
+  FREE(ratio);
+  FREE(rowvalue);
+
+  (*nCoeffChanged) += iCoeffChanged;
+  (*nSum)          += iCoeffChanged;
+
+  return( status );
+}
+
+STATIC int presolve_propagate(presolverec *psdata, MYBOOL probe, int *nBoundTighten, int *nSum)
+/* Propagate the bounds of the integer columns over the active rows until no
+   more bounds can be tightened, using the same engine as the B&B nodes; the
+   binary columns are optionally probed for fixings as well */
+{
+  lprec        *lp = psdata->lp;
+  propagaterec *prop = NULL;
+  int          j, jx, n, iBoundTighten = 0, status = RUNNING;
+  REAL         *lowbo = NULL, *upbo = NULL;
+
+  if(!allocREAL(lp, &lowbo, lp->sum+1, FALSE) ||
+     !allocREAL(lp, &upbo, lp->sum+1, FALSE))
+    goto Finish;
+  MEMCOPY(lowbo, lp->orig_lowbo, lp->sum+1);
+  MEMCOPY(upbo,  lp->orig_upbo,  lp->sum+1);
+  prop = create_propagate(lp, lowbo, upbo, psdata->rows->varmap, psdata->cols->varmap);
+  if(prop == NULL)
+    goto Finish;
+
+  /* Apply the tightened bounds through the regular presolve bookkeeping */
+  status = propagate_run(prop, lowbo, upbo, NULL, NULL);
+  n = prop->tightened;
+  if(probe && (status == RUNNING)) {
+    status = propagate_probe(prop, lowbo, upbo, NULL, NULL, FALSE, PROPAGATE_PROBETIME);
+    n += prop->tightened;
+  }
+  if(status == INFEASIBLE)
+    status = presolve_setstatus(psdata, INFEASIBLE);
+  else if(n > 0) {
+    for(j = firstActiveLink(psdata->cols->varmap); j != 0; j = nextActiveLink(psdata->cols->varmap, j)) {
+      jx = lp->rows + j;
+      if((lowbo[jx] == lp->orig_lowbo[jx]) && (upbo[jx] == lp->orig_upbo[jx]))
+        continue;
+      if(!presolve_coltighten(psdata, j, lowbo[jx], upbo[jx], &iBoundTighten)) {
+        status = presolve_setstatus(psdata, INFEASIBLE);
+        break;
+      }
+    }
+  }
+
+Finish:
+  free_propagate(&prop);
+  FREE(lowbo);
+  FREE(upbo);
+
+  (*nBoundTighten) += iBoundTighten;
+  (*nSum)          += iBoundTighten;
 
   return( status );
 }
@@ -4860,26 +4955,142 @@ STATIC int presolve_boundconflict(presolverec *psdata, int baserowno, int colno)
   return( status );
 }
 
+/* Read-only test of whether presolve_rows can reduce the row; the tests must
+   cover every case handled there, and it may not report or change any state,
+   since it is called from several threads at once */
+STATIC MYBOOL presolve_rowcandidate(presolverec *psdata, int rownr)
+{
+  lprec *lp = psdata->lp;
+  REAL  losum, upsum, lorhs, uprhs, epsvalue = psdata->epsvalue;
+
+  /* Empty rows and singletons */
+  if(presolve_rowlengthex(psdata, rownr) <= 1)
+    return( TRUE );
+
+  /* Infeasible rows, as tested by presolve_rowfeasible */
+  presolve_range(lp, rownr, psdata->rows, &losum, &upsum);
+  lorhs = get_rh_lower(lp, rownr);
+  uprhs = get_rh_upper(lp, rownr);
+  if(!psdata->forceupdate &&
+     ((upsum < lorhs-lp->epssolution) || (losum > uprhs+lp->epssolution)))
+    return( TRUE );
+
+  /* Rows that fix all their variables at zero */
+  if((fabs(lp->orig_rhs[rownr]) < epsvalue) &&
+     ((psdata->rows->plucount[rownr] == 0) || (psdata->rows->negcount[rownr] == 0)) &&
+     (psdata->rows->pluneg[rownr] == 0) &&
+     (is_constr_type(lp, rownr, EQ)
+#ifdef FindImpliedEqualities
+      || (fabs(lorhs-upsum) < epsvalue) || (fabs(uprhs-losum) < epsvalue)
+#endif
+     ))
+    return( TRUE );
+
+  /* Forcing and redundant rows */
+  return( (MYBOOL) ((losum >= lorhs-epsvalue) && (upsum <= uprhs+epsvalue)) );
+}
+
+/* Read-only test of whether presolve_columns can eliminate the column; the
+   same restrictions as for presolve_rowcandidate apply */
+STATIC MYBOOL presolve_colcandidate(presolverec *psdata, int colnr)
+{
+  lprec *lp = psdata->lp;
+  MATrec *mat = lp->matA;
+  int   ix, item, status = RUNNING;
+  REAL  fixvalue;
+
+  if(SOS_is_member(lp->SOS, 0, colnr))
+    return( FALSE );
+
+  /* Empty and fixed columns, and semi-continuous columns to be cleared */
+  if((presolve_collength(psdata, colnr) == 0) || isOrigFixed(lp, lp->rows + colnr) ||
+     ((lp->sc_vars > 0) && (get_lowbo(lp, colnr) == 0) && is_semicont(lp, colnr)))
+    return( TRUE );
+
+  /* Probing may set the presolve status, so it is always done serially */
+  if(is_presolve(lp, PRESOLVE_PROBEFIX) && is_binary(lp, colnr))
+    return( TRUE );
+
+  /* Fixing by the dual; singleton rows can report infeasibility and are also
+     left to the serial pass */
+  if(is_presolve(lp, PRESOLVE_COLFIXDUAL)) {
+    item = 0;
+    for(ix = presolve_nextrow(psdata, colnr, &item); ix >= 0; ix = presolve_nextrow(psdata, colnr, &item))
+      if(presolve_rowlength(psdata, COL_MAT_ROWNR(ix)) == 1)
+        return( TRUE );
+    return( presolve_colfixdual(psdata, colnr, &fixvalue, &status) );
+  }
+
+  return( FALSE );
+}
+
+typedef struct _presolvescan
+{
+  presolverec *psdata;
+  int         *list;
+  MYBOOL      *candidate;
+  MYBOOL      isrow;
+} presolvescan;
+
+STATIC void presolve_scanthread(void *data, int threadnr, int threadcount)
+{
+  presolvescan *rec = (presolvescan *) data;
+  int          i, lo, hi;
+
+  thread_partition(threadnr, threadcount, 1, rec->list[0], &lo, &hi);
+  for(i = lo; i <= hi; i++) {
+    if(rec->isrow)
+      rec->candidate[i] = presolve_rowcandidate(rec->psdata, rec->list[i]);
+    else
+      rec->candidate[i] = presolve_colcandidate(rec->psdata, rec->list[i]);
+  }
+}
+
+/* Flag the items in the work list that the serial pass should process; long
+   lists are split over several threads.  The flags do not depend on the
+   number of threads, and items changed by the serial pass are queued again. */
+STATIC void presolve_scan(presolverec *psdata, int *list, MYBOOL *candidate, MYBOOL isrow)
+{
+  presolvescan rec;
+  int          threads = 1;
+
+  if(list[0] >= MIN_PSPARALLELSCAN)
+    threads = MIN(psdata->lp->num_threads, list[0] / (MIN_PSPARALLELSCAN / 2));
+  rec.psdata    = psdata;
+  rec.list      = list;
+  rec.candidate = candidate;
+  rec.isrow     = isrow;
+  thread_run(threads, presolve_scanthread, &rec);
+}
+
 STATIC int presolve_columns(presolverec *psdata, int *nCoeffChanged, int *nConRemove, int *nVarFixed, int *nBoundTighten, int *nSum)
 {
   lprec    *lp = psdata->lp;
-  MYBOOL   candelete, isOFNZ, unbounded,
+  MYBOOL   candelete, isOFNZ, unbounded, *candidate = NULL,
            probefix = is_presolve(lp, PRESOLVE_PROBEFIX),
 #if 0
            probereduce = is_presolve(lp, PRESOLVE_PROBEREDUCE),
 #endif
            colfixdual = is_presolve(lp, PRESOLVE_COLFIXDUAL);
   int      iCoeffChanged = 0, iConRemove = 0, iVarFixed = 0, iBoundTighten = 0,
-           status = RUNNING, ix, j, countNZ, item;
+           status = RUNNING, ix, j, jj, countNZ, item, *list = NULL;
   REAL     Value1;
 
-  for(j = firstActiveLink(psdata->cols->varmap); (j != 0) && (status == RUNNING); ) {
+  /* Only revisit the columns that were queued since the previous pass */
+  if(!allocINT(lp, &list, lp->columns+1, FALSE) ||
+     !allocMYBOOL(lp, &candidate, lp->columns+1, FALSE))
+    goto Finish;
+  presolve_takedirty(psdata->cols, list, FALSE);
+  presolve_scan(psdata, list, candidate, FALSE);
+
+  for(jj = 1; (jj <= list[0]) && (status == RUNNING); jj++) {
+    j = list[jj];
+    if(!candidate[jj] || !isActiveLink(psdata->cols->varmap, j))
+      continue;
 
     /* Don't presolve members SOS'es */
-    if(SOS_is_member(lp->SOS, 0, j)) {
-      j = nextActiveLink(psdata->cols->varmap, j);
+    if(SOS_is_member(lp->SOS, 0, j))
       continue;
-    }
 
     /* Initialize */
     countNZ = presolve_collength(psdata, j);
@@ -5014,17 +5225,19 @@ STATIC int presolve_columns(presolverec *psdata, int *nCoeffChanged, int *nConRe
           status = presolve_setstatus(psdata, INFEASIBLE);
           break;
         }
-        j = presolve_colremove(psdata, j, TRUE);
+        presolve_colremove(psdata, j, TRUE);
       }
     }
-    else
-      j = nextActiveLink(psdata->cols->varmap, j);
   }
 
   /* Remove any "hanging" empty row and columns */
   if(status == RUNNING)
     status = presolve_shrink(psdata, &iConRemove, &iVarFixed);
 
+Finish:
+  FREE(list);
+  FREE(candidate);
+
   (*nCoeffChanged) += iCoeffChanged;
   (*nConRemove)    += iConRemove;
   (*nVarFixed)     += iVarFixed;
@@ -5242,13 +5455,23 @@ STATIC int presolve_preparerows(presolverec *psdata, int *nBoundTighten, int *nS
 STATIC int presolve_rows(presolverec *psdata, int *nCoeffChanged, int *nConRemove, int *nVarFixed, int *nBoundTighten, int *nSum)
 {
   lprec    *lp = psdata->lp;
-  MYBOOL   candelete;
+  MYBOOL   candelete, *candidate = NULL;
   int      iCoeffChanged = 0, iConRemove = 0, iVarFixed = 0, iBoundTighten = 0,
-           status = RUNNING, i,ix, j,jx, item;
+           status = RUNNING, i,ii, j,jx, item, *list = NULL;
   REAL     Value1, Value2, losum, upsum, lorhs, uprhs, epsvalue = psdata->epsvalue;
   MATrec   *mat = lp->matA;
 
-  for(i = lastActiveLink(psdata->rows->varmap); (i > 0) && (status == RUNNING); ) {
+  /* Only revisit the rows that were queued since the previous pass */
+  if(!allocINT(lp, &list, lp->rows+1, FALSE) ||
+     !allocMYBOOL(lp, &candidate, lp->rows+1, FALSE))
+    goto Finish;
+  presolve_takedirty(psdata->rows, list, TRUE);
+  presolve_scan(psdata, list, candidate, TRUE);
+
+  for(ii = 1; (ii <= list[0]) && (status == RUNNING); ii++) {
+    i = list[ii];
+    if(!candidate[ii] || !isActiveLink(psdata->rows->varmap, i))
+      continue;
 
     candelete = FALSE;
 
@@ -5292,12 +5515,11 @@ STATIC int presolve_rows(presolverec *psdata, int *nCoeffChanged, int *nConRemov
       if(presolve_collength(psdata, j) > 1)
         status = presolve_boundconflict(psdata, i, j);
       else if(is_constr_type(lp, i, EQ)) {
-        Value2 = ROW_MAT_VALUE(jx);
-        Value1 = lp->orig_rhs[i] / Value2;
-        if(Value2 < 0)
-          swapREAL(&losum, &upsum);
-        if((Value1 < losum / my_if(my_infinite(lp, losum), my_sign(Value2), Value2) - epsvalue) ||
-           (Value1 > upsum / my_if(my_infinite(lp, upsum), my_sign(Value2), Value2) + epsvalue))
+        /* Test the implied value against the bounds of the column itself; the
+           activity bounds of the row may lag behind recent coefficient changes */
+        Value1 = lp->orig_rhs[i] / ROW_MAT_VALUE(jx);
+        if((Value1 < get_lowbo(lp, j) - epsvalue) || (Value1 > get_upbo(lp, j) + epsvalue) ||
+           (is_int(lp, j) && (fabs(Value1-floor(Value1+0.5)) > lp->epsint)))
           status = presolve_setstatus(psdata, INFEASIBLE);
         Value2 = Value1;
       }
@@ -5383,11 +5605,9 @@ STATIC int presolve_rows(presolverec *psdata, int *nCoeffChanged, int *nConRemov
       candelete = TRUE;
     }
 
-    /* Get next row and do the deletion of the previous, if indicated */
-    ix = i;
-    i = prevActiveLink(psdata->rows->varmap, i);
+    /* Do the deletion of the row, if indicated */
     if(candelete) {
-      presolve_rowremove(psdata, ix, TRUE);
+      presolve_rowremove(psdata, i, TRUE);
       iConRemove++;
     }
   }
@@ -5396,6 +5616,10 @@ STATIC int presolve_rows(presolverec *psdata, int *nCoeffChanged, int *nConRemov
   if(status == RUNNING)
     status = presolve_shrink(psdata, &iConRemove, &iVarFixed);
 
+Finish:
+  FREE(list);
+  FREE(candidate);
+
   (*nCoeffChanged) += iCoeffChanged;
   (*nConRemove)    += iConRemove;
   (*nVarFixed)     += iVarFixed;
@@ -5411,7 +5635,8 @@ STATIC int presolve(lprec *lp)
   int    status = RUNNING,
          i, j = 0, jx = 0, jjx = 0, k, oSum,
          iCoeffChanged = 0, iConRemove = 0, iVarFixed = 0, iBoundTighten = 0, iSOS = 0, iSum = 0,
-         nCoeffChanged = 0, nConRemove = 0, nVarFixed = 0, nBoundTighten = 0, nSOS = 0, nSum = 0;
+         nCoeffChanged = 0, nConRemove = 0, nVarFixed = 0, nBoundTighten = 0, nSOS = 0, nSum = 0,
+         nNonZeros;
   REAL   Value1, Value2, initrhs0 = lp->orig_rhs[0];
   presolverec *psdata = NULL;
   MATrec *mat = lp->matA;
@@ -5521,6 +5746,7 @@ write_lp(lp, "test_in.lp");    /* Write to lp-formatted file for debugging */
 
     /* Create and initialize the presolve data structures */
     psdata = presolve_init(lp);
+    nNonZeros = mat_nonzeros(mat);
 
     /* Reentry point for the outermost, computationally expensive presolve loop */
     psdata->outerloops = 0;
@@ -5561,7 +5787,10 @@ write_lp(lp, "test_in.lp");    /* Write to lp-formatted file for debugging */
         if(status != RUNNING)
           break;
 
-        /* Do the relatively cheap innermost elimination loop */
+        /* Do the relatively cheap innermost elimination loop; the first pass
+          visits everything, the following passes only what was changed */
+        presolve_markall(psdata->rows);
+        presolve_markall(psdata->cols);
         do {
 
           psdata->innerloops++;
@@ -5587,6 +5816,14 @@ write_lp(lp, "test_in.lp");    /* Write to lp-formatted file for debugging */
         if(status != RUNNING)
           break;
 
+        /* Propagate integer bounds to a fixpoint, and probe the binaries once */
+        if(presolve_statuscheck(psdata, &status) && (lp->int_vars > 0)) {
+          MYBOOL probe = (MYBOOL) ((psdata->outerloops == 1) && (psdata->middleloops == 1) &&
+                                   is_presolve(lp, PRESOLVE_PROBEFIX));
+          if(probe || is_presolve(lp, PRESOLVE_BOUNDS))
+            status = presolve_propagate(psdata, probe, &iBoundTighten, &iSum);
+        }
+
         /* Merge compatible similar rows; loop backwards over every row */
         if(presolve_statuscheck(psdata, &status) &&
            (psdata->outerloops == 1) && (psdata->middleloops <= MAX_PSMERGELOOPS) &&
@@ -5608,10 +5845,10 @@ write_lp(lp, "test_in.lp");    /* Write to lp-formatted file for debugging */
            is_presolve(lp, PRESOLVE_COLDOMINATE))
           presolve_coldominance01(psdata, &iConRemove, &iVarFixed, &iSum);
 
-        /* Aggregate compatible columns */
-        if(presolve_statuscheck(psdata, &status) && /*TRUE ||*/
-           is_presolve(lp, PRESOLVE_AGGREGATE))
-          presolve_aggregate(psdata, &iConRemove, &iVarFixed, &iSum);
+        /* Eliminate dominated duplicate columns */
+        if(presolve_statuscheck(psdata, &status) &&
+           is_presolve(lp, PRESOLVE_COLDOMINATE))
+          status = presolve_duplicatecols(psdata, &iVarFixed, &iSum);
 
         /* Eliminate free variables and implied slacks */
         if(presolve_statuscheck(psdata, &status) &&
@@ -5632,6 +5869,11 @@ write_lp(lp, "test_in.lp");    /* Write to lp-formatted file for debugging */
         presolve_singularities(psdata, &iCoeffChanged, &iConRemove, &iVarFixed, &iSum);
       }
 
+      /* Substitute implied free variables out of short equalities */
+      if(presolve_statuscheck(psdata, &status) && (psdata->EQmap->count > 0) &&
+         is_presolve(lp, PRESOLVE_AGGREGATE))
+        status = presolve_aggregate(psdata, &iCoeffChanged, &iConRemove, &iVarFixed, &iSum);
+
       /* Eliminate variable and tighten bounds using 2-element EQs;
         note that this involves modifying the coefficients of A and
         can therefore be a slow operation. */
@@ -5716,11 +5958,17 @@ write_lp(lp, "test_in.lp");    /* Write to lp-formatted file for debugging */
 
    /* Report summary information */
     i = NORMAL;
-    iVarFixed  = lp->presolve_undo->orig_columns - psdata->cols->varmap->count;
-    iConRemove = lp->presolve_undo->orig_rows - psdata->rows->varmap->count;
+    iVarFixed  = lp->presolve_undo->orig_columns - lp->columns;
+    iConRemove = lp->presolve_undo->orig_rows - lp->rows;
+    k = nNonZeros - mat_nonzeros(mat);
     if(nSum > 0)
       report(lp, i, "PRESOLVE             Elimination loops performed.......... O%d:M%d:I%d\n",
                                   psdata->outerloops, psdata->middleloops, psdata->innerloops);
+    if(iConRemove+iVarFixed+k > 0)
+      report(lp, i, "PRESOLVE             Model reduced by %d rows (%.1f%%), %d columns (%.1f%%) and %d non-zeros (%.1f%%)\n",
+                    iConRemove, 100.0*iConRemove/MAX(1, lp->presolve_undo->orig_rows),
+                    iVarFixed,  100.0*iVarFixed/MAX(1, lp->presolve_undo->orig_columns),
+                    k,          100.0*k/MAX(1, nNonZeros));
     if(nVarFixed)
       report(lp, i, "            %8d empty or fixed variables............. %s.\n", nVarFixed, "REMOVED");
     if(nConRemove)
@@ -5733,6 +5981,16 @@ write_lp(lp, "test_in.lp");    /* Write to lp-formatted file for debugging */
       report(lp, i, "            %8d variables' final bounds.............. %s.\n", jjx, "RELAXED");
     if(nSOS)
       report(lp, i, "            %8d constraints detected as SOS1......... %s.\n", nSOS, "CONVERTED");
+    k = countsUndoLog(lp->presolve_undo->primalundo) + countsUndoLog(lp->presolve_undo->dualundo);
+    if(k > 0) {
+      jx = 0;
+      if(lp->presolve_undo->primalundo != NULL)
+        jx += lp->presolve_undo->primalundo->items;
+      if(lp->presolve_undo->dualundo != NULL)
+        jx += lp->presolve_undo->dualundo->items;
+      report(lp, i, "            %8d postsolve undo records (%6.0f kB)... %s.\n", k,
+                    (double) jx * sizeof(undoitem) / 1024, "LOGGED");
+    }
 
     /* Report optimality or infeasibility */
     if(status == UNBOUNDED)
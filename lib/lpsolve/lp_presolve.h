@@ -12,6 +12,7 @@
 #define MAX_PSLINDEPLOOPS               1   /* Max loops to detect linearly dependendent constraints */
 #define MAX_PSBOUNDTIGHTENLOOPS         5     /* Maximumn number of loops to allow bound tightenings */
 #define MIN_SOS1LENGTH                  4   /* Minimum length of a constraint for conversion to SOS1 */
+#define MIN_PSPARALLELSCAN           8192    /* Minimum work list length for a multi-threaded scan */
 #if 1
   #define PRESOLVE_EPSVALUE (0.1*lp->epsprimal)
 #else
@@ -47,6 +48,8 @@ typedef struct _psrec
   REAL  *neglower;
   REAL  *pluupper;
   REAL  *negupper;
+  int  *dirty;
+  MYBOOL *isdirty;
   int  allocsize;
 } psrec;
 
@@ -5,6 +5,7 @@
 #include "lp_report.h"
 #include "lp_pricePSE.h"
 #include "lp_price.h"
+#include "mythread.h"
 
 #if libBLAS > 0
   #include "myblas.h"
@@ -657,6 +658,292 @@ STATIC void makePriceLoop(lprec *lp, int *start, int *end, int *delta)
   }
 }
 
+/* Vectorized scoring of pricing candidates.  The candidates that pass the
+   attractiveness test are gathered with their edge weights into contiguous
+   arrays and normalized in one pass with the widest instruction set that
+   is available.  Square root and division are correctly rounded in all of
+   them, so the scores are identical to those of normalizeEdge.  The scalar
+   pass that follows keeps the scan order and the comparison operators, and
+   only skips candidates that compareImprovementVar would surely reject. */
+#if ((defined __GNUC__ && __GNUC__ >= 5) || (defined __clang__)) && \
+    ((defined __x86_64__) || (defined __i386__)) && !(defined NoPriceSIMD)
+  #define PriceSIMD
+  #include <immintrin.h>
+  #include "myblas.h"
+#endif
+
+STATIC void priceNormalize_c(int n, REAL *f, REAL *w, REAL epsvalue)
+{
+  int i;
+
+  for(i = 0; i < n; i++)
+    w[i] = (fabs(f[i]) > epsvalue ? f[i] / sqrt(w[i]) : f[i]);
+}
+
+#ifdef PriceSIMD
+__attribute__((target("avx2")))
+STATIC void priceNormalize_avx2(int n, REAL *f, REAL *w, REAL epsvalue)
+{
+  int     i, n4 = n & ~3;
+  __m256d fv, qv, eps = _mm256_set1_pd(epsvalue),
+          absmask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+
+  for(i = 0; i < n4; i += 4) {
+    fv = _mm256_loadu_pd(f+i);
+    qv = _mm256_div_pd(fv, _mm256_sqrt_pd(_mm256_loadu_pd(w+i)));
+    _mm256_storeu_pd(w+i, _mm256_blendv_pd(fv, qv,
+                          _mm256_cmp_pd(_mm256_and_pd(fv, absmask), eps, _CMP_GT_OQ)));
+  }
+  priceNormalize_c(n-i, f+i, w+i, epsvalue);
+}
+#endif
+
+/* Pick the kernel for the instruction sets that init_BLAS detected in make_lp */
+STATIC priceNormalize_func *priceNormalize(void)
+{
+#ifdef PriceSIMD
+  if(simd_levelBLAS() >= BLAS_SIMD_AVX2)
+    return( priceNormalize_avx2 );
+#endif
+  return( priceNormalize_c );
+}
+
+/* Check if a scan can use the vectorized path; it does not apply when the
+   scan must stop early or when the comparisons have side effects */
+STATIC MYBOOL priceVectorized(lprec *lp, MYBOOL collectMP, int count)
+{
+  return( (MYBOOL) ((count >= PRICE_VECTORMIN) && !collectMP && (lp->multivars == NULL) &&
+                    (lp->rejectpivot[0] == 0) && (get_piv_rule(lp) != PRICER_FIRSTINDEX) &&
+                    ((lp->piv_strategy & PRICE_RANDOMIZE) == 0)) );
+}
+
+/* Convert the n gathered candidate values f of the variables/rows in index
+   to normalized scores in w, with the same result as normalizeEdge */
+STATIC void priceScores(lprec *lp, int n, int *index, REAL *f, REAL *w, MYBOOL isdual)
+{
+  int    k, i;
+  int    rule = get_piv_rule(lp);
+  MYBOOL usenorms = (MYBOOL) ((rule == PRICER_DEVEX) || (rule == PRICER_STEEPESTEDGE));
+
+  usenorms = (MYBOOL) (usenorms && (lp->edgeVector[0] >= 0) && (lp->edgeVector[0] == isdual));
+  for(k = 0; k < n; k++) {
+    if(!usenorms) {
+      w[k] = 1;
+      continue;
+    }
+    i = index[k];
+    if(isdual)
+      i = lp->var_basic[i];
+    w[k] = lp->edgeVector[i];
+    /* Let getPricer report and substitute zero norms */
+    if(w[k] == 0)
+      w[k] = (fabs(f[k]) > lp->epssolution ? getPricer(lp, index[k], isdual) : 1);
+  }
+  priceNormalize()(n, f, w, lp->epssolution);
+}
+
+/* Scan the scored primal candidates lo..hi in the direction set by makePriceLoop */
+STATIC void colprimScan(lprec *lp, int lo, int hi, int *index, REAL *fv, REAL *wv, pricerec *current,
+                        int *candidatecount, int *ninfeas, REAL *xinfeas, REAL *sinfeas)
+{
+  int      ix, iz;
+  REAL     f, bound = 0;
+  pricerec candidate;
+
+  candidate.lp     = lp;
+  candidate.isdual = FALSE;
+  if(lp->_piv_left_) {
+    swapINT(&lo, &hi);
+    iz = -1;
+  }
+  else
+    iz = 1;
+  hi *= iz;
+  for(ix = lo; ix*iz <= hi; ix += iz) {
+    f = fv[ix];
+    (*ninfeas)++;
+    SETMAX(*xinfeas, f);
+    (*sinfeas) += f;
+    if((current->varno > 0) && (wv[ix] < bound)) {
+      if(fabs(wv[ix]) > lp->epsvalue)
+        (*candidatecount)++;
+      continue;
+    }
+    candidate.pivot = wv[ix];
+    candidate.varno = index[ix];
+    findImprovementVar(current, &candidate, FALSE, candidatecount);
+    if(current->varno == candidate.varno)
+      bound = current->pivot - 2*lp->epsvalue*(1+fabs(current->pivot));
+  }
+}
+
+/* Thread-local result of one segment in parallel pricing */
+typedef struct _pricesegment
+{
+  pricerec best;
+  int      candidatecount, ninfeas;
+  REAL     xinfeas, sinfeas;
+} pricesegment;
+
+/* Shared record of a parallel pricing scan */
+typedef struct _priceparallel
+{
+  lprec        *lp;
+  int          n, *index;
+  REAL         *fv, *wv;
+  int          segcount;
+  pricesegment *segment;
+} priceparallel;
+
+/* Worker that scores and scans one contiguous range of segments */
+STATIC void colprimSegments(void *data, int threadnr, int threadcount)
+{
+  priceparallel *rec = (priceparallel *) data;
+  pricesegment  *seg;
+  int           s, lo, hi, first, last;
+
+  thread_partition(threadnr, threadcount, 0, rec->segcount-1, &lo, &hi);
+  for(s = lo; s <= hi; s++) {
+    seg = rec->segment + s;
+    first = s*PRICE_PARALLELBLOCK;
+    last  = MIN(first+PRICE_PARALLELBLOCK, rec->n)-1;
+    priceScores(rec->lp, last-first+1, rec->index+first, rec->fv+first, rec->wv+first, FALSE);
+    seg->best.pivot  = rec->lp->epsprimal;
+    seg->best.theta  = 0;
+    seg->best.varno  = 0;
+    seg->best.lp     = rec->lp;
+    seg->best.isdual = FALSE;
+    seg->candidatecount = 0;
+    seg->ninfeas = 0;
+    seg->xinfeas = 0;
+    seg->sinfeas = 0;
+    colprimScan(rec->lp, first, last, rec->index, rec->fv, rec->wv, &seg->best,
+                &seg->candidatecount, &seg->ninfeas, &seg->xinfeas, &seg->sinfeas);
+  }
+}
+
+/* Vectorized version of the candidate loop in colprim.  With PRICE_PARALLEL
+   the candidates are split in segments of fixed size, each of which gets its
+   own best candidate; these are then reduced in scan order.  The segments do
+   not depend on the thread count, so neither does the selected variable. */
+STATIC void colprimVector(lprec *lp, REAL *drow, int *nzdrow, REAL epsvalue, pricerec *current,
+                          int *candidatecount, int *ninfeas, REAL *xinfeas, REAL *sinfeas)
+{
+  int           i, ix, iy, iz, n = 0, *index, threads;
+  REAL          f, *fv, *wv;
+  priceparallel rec;
+
+  iy = nzdrow[0];
+  index = (int *) mempool_obtainVector(lp->workarrays, iy, sizeof(*index));
+  fv = (REAL *) mempool_obtainVector(lp->workarrays, iy, sizeof(*fv));
+  wv = (REAL *) mempool_obtainVector(lp->workarrays, iy, sizeof(*wv));
+  for(ix = 1; ix <= iy; ix++) {
+    i = nzdrow[ix];
+    f = my_chsign(lp->is_lower[i], drow[i]);
+    if(f <= epsvalue)
+      continue;
+    index[n] = i;
+    fv[n] = f;
+    n++;
+  }
+
+  /* Set the scan direction */
+  ix = 0;
+  iy = n-1;
+  makePriceLoop(lp, &ix, &iy, &iz);
+
+  if(!is_piv_mode(lp, PRICE_PARALLEL) || (n <= PRICE_PARALLELBLOCK)) {
+    priceScores(lp, n, index, fv, wv, FALSE);
+    colprimScan(lp, 0, n-1, index, fv, wv, current, candidatecount, ninfeas, xinfeas, sinfeas);
+  }
+  else {
+    rec.lp       = lp;
+    rec.n        = n;
+    rec.index    = index;
+    rec.fv       = fv;
+    rec.wv       = wv;
+    rec.segcount = (n-1) / PRICE_PARALLELBLOCK + 1;
+    rec.segment  = (pricesegment *) mempool_obtainVector(lp->workarrays, rec.segcount, sizeof(*rec.segment));
+    threads = (n < PRICE_PARALLELMIN ? 1 : MIN(lp->num_threads, rec.segcount));
+    thread_run(threads, colprimSegments, &rec);
+
+    /* Reduce the segment results in scan order */
+    ix = 0;
+    iy = rec.segcount-1;
+    if(lp->_piv_left_)
+      swapINT(&ix, &iy);
+    iy *= iz;
+    for(; ix*iz <= iy; ix += iz) {
+      (*candidatecount) += rec.segment[ix].candidatecount;
+      (*ninfeas) += rec.segment[ix].ninfeas;
+      SETMAX(*xinfeas, rec.segment[ix].xinfeas);
+      (*sinfeas) += rec.segment[ix].sinfeas;
+      if(rec.segment[ix].best.varno > 0)
+        findImprovementVar(current, &rec.segment[ix].best, FALSE, NULL);
+    }
+    mempool_releaseVector(lp->workarrays, (char *) rec.segment, FALSE);
+  }
+
+  mempool_releaseVector(lp->workarrays, (char *) wv, FALSE);
+  mempool_releaseVector(lp->workarrays, (char *) fv, FALSE);
+  mempool_releaseVector(lp->workarrays, (char *) index, FALSE);
+}
+
+/* Vectorized version of the candidate loop in rowdual; forceoutEQ must not be TRUE */
+STATIC void rowdualVector(lprec *lp, REAL *rhvec, int k, int iy, MYBOOL forceoutEQ, pricerec *current,
+                          int *ninfeas, REAL *xinfeas, REAL *sinfeas)
+{
+  int      i, ii, iz, n = 0, *index;
+  REAL     rh, up, epsvalue = lp->epsdual, *rv, *fv, *wv, bound = 0;
+  pricerec candidate;
+
+  candidate.lp     = lp;
+  candidate.isdual = TRUE;
+  index = (int *) mempool_obtainVector(lp->workarrays, iy-k+1, sizeof(*index));
+  rv = (REAL *) mempool_obtainVector(lp->workarrays, iy-k+1, sizeof(*rv));
+  fv = (REAL *) mempool_obtainVector(lp->workarrays, iy-k+1, sizeof(*fv));
+  wv = (REAL *) mempool_obtainVector(lp->workarrays, iy-k+1, sizeof(*wv));
+  for(i = k; i <= iy; i++) {
+    ii = lp->var_basic[i];
+    up = lp->upbo[ii];
+    rh = rhvec[i];
+    if(rh > up)
+      rh = up - rh;
+    if(!(rh < -epsvalue))
+      continue;
+    index[n] = i;
+    rv[n] = rh;
+    if(up < epsvalue)
+      rh *= (forceoutEQ == AUTOMATIC ? 10.0 : 1.0+lp->epspivot);
+    fv[n] = rh;
+    n++;
+  }
+  priceScores(lp, n, index, fv, wv, TRUE);
+
+  k = 0;
+  iy = n-1;
+  makePriceLoop(lp, &k, &iy, &iz);
+  iy *= iz;
+  for(; k*iz <= iy; k += iz) {
+    rh = rv[k];
+    (*ninfeas)++;
+    SETMIN(*xinfeas, rh);
+    (*sinfeas) += rh;
+    if((current->varno > 0) && (wv[k] > bound))
+      continue;
+    candidate.pivot = wv[k];
+    candidate.varno = index[k];
+    findImprovementVar(current, &candidate, FALSE, NULL);
+    if(current->varno == candidate.varno)
+      bound = current->pivot + 2*lp->epsvalue*(1+fabs(current->pivot));
+  }
+
+  mempool_releaseVector(lp->workarrays, (char *) wv, FALSE);
+  mempool_releaseVector(lp->workarrays, (char *) fv, FALSE);
+  mempool_releaseVector(lp->workarrays, (char *) rv, FALSE);
+  mempool_releaseVector(lp->workarrays, (char *) index, FALSE);
+}
+
 /* Routine to verify accuracy of the current basis factorization */
 STATIC MYBOOL serious_facterror(lprec *lp, REAL *bvector, int maxcols, REAL tolerance)
 {
@@ -882,7 +1169,13 @@ doLoop:
   ninfeas = 0;
   xinfeas = 0;
   sinfeas = 0;
-  makePriceLoop(lp, &ix, &iy, &iz);
+  if(priceVectorized(lp, collectMP, iy)) {
+    colprimVector(lp, drow, nzdrow, epsvalue, &current, candidatecount, &ninfeas, &xinfeas, &sinfeas);
+    iy = 0;   /* Nothing left for the loop below */
+    iz = 1;
+  }
+  else
+    makePriceLoop(lp, &ix, &iy, &iz);
   iy *= iz;
   for(; ix*iz <= iy; ix += iz) {
     i = nzdrow[ix];
@@ -1198,7 +1491,14 @@ STATIC int rowdual(lprec *lp, REAL *rhvec, MYBOOL forceoutEQ, MYBOOL updateinfea
   ninfeas = 0;
   xinfeas = 0;
   sinfeas = 0;
-  makePriceLoop(lp, &k, &iy, &iz);
+  if((forceoutEQ != TRUE) && priceVectorized(lp, collectMP, iy-k+1)) {
+    rowdualVector(lp, rhvec, k, iy, forceoutEQ, &current, &ninfeas, &xinfeas, &sinfeas);
+    k  = 1;   /* Nothing left for the loop below */
+    iy = 0;
+    iz = 1;
+  }
+  else
+    makePriceLoop(lp, &k, &iy, &iz);
   iy *= iz;
   for(; k*iz <= iy; k += iz) {
 
@@ -1339,6 +1639,115 @@ STATIC void longdual_testset(lprec *lp, int which, int rownr, REAL *prow, int *n
 }
 
 
+/* Restore the heap order of the breakpoint ratios below position k */
+STATIC void longdual_siftdown(REAL *ratio, int *index, int n, int k)
+{
+  int  i, ii;
+  REAL hold = ratio[k];
+
+  ii = index[k];
+  for(i = 2*k+1; i < n; i = 2*k+1) {
+    if((i+1 < n) && (ratio[i+1] < ratio[i]))
+      i++;
+    if(hold <= ratio[i])
+      break;
+    ratio[k] = ratio[i];
+    index[k] = index[i];
+    k = i;
+  }
+  ratio[k] = hold;
+  index[k] = ii;
+}
+
+/* Bound-flipping ("long-step") dual ratio test for the dual phase 2; the
+   breakpoints of the dual objective along the leaving row are passed in
+   increasing order for as long as the slope remains positive, flipping the
+   bounded variables that are passed.  Near-tied breakpoints are grouped with
+   a Harris pass, and the largest pivot of the blocking group enters the basis.
+   The breakpoints are kept in a heap, so that only the ones actually passed
+   are ordered.  Returns the entering variable, or zero if no bound flip was
+   found, in which case the caller should use the regular ratio test.  If the
+   slope stays positive past the last breakpoint, the leaving row cannot be
+   made feasible and -1 is returned. */
+STATIC int longdual_ratiotest(lprec *lp, REAL *prow, int *nzprow, REAL *drow,
+                                         REAL viol, REAL epspivot, int *boundswaps)
+{
+  int    i, ix, n, nflip = 0, varnr = 0, *index;
+  REAL   w, slope, drop, bound, pivot, epsdual = lp->epsdual, *ratio;
+
+  boundswaps[0] = 0;
+  n = nzprow[0];
+  ratio = (REAL *) mempool_obtainVector(lp->workarrays, n, sizeof(*ratio));
+  index = (int *) mempool_obtainVector(lp->workarrays, n, sizeof(*index));
+
+  /* Compute the breakpoints; small negative ratios are due to the
+     dual feasibility tolerance and are taken to be zero */
+  for(ix = 0; ix < n; ix++) {
+    i = nzprow[ix+1];
+    w = my_chsign(!lp->is_lower[i], drow[i]);
+    ratio[ix] = MAX(0, w / fabs(prow[i]));
+    index[ix] = i;
+  }
+  for(ix = n/2-1; ix >= 0; ix--)
+    longdual_siftdown(ratio, index, n, ix);
+
+  /* Process groups of breakpoints until the slope turns non-positive; the
+     breakpoints taken off the heap are stored behind it, at [n, ix) */
+  slope = fabs(viol);
+  while(n > 0) {
+
+    /* Harris pass; find the largest relaxed step and the group it covers */
+    ix    = n;
+    bound = lp->infinite;
+    drop  = 0;
+    pivot = 0;
+    while((n > 0) && (ratio[0] <= bound)) {
+      i = index[0];
+      w = fabs(prow[i]);
+      SETMIN(bound, ratio[0] + epsdual / w);
+      if(w > pivot) {
+        pivot = w;
+        varnr = i;
+      }
+      if(lp->upbo[i] >= lp->infinite)
+        drop = lp->infinite;
+      else if(drop < lp->infinite)
+        drop += w * lp->upbo[i];
+      n--;
+      swapREAL(ratio, ratio+n);
+      swapINT(index, index+n);
+      longdual_siftdown(ratio, index, n, 0);
+    }
+
+    /* Stop at the group that blocks the step */
+    if((n == 0) || (drop >= slope))
+      break;
+
+    /* Otherwise flip the bounded variables of the group and move on */
+    slope -= drop;
+    for(ix--; ix >= n; ix--) {
+      i = index[ix];
+      if(lp->upbo[i] > lp->epsprimal) {
+        nflip++;
+        boundswaps[nflip] = i;
+      }
+    }
+  }
+
+  /* Detect an infeasible leaving row, otherwise only accept
+     a long step with an acceptable pivot */
+  if((n == 0) && (slope - drop > lp->epsprimal))
+    varnr = -1;
+  else if((nflip > 0) && (pivot >= epspivot))
+    boundswaps[0] = nflip;
+  else
+    varnr = 0;
+
+  mempool_releaseVector(lp->workarrays, (char *) index, FALSE);
+  mempool_releaseVector(lp->workarrays, (char *) ratio, FALSE);
+  return( varnr );
+}
+
 /* Find the dual simplex entering non-basic variable */
 STATIC int coldual(lprec *lp, int row_nr, REAL *prow, int *nzprow,
                                           REAL *drow, int *nzdrow,
@@ -1482,6 +1891,20 @@ STATIC int coldual(lprec *lp, int row_nr, REAL *prow, int *nzprow,
       dolongsteps = FALSE;
       lp->longsteps->indexSet[0] = 0;
     }
+    else if(dolongsteps == AUTOMATIC) {
+      dolongsteps = FALSE;
+      i = longdual_ratiotest(lp, prow, nzprow, drow, viol, epspivot, lp->longsteps->indexSet);
+      if(i < 0) {        /* The leaving row is infeasible; trust it with a fresh basis */
+        if(refactRecent(lp))
+          lp->spx_status = INFEASIBLE;
+        i = 0;
+        goto Finish;
+      }
+      else if(i > 0) {
+        *candidatecount = lp->longsteps->indexSet[0] + 1;
+        goto Finish;
+      }
+    }
     else {
       multi_restart(lp->longsteps);
       multi_valueInit(lp->longsteps, g*viol, lp->rhs[0]);
@@ -1530,9 +1953,10 @@ STATIC int coldual(lprec *lp, int row_nr, REAL *prow, int *nzprow,
   else
     i = current.varno;
 
+Finish:
   if(lp->spx_trace)
     report(lp, NORMAL, "coldual: Entering column %d, reduced cost %g, pivot value %g, bound swaps %d\n",
-                       i, drow[i], prow[i], multi_used(lp->longsteps));
+                       i, drow[i], prow[i], my_if(lp->longsteps == NULL, 0, lp->longsteps->indexSet[0]));
 
   return( i );
 } /* coldual */
@@ -5,6 +5,9 @@
 /* ------------------------------------------------------------------------- */
 #define UseSortOnBound_Improve
 /*#define UseSortOnBound_Substitute*/
+#define PRICE_VECTORMIN          64    /* Minimum candidate count for the vectorized scans */
+#define PRICE_PARALLELBLOCK    4096    /* Candidates per segment with PRICE_PARALLEL */
+#define PRICE_PARALLELMIN     16384    /* Minimum candidate count for using several threads */
 
 #if 0 /* Stricter feasibility-preserving tolerance; use w/ *_UseRejectionList */
   #define UseRelativeFeasibility       /* Use machine-precision and A-scale data */
@@ -39,6 +42,19 @@ STATIC MYBOOL findSubstitutionVar(pricerec *current, pricerec *candidate, int *c
 INLINE REAL normalizeEdge(lprec *lp, int item, REAL edge, MYBOOL isdual);
 STATIC void makePriceLoop(lprec *lp, int *start, int *end, int *delta);
 
+/* Vectorized candidate scoring */
+typedef void (priceNormalize_func)(int n, REAL *f, REAL *w, REAL epsvalue);
+STATIC priceNormalize_func *priceNormalize(void);
+STATIC MYBOOL priceVectorized(lprec *lp, MYBOOL collectMP, int count);
+STATIC void priceScores(lprec *lp, int n, int *index, REAL *f, REAL *w, MYBOOL isdual);
+STATIC void colprimScan(lprec *lp, int lo, int hi, int *index, REAL *fv, REAL *wv, pricerec *current,
+                        int *candidatecount, int *ninfeas, REAL *xinfeas, REAL *sinfeas);
+STATIC void colprimSegments(void *data, int threadnr, int threadcount);
+STATIC void colprimVector(lprec *lp, REAL *drow, int *nzdrow, REAL epsvalue, pricerec *current,
+                          int *candidatecount, int *ninfeas, REAL *xinfeas, REAL *sinfeas);
+STATIC void rowdualVector(lprec *lp, REAL *rhvec, int k, int iy, MYBOOL forceoutEQ, pricerec *current,
+                          int *ninfeas, REAL *xinfeas, REAL *sinfeas);
+
 /* Computation of reduced costs */
 STATIC void update_reducedcosts(lprec *lp, MYBOOL isdual, int leave_nr, int enter_nr, REAL *prow, REAL *drow);
 STATIC void compute_reducedcosts(lprec *lp, MYBOOL isdual, int row_nr, int *coltarget, MYBOOL dosolve,
@@ -52,6 +68,9 @@ STATIC int colprim(lprec *lp, REAL *drow, int *nzdrow,
                               MYBOOL skipupdate, int partialloop, int *candidatecount, MYBOOL updateinfeas, REAL *xviol);
 STATIC int rowprim(lprec *lp, int colnr, LREAL *theta, REAL *pcol, int *nzpcol, MYBOOL forceoutEQ, REAL *xviol);
 STATIC int rowdual(lprec *lp, REAL *rhvec, MYBOOL forceoutEQ, MYBOOL updateinfeas, REAL *xviol);
+STATIC void longdual_siftdown(REAL *ratio, int *index, int n, int k);
+STATIC int longdual_ratiotest(lprec *lp, REAL *prow, int *nzprow, REAL *drow,
+                                         REAL viol, REAL epspivot, int *boundswaps);
 STATIC int coldual(lprec *lp, int row_nr,
                               REAL *prow, int *nzprow, REAL *drow, int *nzdrow,
                               MYBOOL dualphase1, MYBOOL skipupdate,
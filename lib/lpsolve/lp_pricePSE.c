@@ -263,7 +263,7 @@ STATIC void freeWeights(REAL *w)
 
 STATIC MYBOOL updatePricer(lprec *lp, int rownr, int colnr, REAL *pcol, REAL *prow, int *nzprow)
 {
-  REAL   *vEdge = NULL, cEdge, hold, *newEdge, *w = NULL;
+  REAL   *vEdge = NULL, cEdge, hold, *newEdge, *w = NULL, timestart = 0;
   int    i, m, n, exitcol, errlevel = DETAILED;
   MYBOOL forceRefresh = FALSE, isDual, isDEVEX, ok = FALSE;
 
@@ -276,6 +276,10 @@ STATIC MYBOOL updatePricer(lprec *lp, int rownr, int colnr, REAL *pcol, REAL *pr
     return(ok);
   isDual = (MYBOOL) (hold > 0);
 
+  /* Time the update for the PRICE_HYBRID rule selection */
+  if((lp->monitor != NULL) && lp->monitor->pivhybrid)
+    timestart = timeNow();
+
   /* Do common initializations and computations */
   m = lp->rows;
   n = lp->sum;
@@ -481,6 +485,9 @@ Finish2:
   else
     ok = TRUE;
 
+  if(timestart > 0)
+    lp->monitor->hybridnormtime += timeNow() - timestart;
+
   return( ok );
 
 }
@@ -0,0 +1,584 @@
+
+/*
+   ----------------------------------------------------------------------------------
+   Bound propagation routines in lp_solve v5.5+
+   ----------------------------------------------------------------------------------
+    License terms: LGPL.
+
+    Requires:      lp_lib.h, lp_utils.h, lp_matrix.h, lp_scale.h
+
+    Release notes:
+    v1.0.0  Activity-based propagation of bound changes, shared by presolve and
+            by the B&B nodes.  The minimum and maximum row activities are kept
+            up to date as column bounds change, and every row that is affected
+            by a change is queued for propagation along the row-major matrix.
+            Only the bounds of integer columns are tightened, after rounding;
+            the bounds of the other columns contribute to the activities.
+    v1.1.0  Probing of the binary columns; each is fixed at 0 and at 1 in turn
+            and the bounds are propagated.  A value that is infeasible fixes
+            the column at the other value, and so does a column that both
+            probes fix at the same value.  The fixings implied by the probes
+            are kept in an implication graph, which is applied directly
+            whenever a binary column gets fixed, before any row propagation.
+
+   ----------------------------------------------------------------------------------
+*/
+
+#include <string.h>
+
+#include "commonlib.h"
+#include "lp_lib.h"
+#include "lp_scale.h"
+#include "lp_utils.h"
+#include "lp_report.h"
+#include "lp_matrix.h"
+#include "lp_propagate.h"
+
+#ifdef FORTIFY
+# include "lp_fortify.h"
+#endif
+
+/* Huge bounds, such as those set by presolve_makefree, are counted like
+   infinite ones; adding and removing their contributions would otherwise
+   wipe out the small ones in the finite part of the activity */
+#define my_hugebound(value)  (fabs(value) >= PROPAGATE_HUGEBOUND)
+
+
+/* Add (sign = 1) or remove (sign = -1) the contribution of one matrix
+   element to the activity range of its row */
+STATIC void propagate_contribute(propagaterec *prop, int rownr, REAL value,
+                                 REAL lobound, REAL upbound, int sign)
+{
+  REAL minbound, maxbound;
+
+  if(value > 0) {
+    minbound = lobound;
+    maxbound = upbound;
+  }
+  else {
+    minbound = upbound;
+    maxbound = lobound;
+  }
+  if(my_hugebound(minbound))
+    prop->mininf[rownr] += sign;
+  else
+    prop->minact[rownr] += sign*value*minbound;
+  if(my_hugebound(maxbound))
+    prop->maxinf[rownr] += sign;
+  else
+    prop->maxact[rownr] += sign*value*maxbound;
+}
+
+STATIC void propagate_queue(propagaterec *prop, int rownr)
+{
+  if(!prop->isqueued[rownr] && !prop->isskipped[rownr]) {
+    prop->isqueued[rownr] = TRUE;
+    prop->rowqueue[++prop->rowqueue[0]] = rownr;
+  }
+}
+
+STATIC propagaterec *create_propagate(lprec *lp, REAL *lowbo, REAL *upbo, LLrec *rowmap, LLrec *colmap)
+{
+  propagaterec *prop;
+  MATrec       *mat = lp->matA;
+  int          i, j, ix, ie;
+
+  prop = (propagaterec *) calloc(1, sizeof(*prop));
+  if(prop == NULL)
+    return( prop );
+  prop->lp      = lp;
+  prop->rows    = lp->rows;
+  prop->columns = lp->columns;
+  prop->rowmap  = rowmap;
+  prop->colmap  = colmap;
+  if(!allocREAL(lp, &prop->lowbo, lp->columns+1, FALSE) ||
+     !allocREAL(lp, &prop->upbo, lp->columns+1, FALSE) ||
+     !allocREAL(lp, &prop->minact, lp->rows+1, TRUE) ||
+     !allocREAL(lp, &prop->maxact, lp->rows+1, TRUE) ||
+     !allocINT(lp, &prop->mininf, lp->rows+1, TRUE) ||
+     !allocINT(lp, &prop->maxinf, lp->rows+1, TRUE) ||
+     !allocINT(lp, &prop->rowqueue, lp->rows+1, FALSE) ||
+     !allocINT(lp, &prop->litqueue, lp->columns+1, FALSE) ||
+     !allocMYBOOL(lp, &prop->isqueued, lp->rows+1, TRUE) ||
+     !allocMYBOOL(lp, &prop->isskipped, lp->rows+1, TRUE) ||
+     !mat_validate(mat)) {
+    free_propagate(&prop);
+    return( prop );
+  }
+  prop->rowqueue[0] = 0;
+  prop->litqueue[0] = 0;
+
+  /* Compute the activity ranges of all rows from the given column bounds */
+  for(j = 1; j <= lp->columns; j++) {
+    prop->lowbo[j] = lowbo[lp->rows + j];
+    prop->upbo[j]  = upbo[lp->rows + j];
+    if((colmap != NULL) && !isActiveLink(colmap, j))
+      continue;
+    ie = mat->col_end[j];
+    for(ix = mat->col_end[j-1]; ix < ie; ix++) {
+      i = COL_MAT_ROWNR(ix);
+      if(i == 0)
+        continue;
+      if(is_semicont(lp, j))
+        prop->isskipped[i] = TRUE;
+      else
+        propagate_contribute(prop, i, COL_MAT_VALUE(ix), prop->lowbo[j], prop->upbo[j], 1);
+    }
+  }
+
+  /* Queue all the active rows for the first propagation */
+  for(i = 1; i <= lp->rows; i++)
+    if((rowmap == NULL) || isActiveLink(rowmap, i))
+      propagate_queue(prop, i);
+    else
+      prop->isskipped[i] = TRUE;
+
+  return( prop );
+}
+
+STATIC MYBOOL free_propagate(propagaterec **prop)
+{
+  if((prop == NULL) || (*prop == NULL))
+    return( FALSE );
+
+  FREE((*prop)->lowbo);
+  FREE((*prop)->upbo);
+  FREE((*prop)->minact);
+  FREE((*prop)->maxact);
+  FREE((*prop)->mininf);
+  FREE((*prop)->maxinf);
+  FREE((*prop)->rowqueue);
+  FREE((*prop)->litqueue);
+  FREE((*prop)->isqueued);
+  FREE((*prop)->isskipped);
+  free_implications(&(*prop)->implic);
+  FREE(*prop);
+  return( TRUE );
+}
+
+/* Build the implication graph from a list of implications; every implication
+   a => b is stored along with its contrapositive not(b) => not(a) */
+STATIC implicrec *create_implications(lprec *lp, int *implfrom, int *implto, int count)
+{
+  implicrec *implic;
+  int       i, k;
+
+  implic = (implicrec *) calloc(1, sizeof(*implic));
+  if(implic == NULL)
+    return( implic );
+  implic->literals = 2*(lp->columns+1);
+  if(!allocINT(lp, &implic->start, implic->literals+1, TRUE) ||
+     !allocINT(lp, &implic->implied, 2*count, FALSE)) {
+    free_implications(&implic);
+    return( implic );
+  }
+
+  /* Count the implied literals of each literal, then fill them in, using
+     the start positions as running pointers that are shifted back after */
+  for(i = 0; i < count; i++) {
+    implic->start[implfrom[i]+1]++;
+    implic->start[(implto[i] ^ 1)+1]++;
+  }
+  for(k = 1; k <= implic->literals; k++)
+    implic->start[k] += implic->start[k-1];
+  for(i = 0; i < count; i++) {
+    implic->implied[implic->start[implfrom[i]]++] = implto[i];
+    implic->implied[implic->start[implto[i] ^ 1]++] = implfrom[i] ^ 1;
+  }
+  for(k = implic->literals; k > 0; k--)
+    implic->start[k] = implic->start[k-1];
+  implic->start[0] = 0;
+
+  return( implic );
+}
+
+STATIC MYBOOL free_implications(implicrec **implic)
+{
+  if((implic == NULL) || (*implic == NULL))
+    return( FALSE );
+
+  FREE((*implic)->start);
+  FREE((*implic)->implied);
+  FREE(*implic);
+  return( TRUE );
+}
+
+/* Update the activity ranges of the rows of a column for new column bounds,
+   and queue the rows for propagation */
+STATIC void propagate_setbounds(propagaterec *prop, int colnr, REAL lobound, REAL upbound)
+{
+  lprec  *lp = prop->lp;
+  MATrec *mat = lp->matA;
+  int    i, ix, ie;
+
+  if((prop->lowbo[colnr] == lobound) && (prop->upbo[colnr] == upbound))
+    return;
+
+  /* Queue the literal of a binary column that becomes fixed */
+  if((prop->implic != NULL) && (lobound == upbound) &&
+     (prop->lowbo[colnr] != prop->upbo[colnr]) && (prop->litqueue[0] < prop->columns)) {
+    REAL value = unscaled_value(lp, lobound, lp->rows + colnr);
+    if((value == 0) || (value == 1))
+      prop->litqueue[++prop->litqueue[0]] = 2*colnr + (int) value;
+  }
+
+  if(((prop->colmap == NULL) || isActiveLink(prop->colmap, colnr)) && !is_semicont(lp, colnr)) {
+    ie = mat->col_end[colnr];
+    for(ix = mat->col_end[colnr-1]; ix < ie; ix++) {
+      i = COL_MAT_ROWNR(ix);
+      if((i == 0) || prop->isskipped[i])
+        continue;
+      propagate_contribute(prop, i, COL_MAT_VALUE(ix), prop->lowbo[colnr], prop->upbo[colnr], -1);
+      propagate_contribute(prop, i, COL_MAT_VALUE(ix), lobound, upbound, 1);
+      propagate_queue(prop, i);
+    }
+  }
+  prop->lowbo[colnr] = lobound;
+  prop->upbo[colnr]  = upbound;
+}
+
+/* Bring the activity ranges up to date with a bound vector that may have been
+   changed outside of the propagator, for example by B&B branching and undo */
+STATIC int propagate_sync(propagaterec *prop, REAL *lowbo, REAL *upbo)
+{
+  int j, n = 0, rows = prop->rows;
+
+  for(j = 1; j <= prop->columns; j++)
+    if((prop->lowbo[j] != lowbo[rows + j]) || (prop->upbo[j] != upbo[rows + j])) {
+      propagate_setbounds(prop, j, lowbo[rows + j], upbo[rows + j]);
+      n++;
+    }
+  return( n );
+}
+
+/* Set a new bound of an integer column; returns FALSE if the bounds cross */
+STATIC MYBOOL propagate_tighten(propagaterec *prop, int colnr, REAL newbound, MYBOOL isupper,
+                                REAL *lowbo, REAL *upbo, DeltaVrec *lowerchange, DeltaVrec *upperchange)
+{
+  lprec *lp = prop->lp;
+  int   varnr = lp->rows + colnr;
+  REAL  lobound = unscaled_value(lp, lowbo[varnr], varnr),
+        upbound = unscaled_value(lp, upbo[varnr], varnr);
+
+  newbound = unscaled_value(lp, newbound, varnr);
+  if(isupper) {
+    newbound = floor(newbound + lp->epsint*MAX(1, fabs(newbound)));
+    if(newbound > upbound - 0.5)
+      return( TRUE );
+    if(newbound < lobound - lp->epsint)
+      return( FALSE );
+
+    /* Fix at the exact scaled lower bound, so that the bounds cannot cross */
+    if(newbound < lobound + lp->epsint)
+      newbound = lowbo[varnr];
+    else
+      newbound = scaled_value(lp, newbound, varnr);
+    if(upperchange != NULL)
+      modifyUndoLadder(upperchange, varnr, upbo, newbound);
+    else
+      upbo[varnr] = newbound;
+  }
+  else {
+    newbound = ceil(newbound - lp->epsint*MAX(1, fabs(newbound)));
+    if(newbound < lobound + 0.5)
+      return( TRUE );
+    if(newbound > upbound + lp->epsint)
+      return( FALSE );
+    if(newbound > upbound - lp->epsint)
+      newbound = upbo[varnr];
+    else
+      newbound = scaled_value(lp, newbound, varnr);
+    if(lowerchange != NULL)
+      modifyUndoLadder(lowerchange, varnr, lowbo, newbound);
+    else
+      lowbo[varnr] = newbound;
+  }
+  prop->tightened++;
+  propagate_setbounds(prop, colnr, lowbo[varnr], upbo[varnr]);
+  return( TRUE );
+}
+
+/* Propagate the queued literals and rows until no more integer bounds can be
+   tightened; bound changes are recorded in the undo ladders when these are given */
+STATIC int propagate_fixpoint(propagaterec *prop, REAL *lowbo, REAL *upbo,
+                              DeltaVrec *lowerchange, DeltaVrec *upperchange)
+{
+  lprec  *lp = prop->lp;
+  MATrec *mat = lp->matA;
+  int    i, j, ix, ie, residual, visits, status = RUNNING;
+  REAL   value, lhs, rhs, tol, contrib, bound;
+
+  visits = PROPAGATE_ROWVISITS*prop->rows;
+  while(((prop->rowqueue[0] > 0) || (prop->litqueue[0] > 0)) && (status == RUNNING)) {
+
+    /* Fix the columns implied by a fixed binary column before looking at rows */
+    if(prop->litqueue[0] > 0) {
+      i = prop->litqueue[prop->litqueue[0]--];
+      ie = prop->implic->start[i+1];
+      for(ix = prop->implic->start[i]; ix < ie; ix++) {
+        j = prop->implic->implied[ix] / 2;
+        value = (REAL) (prop->implic->implied[ix] % 2);
+        if(!propagate_tighten(prop, j, scaled_value(lp, value, lp->rows + j), (MYBOOL) (value == 0),
+                              lowbo, upbo, lowerchange, upperchange)) {
+          status = INFEASIBLE;
+          break;
+        }
+      }
+      continue;
+    }
+
+    i = prop->rowqueue[prop->rowqueue[0]--];
+    prop->isqueued[i] = FALSE;
+    if(visits-- <= 0)
+      break;
+
+    /* The stored row activity lies in [rhs-range, rhs] */
+    rhs = lp->orig_rhs[i];
+    if(my_infinite(lp, upbo[i]))
+      lhs = -lp->infinite;
+    else
+      lhs = rhs - upbo[i];
+    tol = lp->epsint*(1 + MAX(fabs(rhs), fabs(prop->minact[i])));
+    if((prop->mininf[i] == 0) && !my_infinite(lp, rhs) && (prop->minact[i] > rhs + tol)) {
+      status = INFEASIBLE;
+      break;
+    }
+    tol = lp->epsint*(1 + MAX(fabs(lhs), fabs(prop->maxact[i])));
+    if((prop->maxinf[i] == 0) && !my_infinite(lp, lhs) && (prop->maxact[i] < lhs - tol)) {
+      status = INFEASIBLE;
+      break;
+    }
+    if((prop->mininf[i] > 1) && (prop->maxinf[i] > 1))
+      continue;
+
+    /* Derive bounds for the integer columns of the row */
+    ie = mat->row_end[i];
+    for(ix = mat->row_end[i-1]; ix < ie; ix++) {
+      j = ROW_MAT_COLNR(ix);
+      if(!is_int(lp, j) || ((prop->colmap != NULL) && !isActiveLink(prop->colmap, j)))
+        continue;
+      value = ROW_MAT_VALUE(ix);
+
+      /* Upper side; the activity excluding column j is at least the residual */
+      if(!my_infinite(lp, rhs)) {
+        bound = (value > 0 ? prop->lowbo[j] : prop->upbo[j]);
+        residual = prop->mininf[i];
+        if(my_hugebound(bound)) {
+          residual--;
+          contrib = 0;
+        }
+        else
+          contrib = value*bound;
+        if(residual == 0) {
+          bound = (rhs - (prop->minact[i] - contrib)) / value;
+          if(!propagate_tighten(prop, j, bound, (MYBOOL) (value > 0), lowbo, upbo, lowerchange, upperchange)) {
+            status = INFEASIBLE;
+            break;
+          }
+        }
+      }
+
+      /* Lower side; the activity excluding column j is at most the residual */
+      if(!my_infinite(lp, lhs)) {
+        bound = (value > 0 ? prop->upbo[j] : prop->lowbo[j]);
+        residual = prop->maxinf[i];
+        if(my_hugebound(bound)) {
+          residual--;
+          contrib = 0;
+        }
+        else
+          contrib = value*bound;
+        if(residual == 0) {
+          bound = (lhs - (prop->maxact[i] - contrib)) / value;
+          if(!propagate_tighten(prop, j, bound, (MYBOOL) (value < 0), lowbo, upbo, lowerchange, upperchange)) {
+            status = INFEASIBLE;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  /* Leave clean queues for the next call */
+  while(prop->rowqueue[0] > 0)
+    prop->isqueued[prop->rowqueue[prop->rowqueue[0]--]] = FALSE;
+  prop->litqueue[0] = 0;
+  return( status );
+}
+
+STATIC int propagate_run(propagaterec *prop, REAL *lowbo, REAL *upbo,
+                         DeltaVrec *lowerchange, DeltaVrec *upperchange)
+{
+  prop->tightened = 0;
+  propagate_sync(prop, lowbo, upbo);
+  return( propagate_fixpoint(prop, lowbo, upbo, lowerchange, upperchange) );
+}
+
+/* Undo the bound changes of the current level of a pair of probing ladders,
+   and bring the activity ranges back in line with the restored bounds */
+STATIC void propagate_undo(propagaterec *prop, REAL *lowbo, REAL *upbo,
+                           DeltaVrec *lowerchange, DeltaVrec *upperchange)
+{
+  lprec     *lp = prop->lp;
+  DeltaVrec *DV;
+  MATrec    *mat;
+  int       k, ix, ib, pass;
+  REAL      *target;
+
+  /* Restore the bounds first, going backwards so that the oldest value wins,
+     and only then update the activities of the changed columns */
+  for(pass = 0; pass < 4; pass++) {
+    DV     = (pass % 2 == 0 ? lowerchange : upperchange);
+    target = (pass % 2 == 0 ? lowbo : upbo);
+    mat = DV->tracker;
+    ib = mat->col_end[DV->activelevel-1];
+    for(ix = mat->col_end[DV->activelevel]-1; ix >= ib; ix--) {
+      k = COL_MAT_ROWNR(ix);
+#ifdef UseMilpSlacksRCF  /* Check if we should include ranged constraints */
+      k -= lp->rows;
+#endif
+      if(pass < 2)
+        target[lp->rows + k] = COL_MAT_VALUE(ix);
+      else
+        propagate_setbounds(prop, k, lowbo[lp->rows + k], upbo[lp->rows + k]);
+    }
+  }
+  decrementUndoLadder(lowerchange);
+  decrementUndoLadder(upperchange);
+
+  /* The activities now match the bounds from before the probe */
+  while(prop->rowqueue[0] > 0)
+    prop->isqueued[prop->rowqueue[prop->rowqueue[0]--]] = FALSE;
+  prop->litqueue[0] = 0;
+}
+
+/* Probe the unfixed binary columns, within a time budget; each is fixed at 0
+   and at 1 in turn, and the bounds are propagated.  The fixings found are
+   applied to the bound vectors, and recorded in the undo ladders when these
+   are given.  The implications of the probes are kept in the implication
+   graph of the propagator when requested. */
+STATIC int propagate_probe(propagaterec *prop, REAL *lowbo, REAL *upbo,
+                           DeltaVrec *lowerchange, DeltaVrec *upperchange,
+                           MYBOOL buildgraph, REAL timelimit)
+{
+  lprec     *lp = prop->lp;
+  DeltaVrec *probelower = NULL, *probeupper = NULL, *DV;
+  MATrec    *mat;
+  MYBOOL    *isbinary = NULL, isfeasible[2];
+  int       i, j, k, v, w, ix, ie, varnr, tightened, nprobed = 0, status = RUNNING,
+            *stamp = NULL, *fixlist = NULL, *implfrom = NULL, *implto = NULL,
+            nimpl = 0, sizeimpl = 0;
+  REAL      timestart = timeNow();
+
+  prop->tightened = 0;
+  if(!allocMYBOOL(lp, &isbinary, prop->columns+1, TRUE) ||
+     !allocINT(lp, &stamp, prop->columns+1, TRUE) ||
+     !allocINT(lp, &fixlist, prop->columns+1, FALSE))
+    goto Finish;
+  probelower = createUndoLadder(lp, prop->columns, 2);
+  probeupper = createUndoLadder(lp, prop->columns, 2);
+
+  /* Identify the unfixed binary columns */
+  for(j = 1; j <= prop->columns; j++) {
+    if((prop->colmap != NULL) && !isActiveLink(prop->colmap, j))
+      continue;
+    varnr = lp->rows + j;
+    isbinary[j] = (MYBOOL) (is_int(lp, j) && (lowbo[varnr] == 0) &&
+                            (fabs(unscaled_value(lp, upbo[varnr], varnr) - 1) < lp->epsprimal));
+  }
+
+  for(j = 1; (j <= prop->columns) && (status == RUNNING); j++) {
+    varnr = lp->rows + j;
+    if(!isbinary[j] || (lowbo[varnr] == upbo[varnr]))
+      continue;
+    if((timeNow() - timestart > timelimit) || userabort(lp, -1))
+      break;
+
+    /* Probe both values; the probe bounds are kept in separate ladders */
+    nprobed++;
+    tightened = prop->tightened;
+    fixlist[0] = 0;
+    for(v = 0; v <= 1; v++) {
+      incrementUndoLadder(probelower);
+      incrementUndoLadder(probeupper);
+      isfeasible[v] = (MYBOOL) (propagate_tighten(prop, j, scaled_value(lp, (REAL) v, varnr), (MYBOOL) (v == 0),
+                                                  lowbo, upbo, probelower, probeupper) &&
+                                (propagate_fixpoint(prop, lowbo, upbo, probelower, probeupper) != INFEASIBLE));
+
+      /* Collect the binary columns fixed by the probe; the lower bound
+         ladder holds the fixings at 1, and the upper bound ladder at 0 */
+      for(w = 0; (w <= 1) && isfeasible[v]; w++) {
+        DV  = (w == 0 ? probeupper : probelower);
+        mat = DV->tracker;
+        ie = mat->col_end[DV->activelevel];
+        for(ix = mat->col_end[DV->activelevel-1]; ix < ie; ix++) {
+          k = COL_MAT_ROWNR(ix);
+#ifdef UseMilpSlacksRCF  /* Check if we should include ranged constraints */
+          k -= lp->rows;
+#endif
+          if((k == j) || !isbinary[k] || (lowbo[lp->rows + k] != upbo[lp->rows + k]))
+            continue;
+          if(buildgraph) {
+            if(nimpl >= sizeimpl) {
+              sizeimpl = 2*sizeimpl + prop->columns;
+              if(!allocINT(lp, &implfrom, sizeimpl, AUTOMATIC) ||
+                 !allocINT(lp, &implto, sizeimpl, AUTOMATIC)) {
+                buildgraph = FALSE;
+                continue;
+              }
+            }
+            implfrom[nimpl] = 2*j + v;
+            implto[nimpl]   = 2*k + w;
+            nimpl++;
+          }
+          if(v == 0)
+            stamp[k] = 2*j + w;
+          else if(stamp[k] == 2*j + w)
+            fixlist[++fixlist[0]] = 2*k + w;
+        }
+      }
+      propagate_undo(prop, lowbo, upbo, probelower, probeupper);
+    }
+    prop->tightened = tightened;
+
+    /* Fix the column itself if one of the values is infeasible */
+    if(!isfeasible[0] && !isfeasible[1]) {
+      status = INFEASIBLE;
+      break;
+    }
+    if(!isfeasible[0] || !isfeasible[1]) {
+      fixlist[0] = 1;
+      fixlist[1] = 2*j + (isfeasible[1] ? 1 : 0);
+    }
+
+    /* Apply the fixings, and propagate them */
+    for(i = 1; (i <= fixlist[0]) && (status == RUNNING); i++) {
+      k = fixlist[i] / 2;
+      w = fixlist[i] % 2;
+      if(!propagate_tighten(prop, k, scaled_value(lp, (REAL) w, lp->rows + k), (MYBOOL) (w == 0),
+                            lowbo, upbo, lowerchange, upperchange) ||
+         (propagate_fixpoint(prop, lowbo, upbo, lowerchange, upperchange) == INFEASIBLE))
+        status = INFEASIBLE;
+    }
+  }
+
+  /* Store the implication graph */
+  if(buildgraph && (status == RUNNING) && (nimpl > 0)) {
+    free_implications(&prop->implic);
+    prop->implic = create_implications(lp, implfrom, implto, nimpl);
+  }
+  report(lp, DETAILED, "propagate_probe: Probed %d columns in %.3fs; tightened %d bounds and found %d implications\n",
+                       nprobed, timeNow() - timestart, prop->tightened, nimpl);
+
+Finish:
+  freeUndoLadder(&probelower);
+  freeUndoLadder(&probeupper);
+  FREE(isbinary);
+  FREE(stamp);
+  FREE(fixlist);
+  FREE(implfrom);
+  FREE(implto);
+
+  return( status );
+}
+
@@ -0,0 +1,62 @@
+
+#ifndef HEADER_lp_propagate
+#define HEADER_lp_propagate
+
+#include "lp_types.h"
+#include "lp_utils.h"
+
+#define PROPAGATE_ROWVISITS    10   /* Limit on row visits per propagation, as a multiple of the row count */
+#define PROPAGATE_PROBETIME   2.0   /* Time budget in seconds for probing the binary columns */
+#define PROPAGATE_HUGEBOUND 1.0e+8   /* Column bounds of larger magnitude count as infinite in the activities */
+
+
+/* Implication graph of the binary columns; literal 2*j+v stands for column j
+   fixed at v, and the literals implied by literal k are stored in
+   implied[start[k]] .. implied[start[k+1]-1] */
+typedef struct _implicrec
+{
+  int       literals;
+  int       *start;
+  int       *implied;
+} implicrec;
+
+
+/* Activity-based bound propagation record */
+typedef struct _propagaterec
+{
+  lprec     *lp;
+  int       rows;
+  int       columns;
+  REAL      *lowbo, *upbo;         /* Column bounds that the activities are based on */
+  REAL      *minact, *maxact;      /* Finite parts of the row activity range */
+  int       *mininf, *maxinf;      /* Counts of infinite contributions to the activity range */
+  int       *rowqueue;             /* Rows waiting to be propagated, count at index 0 */
+  MYBOOL    *isqueued;
+  MYBOOL    *isskipped;            /* Rows with semi-continuous columns are not propagated */
+  LLrec     *rowmap, *colmap;      /* Optional maps of the active rows and columns */
+  implicrec *implic;               /* Optional implications found by probing */
+  int       *litqueue;             /* Fixed binary literals waiting for their implications */
+  int       tightened;             /* Bounds tightened by the last call to propagate_run */
+} propagaterec;
+
+#ifdef __cplusplus
+__EXTERN_C {
+#endif
+
+STATIC propagaterec *create_propagate(lprec *lp, REAL *lowbo, REAL *upbo, LLrec *rowmap, LLrec *colmap);
+STATIC MYBOOL free_propagate(propagaterec **prop);
+STATIC void propagate_setbounds(propagaterec *prop, int colnr, REAL lobound, REAL upbound);
+STATIC int propagate_sync(propagaterec *prop, REAL *lowbo, REAL *upbo);
+STATIC int propagate_run(propagaterec *prop, REAL *lowbo, REAL *upbo,
+                         DeltaVrec *lowerchange, DeltaVrec *upperchange);
+STATIC int propagate_probe(propagaterec *prop, REAL *lowbo, REAL *upbo,
+                           DeltaVrec *lowerchange, DeltaVrec *upperchange,
+                           MYBOOL buildgraph, REAL timelimit);
+STATIC MYBOOL free_implications(implicrec **implic);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEADER_lp_propagate */
+
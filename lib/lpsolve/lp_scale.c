@@ -4,6 +4,7 @@
 #include "lp_lib.h"
 #include "lp_report.h"
 #include "lp_scale.h"
+#include "mythread.h"
 
 #ifdef FORTIFY
 # include "lp_fortify.h"
@@ -75,6 +76,16 @@ STATIC REAL unscaled_mat(lprec *lp, REAL value, int rownr, int colnr)
   return( value );
 }
 
+/* Number of threads for a pass over the constraint matrix */
+STATIC int scale_threads(lprec *lp)
+{
+  int nz = get_nonzeros(lp);
+
+  if(nz < SCALE_PARALLELMIN)
+    return( 1 );
+  return( MIN(lp->num_threads, nz / (SCALE_PARALLELMIN / 2)) );
+}
+
 /* Compute the scale factor by the formulae:
       FALSE: SUM (log |Aij|) ^ 2
       TRUE:  SUM (log |Aij| - RowScale[i] - ColScale[j]) ^ 2 */
@@ -139,29 +150,150 @@ REAL CurtisReidMeasure(lprec *lp, MYBOOL _Advanced, REAL *FRowScale, REAL *FColS
 
     r, c are resulting row and column scalings (RowScale, ColScale) */
 
+/* Data shared by the threads of the Curtis-Reid passes.  Every thread owns a
+   range of rows or columns and gathers over their elements in the order of a
+   serial column scan, so the iterates do not depend on the number of threads */
+#define CR_LOGSUMS        0
+#define CR_RESIDUAL       1
+
+typedef struct _crpass
+{
+  lprec     *lp;
+  int       pass;
+  int       *count;             /* Element counts of the rows or columns */
+  REAL      *logsum;            /* Sums of log |Aij| of the rows or columns */
+  REAL      *measure;           /* Column sums of (log |Aij|)^2 */
+  REAL      *residual;          /* Residual of the rows or columns being updated */
+  REAL      *weight;            /* Weights of the columns or rows gathered into it */
+  REAL      ek, factor;
+} crpass;
+
+/* Row part: residual[i] = (ek * residual[i] + SUM weight[j]) * factor over row i */
+STATIC void CurtisReidRows(void *data, int threadnr, int threadcount)
+{
+  crpass *rec = (crpass *) data;
+  lprec  *lp = rec->lp;
+  MATrec *mat = lp->matA;
+  int    i, ix, ie, lo, hi, *rownr;
+  REAL   hold, absvalue, *value;
+
+  /* A single thread scans the columns in storage order */
+  if(threadcount == 1) {
+    if(rec->pass != CR_LOGSUMS)
+      for(i = 1; i <= lp->rows; i++)
+        rec->residual[i] *= rec->ek;
+    value = &(COL_MAT_VALUE(0));
+    rownr = &(COL_MAT_ROWNR(0));
+    for(i = 1, ix = 0; i <= lp->columns; i++) {
+      ie = mat->col_end[i];
+      for(; ix < ie;
+          ix++, value += matValueStep, rownr += matRowColStep) {
+        if(rec->pass != CR_LOGSUMS)
+          rec->residual[*rownr] += rec->weight[i];
+        else if((absvalue = fabs(*value)) > 0) {
+          rec->logsum[*rownr] += log(absvalue);
+          rec->count[*rownr]++;
+        }
+      }
+    }
+    if(rec->pass != CR_LOGSUMS)
+      for(i = 1; i <= lp->rows; i++)
+        rec->residual[i] *= rec->factor;
+    return;
+  }
+
+  thread_partition(threadnr, threadcount, 1, lp->rows, &lo, &hi);
+  for(i = lo; i <= hi; i++) {
+    ix = mat->row_end[i-1];
+    ie = mat->row_end[i];
+    if(rec->pass == CR_LOGSUMS) {
+      for(; ix < ie; ix++) {
+        absvalue = fabs(ROW_MAT_VALUE(ix));
+        if(absvalue > 0) {
+          rec->logsum[i] += log(absvalue);
+          rec->count[i]++;
+        }
+      }
+    }
+    else {
+      hold = rec->residual[i] * rec->ek;
+      for(; ix < ie; ix++)
+        hold += rec->weight[ROW_MAT_COLNR(ix)];
+      rec->residual[i] = hold * rec->factor;
+    }
+  }
+}
+
+/* Column part: residual[j] = (ek * residual[j] + SUM weight[i]) * factor over
+   column j, where the objective function is row 0 */
+STATIC void CurtisReidColumns(void *data, int threadnr, int threadcount)
+{
+  crpass *rec = (crpass *) data;
+  lprec  *lp = rec->lp;
+  MATrec *mat = lp->matA;
+  int    j, ix, ie, lo, hi, *rownr;
+  REAL   hold, absvalue, logvalue, *value;
+
+  thread_partition(threadnr, threadcount, 1, lp->columns, &lo, &hi);
+  for(j = lo; j <= hi; j++) {
+    ix = mat->col_end[j-1];
+    ie = mat->col_end[j];
+    value = &(COL_MAT_VALUE(ix));
+    rownr = &(COL_MAT_ROWNR(ix));
+    if(rec->pass == CR_LOGSUMS) {
+      hold = 0;
+      absvalue = fabs(lp->orig_obj[j]);
+      if(absvalue > 0) {
+        logvalue = log(absvalue);
+        rec->logsum[j] += logvalue;
+        rec->count[j]++;
+        hold += logvalue*logvalue;
+      }
+      for(; ix < ie; ix++, value += matValueStep) {
+        absvalue = fabs(*value);
+        if(absvalue > 0) {
+          logvalue = log(absvalue);
+          rec->logsum[j] += logvalue;
+          rec->count[j]++;
+          hold += logvalue*logvalue;
+        }
+      }
+      rec->measure[j] = hold;
+    }
+    else {
+      hold = rec->residual[j] * rec->ek;
+      if(lp->orig_obj[j] != 0)
+        hold += rec->weight[0];
+      for(; ix < ie; ix++, rownr += matRowColStep)
+        hold += rec->weight[*rownr];
+      rec->residual[j] = hold * rec->factor;
+    }
+  }
+}
+
 int CurtisReidScales(lprec *lp, MYBOOL _Advanced, REAL *FRowScale, REAL *FColScale)
 {
-  int    i, row, col, ent, nz;
+  int    i, row, col, ent, nz, threads;
   REAL   *RowScalem2, *ColScalem2,
          *RowSum, *ColSum,
-         *residual_even, *residual_odd;
+         *residual_even, *residual_odd, *weight;
   REAL   sk,   qk,     ek,
          skm1, qkm1,   ekm1,
          qkm2, qkqkm1, ekm2, ekekm1,
          absvalue, logvalue,
          StopTolerance;
   int    *RowCount, *ColCount, colMax;
-  int    Result;
+  int    Result = 0;
   MATrec *mat = lp->matA;
-  REAL   *value;
-  int    *rownr, *colnr;
+  int    *rownr;
+  crpass rec;
 
-  if(CurtisReidMeasure(lp, _Advanced, FRowScale, FColScale)<0.1*get_nonzeros(lp))
-  return(0);
-
-  /* Allocate temporary memory and find RowSum and ColSum measures */
+  /* Allocate temporary memory; the matrix is read through the column
+     storage and the row index, and never copied */
   nz = get_nonzeros(lp);
   colMax = lp->columns;
+  threads = scale_threads(lp);
+  mat_validate(mat);
 
   allocREAL(lp, &RowSum, lp->rows+1, TRUE);
   allocINT(lp,  &RowCount, lp->rows+1, TRUE);
@@ -173,33 +305,40 @@ int CurtisReidScales(lprec *lp, MYBOOL _Advanced, REAL *FRowScale, REAL *FColSca
 
   allocREAL(lp, &RowScalem2, lp->rows+1, FALSE);
   allocREAL(lp, &ColScalem2, colMax+1, FALSE);
+  allocREAL(lp, &weight, MAX(lp->rows, colMax)+1, FALSE);
+
+  /* Find the RowSum and ColSum measures, and the initial scaling measure
+     SUM (log |Aij|) ^ 2 from the column sums in ColScalem2 */
+  rec.lp      = lp;
+  rec.pass    = CR_LOGSUMS;
+  rec.count   = ColCount;
+  rec.logsum  = ColSum;
+  rec.measure = ColScalem2;
+  thread_run(threads, CurtisReidColumns, &rec);
+  rec.count   = RowCount;
+  rec.logsum  = RowSum;
+  thread_run(threads, CurtisReidRows, &rec);
 
   /* Set origin for row scaling */
   for(i = 1; i <= colMax; i++) {
     absvalue=fabs(lp->orig_obj[i]);
     if(absvalue>0) {
       logvalue = log(absvalue);
-      ColSum[i] += logvalue;
       RowSum[0] += logvalue;
-      ColCount[i]++;
       RowCount[0]++;
     }
   }
 
-  value = &(COL_MAT_VALUE(0));
-  rownr = &(COL_MAT_ROWNR(0));
-  colnr = &(COL_MAT_COLNR(0));
-  for(i = 0; i < nz;
-      i++, value += matValueStep, rownr += matRowColStep, colnr += matRowColStep) {
-    absvalue=fabs(*value);
-    if(absvalue>0) {
-      logvalue = log(absvalue);
-      ColSum[*colnr] += logvalue;
-      RowSum[*rownr] += logvalue;
-      ColCount[*colnr]++;
-      RowCount[*rownr]++;
-    }
+  /* Check if there is anything to gain */
+  if(_Advanced)
+    absvalue = CurtisReidMeasure(lp, _Advanced, FRowScale, FColScale);
+  else {
+    absvalue = 0;
+    for(col = 1; col <= colMax; col++)
+      absvalue += ColScalem2[col];
   }
+  if(absvalue < 0.1*nz)
+    goto Finish;
 
   /* Make sure we dont't have division by zero errors */
   for(row = 0; row <= lp->rows; row++)
@@ -220,23 +359,18 @@ int CurtisReidScales(lprec *lp, MYBOOL _Advanced, REAL *FRowScale, REAL *FColSca
     RowScalem2[row] = FRowScale[row];
   }
 
-  /* Compute initial residual */
+  /* Compute initial residual as -(-ColSum + E^T RowScale) */
   for(col = 1; col <= colMax; col++) {
     FColScale[col] = 0;
     ColScalem2[col] = 0;
-    residual_even[col] = ColSum[col];
-
-    if(lp->orig_obj[col] != 0)
-      residual_even[col] -= RowSum[0] / (REAL) RowCount[0];
-
-    i = mat->col_end[col-1];
-    rownr = &(COL_MAT_ROWNR(i));
-    ent = mat->col_end[col];
-    for(; i < ent;
-        i++, rownr += matRowColStep) {
-      residual_even[col] -= RowSum[*rownr] / (REAL) RowCount[*rownr];
-    }
+    residual_even[col] = -ColSum[col];
   }
+  rec.pass     = CR_RESIDUAL;
+  rec.residual = residual_even;
+  rec.weight   = FRowScale;
+  rec.ek       = 1;
+  rec.factor   = -1;
+  thread_run(threads, CurtisReidColumns, &rec);
 
   /* Compute sk */
   sk = 0;
@@ -244,11 +378,10 @@ int CurtisReidScales(lprec *lp, MYBOOL _Advanced, REAL *FRowScale, REAL *FColSca
   for(col = 1; col <= colMax; col++)
     sk += (residual_even[col]*residual_even[col]) / (REAL) ColCount[col];
 
-  Result = 0;
   qk=1; qkm1=0; qkm2=0;
   ek=0; ekm1=0; ekm2=0;
 
-  while(sk>StopTolerance) {
+  while((sk>StopTolerance) && (Result < SCALE_CRMAXPASS)) {
   /* Given the values of residual and sk, construct
      ColScale (when pass is even)
      RowScale (when pass is odd)  */
@@ -257,47 +390,44 @@ int CurtisReidScales(lprec *lp, MYBOOL _Advanced, REAL *FRowScale, REAL *FColSca
     ekekm1 = ek * ekm1;
     if((Result % 2) == 0) { /* pass is even; construct RowScale[pass+1] */
       if(Result != 0) {
-        for(row = 0; row <= lp->rows; row++)
+        for(row = 0; row <= lp->rows; row++) {
           RowScalem2[row] = FRowScale[row];
-        if(qkqkm1 != 0) {
-          for(row = 0; row <= lp->rows; row++)
+          if(qkqkm1 != 0) {
             FRowScale[row]*=(1 + ekekm1 / qkqkm1);
-          for(row = 0; row<=lp->rows; row++)
             FRowScale[row]+=(residual_odd[row] / (qkqkm1 * (REAL) RowCount[row]) -
                              RowScalem2[row] * ekekm1 / qkqkm1);
+          }
         }
       }
     }
     else { /* pass is odd; construct ColScale[pass+1] */
-      for(col = 1; col <= colMax; col++)
+      for(col = 1; col <= colMax; col++) {
         ColScalem2[col] = FColScale[col];
-      if(qkqkm1 != 0) {
-        for(col = 1; col <= colMax; col++)
+        if(qkqkm1 != 0) {
           FColScale[col] *= (1 + ekekm1 / qkqkm1);
-        for(col = 1; col <= colMax; col++)
           FColScale[col] += (residual_even[col] / ((REAL) ColCount[col] * qkqkm1) -
                              ColScalem2[col] * ekekm1 / qkqkm1);
+        }
       }
     }
 
     /* update residual and sk (pass + 1) */
+    rec.ek     = ek;
+    rec.factor = -1 / qk;
+    rec.weight = weight;
     if((Result % 2) == 0) { /* even */
-       /* residual */
-      for(row = 0; row <= lp->rows; row++)
-        residual_odd[row] *= ek;
+      /* residual = -(ek residual + E N-1 residual_even) / qk */
+      for(col = 1; col <= colMax; col++)
+        weight[col] = residual_even[col] / (REAL) ColCount[col];
 
+      absvalue = residual_odd[0] * ek;
       for(i = 1; i <= colMax; i++)
         if(lp->orig_obj[i] != 0)
-          residual_odd[0] += (residual_even[i] / (REAL) ColCount[i]);
+          absvalue += weight[i];
+      residual_odd[0] = absvalue * rec.factor;
 
-      rownr = &(COL_MAT_ROWNR(0));
-      colnr = &(COL_MAT_COLNR(0));
-      for(i = 0; i < nz;
-          i++, rownr += matRowColStep, colnr += matRowColStep) {
-        residual_odd[*rownr] += (residual_even[*colnr] / (REAL) ColCount[*colnr]);
-      }
-      for(row = 0; row <= lp->rows; row++)
-        residual_odd[row] *= (-1 / qk);
+      rec.residual = residual_odd;
+      thread_run(threads, CurtisReidRows, &rec);
 
       /* sk */
       skm1 = sk;
@@ -306,22 +436,12 @@ int CurtisReidScales(lprec *lp, MYBOOL _Advanced, REAL *FRowScale, REAL *FColSca
         sk += (residual_odd[row]*residual_odd[row]) / (REAL) RowCount[row];
     }
     else { /* odd */
-      /* residual */
-      for(col = 1; col <= colMax; col++)
-        residual_even[col] *= ek;
-
-      for(i = 1; i <= colMax; i++)
-        if(lp->orig_obj[i] != 0)
-          residual_even[i] += (residual_odd[0] / (REAL) RowCount[0]);
+      /* residual = -(ek residual + E^T M-1 residual_odd) / qk */
+      for(row = 0; row <= lp->rows; row++)
+        weight[row] = residual_odd[row] / (REAL) RowCount[row];
 
-      rownr = &(COL_MAT_ROWNR(0));
-      colnr = &(COL_MAT_COLNR(0));
-      for(i = 0; i < nz;
-          i++, rownr += matRowColStep, colnr += matRowColStep) {
-        residual_even[*colnr] += (residual_odd[*rownr] / (REAL) RowCount[*rownr]);
-      }
-      for(col = 1; col <= colMax; col++)
-        residual_even[col] *= (-1 / qk);
+      rec.residual = residual_even;
+      thread_run(threads, CurtisReidColumns, &rec);
 
       /* sk */
       skm1 = sk;
@@ -426,6 +546,7 @@ int CurtisReidScales(lprec *lp, MYBOOL _Advanced, REAL *FRowScale, REAL *FColSca
   }
 
  /* free temporary memory */
+Finish:
   FREE(RowSum);
   FREE(ColSum);
   FREE(RowCount);
@@ -434,6 +555,7 @@ int CurtisReidScales(lprec *lp, MYBOOL _Advanced, REAL *FRowScale, REAL *FColSca
   FREE(residual_odd);
   FREE(RowScalem2);
   FREE(ColScalem2);
+  FREE(weight);
 
   return(Result);
 
@@ -557,8 +679,8 @@ STATIC REAL roundPower2(REAL scale)
    with binary number representation, this avoids rounding errors when
    scale is used to normalize another value */
 {
-  long int power2;
-  MYBOOL   isSmall = FALSE;
+  int    power2;
+  MYBOOL isSmall = FALSE;
 
   if(scale == 1)
     return( scale );
@@ -570,13 +692,14 @@ STATIC REAL roundPower2(REAL scale)
   }
   else
     scale /= 2;
-  scale = log(scale)/log(2.0);
 
-  /* Find the desired nearest power of two and compute the associated scalar */
-  power2 = (long) ceil(scale-0.5);
-  scale = 1 << power2;
-  if(isSmall)
-    scale = 1.0 / scale;
+  /* Find the nearest power of two from the binary exponent and mantissa
+     directly; scale = m * 2^power2 with 0.5 <= m < 1, which rounds up to
+     2^power2 when m is above the geometric midpoint sqrt(0.5) */
+  scale = frexp(scale, &power2);
+  if(scale <= 0.70710678118654752440)
+    power2--;
+  scale = ldexp(1.0, (isSmall ? -power2 : power2));
 
   return( scale );
 
@@ -627,13 +750,137 @@ STATIC MYBOOL scale_updaterows(lprec *lp, REAL *scalechange, MYBOOL updateonly)
   return( TRUE );
 }
 
-STATIC MYBOOL scale_columns(lprec *lp, REAL *scaledelta)
+/* Data shared by the threads of the row, column and matrix scaling passes;
+   each thread owns a contiguous range of rows or columns, so the results do
+   not depend on the number of threads */
+typedef struct _scalepass
+{
+  lprec     *lp;
+  REAL      *min, *max;
+  REAL      *rowscale, *colscale;
+} scalepass;
+
+/* Accumulate the scaling statistics of rows by their row-ordered elements;
+   these come in increasing column order, as in the serial column scan */
+STATIC void scale_rowthread(void *data, int threadnr, int threadcount)
 {
-  int     i,j, colMax, nz;
+  scalepass *rec = (scalepass *) data;
+  lprec     *lp = rec->lp;
+  MATrec    *mat = lp->matA;
+  int       i, ix, ie, lo, hi, *rownr;
+  REAL      *value;
+
+  /* A single thread scans the columns in storage order */
+  if(threadcount == 1) {
+    value = &(COL_MAT_VALUE(0));
+    rownr = &(COL_MAT_ROWNR(0));
+    for(i = 1, ix = 0; i <= lp->columns; i++) {
+      ie = mat->col_end[i];
+      for(; ix < ie;
+          ix++, value += matValueStep, rownr += matRowColStep)
+        accumulate_for_scale(lp, &rec->min[*rownr], &rec->max[*rownr],
+                             scaled_mat(lp, *value, *rownr, i));
+    }
+    return;
+  }
+
+  thread_partition(threadnr, threadcount, 1, lp->rows, &lo, &hi);
+  for(i = lo; i <= hi; i++) {
+    ie = mat->row_end[i];
+    for(ix = mat->row_end[i-1]; ix < ie; ix++)
+      accumulate_for_scale(lp, &rec->min[i], &rec->max[i],
+                           scaled_mat(lp, ROW_MAT_VALUE(ix), i, ROW_MAT_COLNR(ix)));
+  }
+}
+
+/* Compute the scale factors of columns into rec->colscale */
+STATIC void scale_colthread(void *data, int threadnr, int threadcount)
+{
+  scalepass *rec = (scalepass *) data;
+  lprec     *lp = rec->lp;
+  MATrec    *mat = lp->matA;
+  int       i, j, nz, lo, hi, *rownr;
+  REAL      col_max, col_min, absval, *value;
+
+  thread_partition(threadnr, threadcount, 1, lp->columns, &lo, &hi);
+  for(j = lo; j <= hi; j++) {
+    if(is_int(lp,j) && !is_integerscaling(lp)) { /* do not scale integer columns */
+      rec->colscale[j] = 1;
+      continue;
+    }
+    col_max = 0;
+    if(is_scaletype(lp, SCALE_MEAN))
+      col_min = 0;
+    else
+      col_min = lp->infinite;
+
+    absval = lp->orig_obj[j];
+    if(absval != 0) {
+      absval = scaled_mat(lp, absval, 0, j);
+      accumulate_for_scale(lp, &col_min, &col_max, absval);
+    }
+
+    i = mat->col_end[j - 1];
+    value = &(COL_MAT_VALUE(i));
+    rownr = &(COL_MAT_ROWNR(i));
+    nz = mat->col_end[j];
+    for(; i < nz;
+        i++, value += matValueStep, rownr += matRowColStep) {
+      absval = scaled_mat(lp, *value, *rownr, j);
+      accumulate_for_scale(lp, &col_min, &col_max, absval);
+    }
+    nz = mat_collength(lp->matA, j);
+    if(fabs(lp->orig_obj[j]) > 0)
+      nz++;
+    rec->colscale[j] = minmax_to_scale(lp, col_min, col_max, nz);
+  }
+}
+
+/* Multiply the matrix elements by the row scalars and then the column scalars */
+STATIC void scale_matrixthread(void *data, int threadnr, int threadcount)
+{
+  scalepass *rec = (scalepass *) data;
+  MATrec    *mat = rec->lp->matA;
+  REAL      *rowscale = rec->rowscale, *colscale = rec->colscale, *value;
+  int       i, j, nz, lo, hi, *rownr;
+
+  thread_partition(threadnr, threadcount, 1, rec->lp->columns, &lo, &hi);
+  i = mat->col_end[lo - 1];
+  value = &(COL_MAT_VALUE(i));
+  rownr = &(COL_MAT_ROWNR(i));
+  for(j = lo; j <= hi; j++) {
+    nz = mat->col_end[j];
+    if(colscale == NULL)
+      for(; i < nz; i++, value += matValueStep, rownr += matRowColStep)
+        (*value) *= rowscale[*rownr];
+    else if(rowscale == NULL)
+      for(; i < nz; i++, value += matValueStep)
+        (*value) *= colscale[j];
+    else
+      for(; i < nz; i++, value += matValueStep, rownr += matRowColStep)
+        (*value) = ((*value) * rowscale[*rownr]) * colscale[j];
+  }
+}
+
+/* Apply row and/or column scalars to the constraint matrix in a single pass */
+STATIC void scale_matrix(lprec *lp, REAL *rowscale, REAL *colscale)
+{
+  scalepass rec;
+
+  if((rowscale == NULL) && (colscale == NULL))
+    return;
+  mat_validate(lp->matA);
+  rec.lp       = lp;
+  rec.rowscale = rowscale;
+  rec.colscale = colscale;
+  thread_run(scale_threads(lp), scale_matrixthread, &rec);
+  lp->matA->row_copy_valid = FALSE;
+}
+
+STATIC MYBOOL scale_columns(lprec *lp, REAL *scaledelta, MYBOOL updatematrix)
+{
+  int     i,j, colMax;
   REAL    *scalechange;
-  REAL    *value;
-  int     *colnr;
-  MATrec  *mat = lp->matA;
 
   /* Check that columns are in fact targeted */
   if((lp->scalemode & SCALE_ROWSONLY) != 0)
@@ -650,15 +897,8 @@ STATIC MYBOOL scale_columns(lprec *lp, REAL *scaledelta)
   for(i = 1; i <= lp->columns; i++) {
     lp->orig_obj[i] *= scalechange[i];
   }
-
-  mat_validate(lp->matA);
-  nz = get_nonzeros(lp);
-  value = &(COL_MAT_VALUE(0));
-  colnr = &(COL_MAT_COLNR(0));
-  for(i = 0; i < nz;
-      i++, value += matValueStep, colnr += matRowColStep) {
-    (*value) *= scalechange[*colnr];
-  }
+  if(updatematrix)
+    scale_matrix(lp, NULL, scalechange);
 
   /* Scale variable bounds as well */
   for(i = 1, j = lp->rows + 1; j <= lp->sum; i++, j++) {
@@ -676,14 +916,10 @@ STATIC MYBOOL scale_columns(lprec *lp, REAL *scaledelta)
   return( TRUE );
 }
 
-STATIC MYBOOL scale_rows(lprec *lp, REAL *scaledelta)
+STATIC MYBOOL scale_rows(lprec *lp, REAL *scaledelta, MYBOOL updatematrix)
 {
-  int     i, j, nz, colMax;
+  int     i, j, colMax;
   REAL    *scalechange;
-  REAL    *value;
-  int     *rownr;
-  MATrec  *mat = lp->matA;
-
 
   /* Check that rows are in fact targeted */
   if((lp->scalemode & SCALE_COLSONLY) != 0)
@@ -701,13 +937,8 @@ STATIC MYBOOL scale_rows(lprec *lp, REAL *scaledelta)
     lp->orig_obj[i] *= scalechange[0];
   }
 
-  nz = get_nonzeros(lp);
-  value = &(COL_MAT_VALUE(0));
-  rownr = &(COL_MAT_ROWNR(0));
-  for(i = 0; i < nz;
-      i++, value += matValueStep, rownr += matRowColStep) {
-    (*value) *= scalechange[*rownr];
-  }
+  if(updatematrix)
+    scale_matrix(lp, scalechange, NULL);
 
   /* ...and scale the rhs and the row bounds (RANGES in MPS!!) */
   for(i = 0; i <= lp->rows; i++) {
@@ -732,13 +963,12 @@ STATIC MYBOOL scale_rows(lprec *lp, REAL *scaledelta)
 
 STATIC REAL scale(lprec *lp, REAL *scaledelta)
 {
-  int     i, j, nz, row_count, nzOF = 0;
+  int     i, j, nz, row_count, nzOF = 0, threads;
   REAL    *row_max, *row_min, *scalechange = NULL, absval;
   REAL    col_max, col_min;
   MYBOOL  rowscaled, colscaled;
   MATrec  *mat = lp->matA;
-  REAL    *value;
-  int     *rownr;
+  scalepass rec;
 
   if(is_scaletype(lp, SCALE_NONE))
     return(0.0);
@@ -766,6 +996,7 @@ STATIC REAL scale(lprec *lp, REAL *scaledelta)
   for(i = 0; i <= lp->sum; i++)
     scalechange[i] = 1;
 
+  threads = scale_threads(lp);
   row_count = lp->rows;
   allocREAL(lp, &row_max, row_count + 1, TRUE);
   allocREAL(lp, &row_min, row_count + 1, FALSE);
@@ -778,26 +1009,21 @@ STATIC REAL scale(lprec *lp, REAL *scaledelta)
       row_min[i] = lp->infinite;  /* Carries the minimum element */
   }
 
-  /* Calculate row scaling data */
+  /* Calculate row scaling data; the objective row here, the constraint rows
+     by ranges of the row-ordered matrix */
   for(j = 1; j <= lp->columns; j++) {
-
     absval = lp->orig_obj[j];
     if(absval != 0) {
       absval = scaled_mat(lp, absval, 0, j);
       accumulate_for_scale(lp, &row_min[0], &row_max[0], absval);
       nzOF++;
     }
-
-    i = mat->col_end[j - 1];
-    value = &(COL_MAT_VALUE(i));
-    rownr = &(COL_MAT_ROWNR(i));
-    nz = mat->col_end[j];
-    for(; i < nz;
-        i++, value += matValueStep, rownr += matRowColStep) {
-      absval = scaled_mat(lp, *value, *rownr, j);
-      accumulate_for_scale(lp, &row_min[*rownr], &row_max[*rownr], absval);
-    }
   }
+  mat_validate(mat);
+  rec.lp  = lp;
+  rec.min = row_min;
+  rec.max = row_max;
+  thread_run(threads, scale_rowthread, &rec);
 
   /* Calculate scale factors for rows */
   i = 0;
@@ -819,39 +1045,8 @@ STATIC REAL scale(lprec *lp, REAL *scaledelta)
   rowscaled = scale_updaterows(lp, scalechange, TRUE);
 
   /* Calculate column scales */
-  i = 1;
-  for(j = 1; j <= lp->columns; j++) {
-    if(is_int(lp,j) && !is_integerscaling(lp)) { /* do not scale integer columns */
-      scalechange[lp->rows + j] = 1;
-    }
-    else {
-      col_max = 0;
-      if(is_scaletype(lp, SCALE_MEAN))
-        col_min = 0;
-      else
-        col_min = lp->infinite;
-
-      absval = lp->orig_obj[j];
-      if(absval != 0) {
-        absval = scaled_mat(lp, absval, 0, j);
-        accumulate_for_scale(lp, &col_min, &col_max, absval);
-      }
-
-      i = mat->col_end[j - 1];
-      value = &(COL_MAT_VALUE(i));
-      rownr = &(COL_MAT_ROWNR(i));
-      nz = mat->col_end[j];
-      for(; i < nz;
-          i++, value += matValueStep, rownr += matRowColStep) {
-        absval = scaled_mat(lp, *value, *rownr, j);
-        accumulate_for_scale(lp, &col_min, &col_max, absval);
-      }
-      nz = mat_collength(lp->matA, j);
-      if(fabs(lp->orig_obj[j]) > 0)
-        nz++;
-      scalechange[lp->rows + j] = minmax_to_scale(lp, col_min, col_max, nz);
-    }
-  }
+  rec.colscale = &scalechange[lp->rows];
+  thread_run(threads, scale_colthread, &rec);
 
   /* ... and then column-scale the already row-scaled matrix */
   colscaled = scale_updatecolumns(lp, &scalechange[lp->rows], TRUE);
@@ -883,7 +1078,8 @@ STATIC REAL scale(lprec *lp, REAL *scaledelta)
 
 STATIC MYBOOL finalize_scaling(lprec *lp, REAL *scaledelta)
 {
-  int i;
+  int  i;
+  REAL *scalars;
 
   /* Check if we should equilibrate */
   if(is_scalemode(lp, SCALE_EQUILIBRATE) && !is_scaletype(lp, SCALE_CURTISREID)) {
@@ -897,7 +1093,6 @@ STATIC MYBOOL finalize_scaling(lprec *lp, REAL *scaledelta)
 
   /* Check if we should prevent rounding errors */
   if(is_scalemode(lp, SCALE_POWER2)) {
-    REAL *scalars;
     if(scaledelta == NULL)
       scalars = lp->scalars;
     else
@@ -907,8 +1102,12 @@ STATIC MYBOOL finalize_scaling(lprec *lp, REAL *scaledelta)
       scalars[i] = roundPower2(scalars[i]);
   }
 
-  /* Then transfer the scalars to the model's data */
-  return( scale_rows(lp, scaledelta) && scale_columns(lp, scaledelta) );
+  /* Then transfer the scalars to the model's data, with the matrix scaled
+     by rows and columns in a single pass */
+  scalars = (scaledelta == NULL ? lp->scalars : scaledelta);
+  scale_matrix(lp, ((lp->scalemode & SCALE_COLSONLY) != 0 ? NULL : scalars),
+                   ((lp->scalemode & SCALE_ROWSONLY) != 0 ? NULL : scalars + lp->rows));
+  return( scale_rows(lp, scaledelta, FALSE) && scale_columns(lp, scaledelta, FALSE) );
 
 }
 
@@ -1008,6 +1207,7 @@ STATIC void unscale_columns(lprec *lp)
       j++, value += matValueStep, rownr += matRowColStep, colnr += matRowColStep) {
     *value = unscaled_mat(lp, *value, *rownr, *colnr);
   }
+  mat->row_copy_valid = FALSE;
 
   /* Unscale bounds as well */
   for(i = lp->rows + 1, j = 1; i <= lp->sum; i++, j++) {
@@ -1047,6 +1247,7 @@ void undoscale(lprec *lp)
         j++, value += matValueStep, rownr += matRowColStep, colnr += matRowColStep) {
       *value = unscaled_mat(lp, *value, *rownr, *colnr);
     }
+    mat->row_copy_valid = FALSE;
 
     /* Unscale variable bounds */
     for(i = lp->rows + 1, j = 1; i <= lp->sum; i++, j++) {
@@ -3,6 +3,9 @@
 
 #include "lp_types.h"
 
+#define SCALE_PARALLELMIN     65536    /* Minimum non-zero count for multi-threaded scaling passes */
+#define SCALE_CRMAXPASS         200    /* Safeguard on the number of Curtis-Reid CG passes */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -10,8 +13,9 @@ extern "C" {
 /* Put function headers here */
 STATIC MYBOOL scale_updatecolumns(lprec *lp, REAL *scalechange, MYBOOL updateonly);
 STATIC MYBOOL scale_updaterows(lprec *lp, REAL *scalechange, MYBOOL updateonly);
-STATIC MYBOOL scale_rows(lprec *lp, REAL *scaledelta);
-STATIC MYBOOL scale_columns(lprec *lp, REAL *scaledelta);
+STATIC MYBOOL scale_rows(lprec *lp, REAL *scaledelta, MYBOOL updatematrix);
+STATIC MYBOOL scale_columns(lprec *lp, REAL *scaledelta, MYBOOL updatematrix);
+STATIC void scale_matrix(lprec *lp, REAL *rowscale, REAL *colscale);
 STATIC void unscale_columns(lprec *lp);
 STATIC REAL scale(lprec *lp, REAL *scaledelta);
 STATIC REAL scaled_mat(lprec *lp, REAL value, int rownr, int colnr);
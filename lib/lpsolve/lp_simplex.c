@@ -33,6 +33,7 @@
 #include "lp_price.h"
 #include "lp_pricePSE.h"
 #include "lp_report.h"
+#include "mythread.h"
 
 #ifdef FORTIFY
 # include "lp_fortify.h"
@@ -113,8 +114,15 @@ STATIC MYBOOL stallMonitor_create(lprec *lp, MYBOOL isdual, char *funcname)
   strcpy(monitor->spxfunc, funcname);
   monitor->isdual = isdual;
   monitor->pivdynamic = is_piv_mode(lp, PRICE_ADAPTIVE);
+  monitor->orgpivstrategy = lp->piv_strategy;
   monitor->oldpivstrategy = lp->piv_strategy;
   monitor->oldpivrule = get_piv_rule(lp);
+  monitor->pivhybrid = (MYBOOL) (is_piv_mode(lp, PRICE_HYBRID) &&
+                                 ((monitor->oldpivrule == PRICER_DEVEX) ||
+                                  (monitor->oldpivrule == PRICER_STEEPESTEDGE)) &&
+                                 (isdual || !is_piv_mode(lp, PRICE_PRIMALFALLBACK)));
+  monitor->hybridstart = timeNow();
+  monitor->hybridobj = lp->rhs[0];
   if(MAX_STALLCOUNT <= 1)
     monitor->limitstall[FALSE] = 0;
   else
@@ -138,6 +146,73 @@ STATIC MYBOOL stallMonitor_create(lprec *lp, MYBOOL isdual, char *funcname)
   return( TRUE );
 }
 
+STATIC void stallMonitor_hybrid(lprec *lp, MYBOOL isStalled, MYBOOL approved)
+/* PRICE_HYBRID: at the end of each window of HYBRID_WINDOW iterations,
+   change from Devex to Steepest Edge if many iterations were degenerate
+   or the loop runs long, and back to Devex if the norm updates take up
+   too much of the measured time or if the objective progresses slower
+   per second than it did with Devex; timing is accumulated over several
+   windows when needed to get above the timer resolution */
+{
+  OBJmonrec *monitor = lp->monitor;
+  int       newrule;
+  REAL      elapsed, degenshare, costshare, *rate;
+  MYBOOL    timed;
+
+  if(!monitor->pivhybrid)
+    return;
+  monitor->hybriditer++;
+  if(isStalled)
+    monitor->hybriddegen++;
+  if(monitor->hybriditer < HYBRID_WINDOW)
+    return;
+
+  elapsed    = timeNow() - monitor->hybridstart;
+  degenshare = (REAL) monitor->hybriddegen / monitor->hybriditer;
+  timed      = (MYBOOL) (elapsed >= HYBRID_MINTIME);
+  costshare  = (timed ? monitor->hybridnormtime / elapsed : 0);
+  newrule    = monitor->pivrule;
+  rate       = monitor->hybridrate;
+  if(timed)
+    rate[newrule == PRICER_STEEPESTEDGE] = fabs(lp->rhs[0] - monitor->hybridobj) / elapsed;
+
+  /* Leave the rule alone while an anti-degeneracy rule switch is active */
+  if(approved && (monitor->pivrule == monitor->oldpivrule) &&
+     (monitor->hybridswitches < HYBRID_MAXSWITCH)) {
+    if(newrule == PRICER_DEVEX) {
+      if((degenshare > HYBRID_DEGENLIMIT) ||
+         (!monitor->hybridcostly && (monitor->Icount > HYBRID_ITERFACTOR*(lp->rows+1))))
+        newrule = PRICER_STEEPESTEDGE;
+    }
+    else if(((costshare > HYBRID_COSTLIMIT) || (timed && (rate[TRUE] < rate[FALSE]))) &&
+            (degenshare < HYBRID_DEGENLIMIT/2)) {
+      newrule = PRICER_DEVEX;
+      monitor->hybridcostly = TRUE;
+    }
+    if(newrule != monitor->pivrule) {
+      lp->piv_strategy += newrule - monitor->pivrule;
+      monitor->oldpivstrategy = lp->piv_strategy;
+      monitor->oldpivrule = newrule;
+      monitor->pivrule = newrule;
+      monitor->hybridswitches++;
+      restartPricer(lp, AUTOMATIC);
+      timed = TRUE;
+      report(lp, DETAILED, "%s: Hybrid pricing changed to '%s' at iter %.0f (%.0f%% degenerate, %.0f%% norm update time).\n",
+                           monitor->spxfunc, get_str_piv_rule(newrule), (double) get_total_iter(lp),
+                           100*degenshare, 100*costshare);
+    }
+  }
+
+  /* Start a new measurement window */
+  monitor->hybriditer = 0;
+  monitor->hybriddegen = 0;
+  if(timed) {
+    monitor->hybridnormtime = 0;
+    monitor->hybridstart = timeNow();
+    monitor->hybridobj = lp->rhs[0];
+  }
+}
+
 STATIC MYBOOL stallMonitor_check(lprec *lp, int rownr, int colnr, int lastnr,
                                  MYBOOL minit, MYBOOL approved, MYBOOL *forceoutEQ)
 {
@@ -210,6 +285,8 @@ STATIC MYBOOL stallMonitor_check(lprec *lp, int rownr, int colnr, int lastnr,
     CLEARMASK(lp->piv_strategy, PRICE_NOBOUNDFLIP);
 #endif
 
+  stallMonitor_hybrid(lp, isStalled, approved);
+
 #if 1
   isCreeping = FALSE;
 #else
@@ -332,8 +409,8 @@ STATIC void stallMonitor_finish(lprec *lp)
   OBJmonrec *monitor = lp->monitor;
   if(monitor == NULL)
     return;
-  if(lp->piv_strategy != monitor->oldpivstrategy)
-    lp->piv_strategy = monitor->oldpivstrategy;
+  if(lp->piv_strategy != monitor->orgpivstrategy)
+    lp->piv_strategy = monitor->orgpivstrategy;
   FREE(monitor);
   lp->monitor = NULL;
 }
@@ -446,6 +523,24 @@ STATIC MYBOOL add_artificial(lprec *lp, int forrownr, REAL *nzarray, int *idxarr
 
 }
 
+STATIC MYBOOL canadd_artificials(lprec *lp)
+/* The artificial variables of primal phase 1 are singletons that replace
+   infeasible basic slacks, which requires that every infeasible basic
+   variable is the slack of its own basis row.  This holds for the default
+   slack basis, but not necessarily for a crashed or user-provided basis, or
+   for a B&B node whose root relaxation was not solved by primloop (so that
+   ForceDualSimplexInBB did not switch phase 1 to the dual); add_artificial
+   would then substitute a basic user variable and phase 1 fails */
+{
+  int i;
+
+  for(i = 1; i <= lp->rows; i++) {
+    if((lp->var_basic[i] != i) && !isBasisVarFeasible(lp, lp->epspivot, i))
+      return( FALSE );
+  }
+  return( TRUE );
+}
+
 STATIC int get_artificialRow(lprec *lp, int colnr)
 {
   MATrec *mat = lp->matA;
@@ -513,12 +608,15 @@ STATIC void eliminate_artificials(lprec *lp, REAL *prow)
       continue;
     j -= lp->rows;
     rownr = get_artificialRow(lp, j);
-    colnr = find_rowReplacement(lp, rownr, prow, NULL);
 #if 0
-    performiteration(lp, rownr, colnr, 0.0, TRUE, FALSE, prow, NULL,
-                                                          NULL, NULL, NULL);
+    colnr = find_rowReplacement(lp, i, prow, NULL);
+    performiteration(lp, i, colnr, 0.0, TRUE, FALSE, prow, NULL,
+                                                     NULL, NULL, NULL);
 #else
-    set_basisvar(lp, rownr, colnr);
+    /* The artificial and the slack of its row are both unit columns in that row,
+       so the slack takes its basis position without making the basis singular */
+    colnr = rownr;
+    set_basisvar(lp, i, colnr);
 #endif
     del_column(lp, j);
     P1extraDim--;
@@ -1032,8 +1130,13 @@ STATIC int dualloop(lprec *lp, MYBOOL dualfeasible, int dualinfeasibles[], REAL
   longsteps = (MYBOOL) ((MIP_count(lp) > 0) && (lp->bb_level > 1));
 #elif 0
   longsteps = (MYBOOL) ((MIP_count(lp) > 0) && (lp->solutioncount >= 1));
-#else
+#elif 0
   longsteps = FALSE;
+#else
+  /* Use the bound-flipping ratio test if asked to and there are variables to
+     flip; the objective value update of the bound flips requires the OF in the basis */
+  longsteps = (MYBOOL) (is_piv_mode(lp, PRICE_LONGSTEPDUAL) &&
+                        (lp->boundedvars > 0) && lp->obj_in_basis);
 #endif
 #ifdef UseLongStepDualPhase1
   longsteps = !dualfeasible && (MYBOOL) (dualinfeasibles != NULL);
@@ -1042,7 +1145,11 @@ STATIC int dualloop(lprec *lp, MYBOOL dualfeasible, int dualinfeasibles[], REAL
   if(longsteps) {
     lp->longsteps = multi_create(lp, TRUE);
     ok = (lp->longsteps != NULL) &&
+#ifdef UseLongStepDualPhase1
          multi_resize(lp->longsteps, MIN(lp->boundedvars+2, 11), 1, TRUE, TRUE);
+#else
+         multi_resize(lp->longsteps, lp->boundedvars+2, 1, FALSE, TRUE);
+#endif
     if(!ok)
       goto Finish;
 #ifdef UseLongStepPruning
@@ -1261,8 +1368,8 @@ RetryRow:
         }
 
 #ifdef dual_UseRejectionList
-        /* Check for pivot size issues */
-        else if(lp->rejectpivot[0] < DEF_MAXPIVOTRETRY) {
+        /* Check for pivot size issues, unless the long-step ratio test proved the row infeasible */
+        else if((lp->spx_status == RUNNING) && (lp->rejectpivot[0] < DEF_MAXPIVOTRETRY)) {
           lp->spx_status = RUNNING;
           lp->rejectpivot[0]++;
           lp->rejectpivot[lp->rejectpivot[0]] = rownr;
@@ -1272,7 +1379,7 @@ RetryRow:
         }
 #endif
         /* Check if we may have lost dual feasibility if we also did phase 1 here */
-        else if(dualphase1 && (dualoffset != 0)) {
+        else if((lp->spx_status == RUNNING) && dualphase1 && (dualoffset != 0)) {
           lp->spx_status = LOSTFEAS;
           if((lp->spx_trace && (lp->bb_totalnodes == 0)) ||
              (lp->bb_trace && (lp->bb_totalnodes > 0)))
@@ -1283,7 +1390,7 @@ RetryRow:
 
         /* Otherwise just determine that we are infeasible */
         else {
-          if(lp->spx_status == RUNNING) {
+          if((lp->spx_status == RUNNING) || (lp->spx_status == INFEASIBLE)) {
 #if 1
             if(xviolated < lp->epspivot) {
               if(lp->bb_trace || (lp->bb_totalnodes == 0))
@@ -1530,6 +1637,7 @@ STATIC int spx_run(lprec *lp, MYBOOL validInvB)
 
   lp->current_iter  = 0;
   lp->current_bswap = 0;
+  lp->current_longswap = 0;
   lp->spx_status    = RUNNING;
   lp->bb_status = lp->spx_status;
   lp->P1extraDim = 0;
@@ -1604,10 +1712,12 @@ STATIC int spx_run(lprec *lp, MYBOOL validInvB)
         report(lp, NORMAL, "Start at infeasible basis\n");
     }
 
-   /* Now do the simplex magic */
-    if(((lp->simplex_strategy & SIMPLEX_Phase1_DUAL) == 0) ||
-       ((MIP_count(lp) > 0) && (lp->total_iter == 0) &&
-        is_presolve(lp, PRESOLVE_REDUCEMIP))) {
+   /* Now do the simplex magic; an infeasible basis that primal phase 1 cannot
+      cover by artificial variables is made feasible by the dual phase 1 */
+    if((((lp->simplex_strategy & SIMPLEX_Phase1_DUAL) == 0) ||
+        ((MIP_count(lp) > 0) && (lp->total_iter == 0) &&
+         is_presolve(lp, PRESOLVE_REDUCEMIP))) &&
+       (primalfeasible || canadd_artificials(lp))) {
       if(!lost_feas_state && primalfeasible && ((lp->simplex_strategy & SIMPLEX_Phase2_DUAL) > 0))
         lp->spx_status = SWITCH_TO_DUAL;
       else
@@ -1690,6 +1800,8 @@ STATIC int spx_run(lprec *lp, MYBOOL validInvB)
   lp->current_iter  = 0;
   lp->total_bswap  += lp->current_bswap;
   lp->current_bswap = 0;
+  lp->total_longswap += lp->current_longswap;
+  lp->current_longswap = 0;
   FREE(infeasibles);
 
   return(lp->spx_status);
@@ -2036,6 +2148,7 @@ STATIC int spx_solve(lprec *lp)
 
   lp->total_iter       = 0;
   lp->total_bswap      = 0;
+  lp->total_longswap   = 0;
   lp->perturb_count    = 0;
   lp->bb_maxlevel      = 1;
   lp->bb_totalnodes    = 0;
@@ -2056,10 +2169,27 @@ STATIC int spx_solve(lprec *lp)
   else if(lp->spx_status != RUNNING)
     goto Leave;
 
+  /* Optionally race simplex variants in parallel on the presolved model; an
+     infeasible or unbounded outcome is final, while an optimal basis is taken
+     over, so that the regular solve below only has to confirm it */
+  status = concurrent_solve(lp);
+  if((status == INFEASIBLE) || (status == UNBOUNDED)) {
+    lp->spx_status = status;
+    lp->bb_status  = status;
+    report(lp, NORMAL, "The model %s\n",
+                       (status == UNBOUNDED) ? "is UNBOUNDED" : "is INFEASIBLE");
+    goto Reconstruct;
+  }
+
   iprocessed = !lp->wasPreprocessed;
   if(!preprocess(lp) || userabort(lp, -1))
     goto Leave;
 
+  /* Keep a full row-ordered copy of a larger constraint matrix when the
+     dual simplex, which works with pivot rows, is used in either phase */
+  mat_setrowaccess(lp->matA, (((lp->simplex_strategy & (SIMPLEX_Phase1_DUAL | SIMPLEX_Phase2_DUAL)) != 0) &&
+                              (mat_nonzeros(lp->matA) >= MAT_ROWCOPYMIN) ? RAM_FullCopy : RAM_Index));
+
   if(mat_validate(lp->matA)) {
 
     /* Do standard initializations */
@@ -2071,6 +2201,7 @@ STATIC int spx_solve(lprec *lp)
     /* Do the call to the real underlying solver (note that
        run_BB is replaceable with any compatible MIP solver) */
     status = run_BB(lp);
+    mat_setrowaccess(lp->matA, RAM_Index);
 
     /* Restore modified problem */
     if(iprocessed)
@@ -2105,12 +2236,16 @@ Leave:
                         MAJORVERSION, MINORVERSION, RELEASE, BUILD, 8*sizeof(void *), 8*sizeof(REAL));
     report(lp, NORMAL, "      In the total iteration count %.0f, %.0f (%.1f%%) were bound flips.\n",
                         (double) lp->total_iter, (double) lp->total_bswap, test);
+    if(lp->total_longswap > 0)
+      report(lp, NORMAL, "      The long-step dual ratio test made another %.0f bound flips.\n",
+                          (double) lp->total_longswap);
     report(lp, NORMAL, "      There were %d refactorizations, %d triggered by time and %d by density.\n",
                         lp->bfp_refactcount(lp, BFP_STAT_REFACT_TOTAL),
                         lp->bfp_refactcount(lp, BFP_STAT_REFACT_TIMED),
                         lp->bfp_refactcount(lp, BFP_STAT_REFACT_DENSE));
-    report(lp, NORMAL, "       ... on average %.1f major pivots per refactorization.\n",
-                        get_refactfrequency(lp, TRUE));
+    report(lp, NORMAL, "       ... on average %.1f major pivots per refactorization (%s updates).\n",
+                        get_refactfrequency(lp, TRUE),
+                        (lp->bfp_mode == BFPMODE_FORRESTTOMLIN ? "Forrest-Tomlin" : "Bartels-Golub"));
     report(lp, NORMAL, "      The largest [%s] fact(B) had %d NZ entries, %.1fx largest basis.\n",
                         lp->bfp_name(), itemp, lp->bfp_efficiency(lp));
     if(lp->perturb_count > 0)
@@ -2138,6 +2273,144 @@ Leave:
 
 } /* spx_solve */
 
+/* Simplex variants raced by concurrent_solve(); the first racer always
+   uses the settings of the model itself */
+static int concurrentrule[][2] = {
+  { SIMPLEX_PRIMAL_PRIMAL, PRICER_DEVEX + PRICE_ADAPTIVE },
+  { SIMPLEX_DUAL_DUAL,     PRICER_STEEPESTEDGE + PRICE_ADAPTIVE },
+  { SIMPLEX_DUAL_PRIMAL,   PRICER_DEVEX + PRICE_ADAPTIVE },
+  { SIMPLEX_PRIMAL_DUAL,   PRICER_DEVEX + PRICE_ADAPTIVE },
+  { SIMPLEX_DUAL_PRIMAL,   PRICER_STEEPESTEDGE + PRICE_ADAPTIVE },
+  { SIMPLEX_PRIMAL_PRIMAL, PRICER_DANTZIG + PRICE_ADAPTIVE }
+};
+
+typedef struct _concurrentrec
+{
+  lprec      **racelp;       /* Thread-private copies of the model */
+  int        *status;        /* Solve status of each racer */
+  threadlock *lock;
+  volatile int winner;       /* Index of the first racer to finish, -1 while running */
+} concurrentrec;
+
+static int __WINAPI concurrent_abort(lprec *lp, void *userhandle)
+{
+  concurrentrec *race = (concurrentrec *) userhandle;
+
+  return( (int) (race->winner >= 0) );
+}
+
+STATIC void concurrent_run(void *data, int threadnr, int threadcount)
+{
+  concurrentrec *race = (concurrentrec *) data;
+  int           status;
+
+  status = solve(race->racelp[threadnr]);
+  race->status[threadnr] = status;
+  if((status == OPTIMAL) || (status == INFEASIBLE) || (status == UNBOUNDED)) {
+    thread_lock(race->lock);
+    if(race->winner < 0)
+      race->winner = threadnr;
+    thread_unlock(race->lock);
+  }
+}
+
+STATIC MYBOOL concurrent_basis(lprec *target, lprec *source)
+/* Copy the basis between two models of the same dimensions; unlike get_basis()
+   and set_basis(), this also works when the models are presolved copies */
+{
+  if(!source->basis_valid ||
+     (target->rows != source->rows) || (target->sum != source->sum) ||
+     !verify_basis(source))
+    return( FALSE );
+
+  MEMCOPY(target->var_basic + 1, source->var_basic + 1, source->rows);
+  MEMCOPY(target->is_basic, source->is_basic, source->sum + 1);
+  MEMCOPY(target->is_lower, source->is_lower, source->sum + 1);
+  set_action(&target->spx_action, ACTION_REBASE | ACTION_REINVERT | ACTION_RECOMPUTE);
+  target->basis_valid  = TRUE;
+  target->var_basic[0] = FALSE;
+
+  return( TRUE );
+}
+
+STATIC int concurrent_solve(lprec *lp)
+/* Solve the (presolved) LP relaxation with several simplex variants on private
+   copies of the model, one per thread; the first racer to reach a final status
+   stops the others via the abort callback, and that status is returned.  If it
+   is optimal, the winning basis is installed in the model, so that the regular
+   simplex only has to refactorize and confirm it; NOTRUN is returned if no race
+   took place.  Note that the user callbacks are not called from the racers. */
+{
+  int           i, j, threads, status = NOTRUN;
+  concurrentrec race;
+  lprec         *hlp;
+
+  threads = MIN(lp->num_threads, 1 + sizeof(concurrentrule) / sizeof(*concurrentrule));
+  if((threads < 2) || ((lp->simplex_strategy & SIMPLEX_CONCURRENT) == 0) ||
+     (lp->bb_level > 0) || (lp->lag_status == RUNNING) ||
+     (lp->sc_vars > 0) || (SOS_count(lp) > 0) || (get_Lrows(lp) > 0))
+    return( status );
+
+  MEMCLEAR(&race, 1);
+  race.winner = -1;
+  if(!allocINT(lp, &race.status, threads, TRUE) ||
+     ((race.racelp = (lprec **) calloc(threads, sizeof(*race.racelp))) == NULL) ||
+     ((race.lock = thread_createlock()) == NULL))
+    goto Finish;
+
+  /* Create the racers with their respective simplex and pricing strategies */
+  for(i = 0; i < threads; i++) {
+    hlp = copy_lp(lp);
+    race.racelp[i] = hlp;
+    if(hlp == NULL)
+      goto Finish;
+    set_verbose(hlp, NEUTRAL);
+    set_threads(hlp, 1);
+    set_presolve(hlp, PRESOLVE_NONE, get_presolveloops(lp));
+    if(i == 0)
+      set_simplextype(hlp, lp->simplex_strategy & ~SIMPLEX_CONCURRENT);
+    else {
+      set_simplextype(hlp, concurrentrule[i-1][0]);
+      set_pivoting(hlp, concurrentrule[i-1][1]);
+    }
+    for(j = 1; j <= lp->columns; j++)
+      if(is_int(lp, j))
+        set_int(hlp, j, FALSE);
+    concurrent_basis(hlp, lp);
+    put_abortfunc(hlp, concurrent_abort, &race);
+  }
+
+  /* Run the race and take over the winner's status and basis */
+  thread_run(threads, concurrent_run, &race);
+  i = race.winner;
+  if(i >= 0) {
+    hlp = race.racelp[i];
+    status = race.status[i];
+    if((status == OPTIMAL) && !concurrent_basis(lp, hlp))
+      status = NOTRUN;
+    else {
+      lp->total_iter += get_total_iter(hlp);
+      report(lp, NORMAL, "concurrent_solve: %s-%s simplex with %s pricing won among %d racers after %.0f iter (%s).\n",
+                         my_simplexstr(hlp->simplex_strategy & SIMPLEX_Phase1_DUAL),
+                         my_simplexstr(hlp->simplex_strategy & SIMPLEX_Phase2_DUAL),
+                         get_str_piv_rule(get_piv_rule(hlp)), threads, (double) get_total_iter(hlp),
+                         get_statustext(lp, status));
+    }
+  }
+
+Finish:
+  if(race.racelp != NULL) {
+    for(i = 0; i < threads; i++)
+      if(race.racelp[i] != NULL)
+        delete_lp(race.racelp[i]);
+    FREE(race.racelp);
+  }
+  thread_freelock(&race.lock);
+  FREE(race.status);
+
+  return( status );
+}
+
 int lin_solve(lprec *lp)
 {
   int status = NOTRUN;
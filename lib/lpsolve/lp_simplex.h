@@ -24,6 +24,8 @@ STATIC int spx_run(lprec *lp, MYBOOL validInvB);
 STATIC int spx_solve(lprec *lp);
 STATIC int lag_solve(lprec *lp, REAL start_bound, int num_iter);
 STATIC int heuristics(lprec *lp, int mode);
+STATIC MYBOOL concurrent_basis(lprec *target, lprec *source);
+STATIC int concurrent_solve(lprec *lp);
 STATIC int lin_solve(lprec *lp);
 
 #ifdef __cplusplus
@@ -271,17 +271,20 @@ typedef struct _B4rec
 #define OBJ_STEPS   5
 typedef struct _OBJmonrec {
   lprec  *lp;
-  int    oldpivstrategy,
+  int    orgpivstrategy, oldpivstrategy,
          oldpivrule, pivrule, ruleswitches,
+         hybridswitches, hybriditer, hybriddegen,
          limitstall[2], limitruleswitches,
          idxstep[OBJ_STEPS], countstep, startstep, currentstep,
          Rcycle, Ccycle, Ncycle, Mcycle, Icount;
   REAL   thisobj, prevobj,
          objstep[OBJ_STEPS],
          thisinfeas, previnfeas,
+         hybridstart, hybridnormtime, hybridobj, hybridrate[2],
          epsvalue;
   char   spxfunc[10];
   MYBOOL pivdynamic;
+  MYBOOL pivhybrid, hybridcostly;
   MYBOOL isdual;
   MYBOOL active;
 } OBJmonrec;
@@ -287,13 +287,12 @@ STATIC char *mempool_obtainVector(workarraysrec *mempool, int count, int unitsiz
                                      sizeof(*(mempool->vectorsize))*mempool->size);
     }
     ie++;
-    i = ie + 1;
-    if(i < mempool->count) {
-      MEMMOVE(mempool->vectorarray+i, mempool->vectorarray+ie, 1);
-      MEMMOVE(mempool->vectorsize+i,  mempool->vectorsize+ie,  1);
+    if(ib < ie) {
+      MEMMOVE(mempool->vectorarray+ib+1, mempool->vectorarray+ib, ie-ib);
+      MEMMOVE(mempool->vectorsize+ib+1,  mempool->vectorsize+ib,  ie-ib);
     }
-    mempool->vectorarray[ie] = newmem;
-    mempool->vectorsize[ie]  = size;
+    mempool->vectorarray[ib] = newmem;
+    mempool->vectorsize[ib]  = size;
   }
 
   return( newmem );
@@ -5,6 +5,7 @@
 #include <string.h>
 #include <math.h>
 #include "myblas.h"
+#include "mythread.h"
 
 #ifdef FORTIFY
 # include "lp_fortify.h"
@@ -14,6 +15,7 @@
 /* Initialize BLAS interfacing routines                                     */
 /* ************************************************************************ */
 MYBOOL mustinitBLAS = TRUE;
+static threadonce onceBLAS = THREAD_ONCE_INIT;
 #ifdef WIN32
   HINSTANCE hBLAS = NULL;
 #else
@@ -34,16 +36,23 @@ BLAS_dload_func  *BLAS_dload;
 BLAS_dnormi_func *BLAS_dnormi;
 
 
+#include "myblas_simd.c"
+
+
 /* ************************************************************************ */
 /* Define the BLAS interfacing routines                                     */
 /* ************************************************************************ */
 
+static void once_BLAS(void)
+{
+  load_BLAS(NULL);
+  mustinitBLAS = FALSE;
+}
+
+/* Install the native routines the first time any thread gets here */
 void init_BLAS(void)
 {
-  if(mustinitBLAS) {
-    load_BLAS(NULL);
-    mustinitBLAS = FALSE;
-  }
+  thread_once(&onceBLAS, once_BLAS);
 }
 
 MYBOOL is_nativeBLAS(void)
@@ -81,6 +90,7 @@ MYBOOL load_BLAS(char *libname)
     BLAS_idamax = my_idamax;
     BLAS_dload = my_dload;
     BLAS_dnormi = my_dnormi;
+    simd_BLAS();
     if(mustinitBLAS)
       mustinitBLAS = FALSE;
   }
@@ -73,7 +73,13 @@ typedef double (BLAS_CALLMODEL BLAS_dnormi_func)(int *n, REAL *x);
 # endif
 #endif
 
+/* Vector instruction sets of the processor, as detected by init_BLAS */
+#define BLAS_SIMD_NONE    0
+#define BLAS_SIMD_AVX2    1
+#define BLAS_SIMD_AVX512  2
+
 void init_BLAS(void);
+int simd_levelBLAS(void);
 MYBOOL is_nativeBLAS(void);
 MYBOOL load_BLAS(char *libname);
 MYBOOL unload_BLAS(void);
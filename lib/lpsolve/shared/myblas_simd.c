@@ -0,0 +1,245 @@
+/* ************************************************************************ */
+/* Vectorized BLAS kernels and processor detection.  This file is included  */
+/* by myblas.c and by the LUSOL copy of it, after the function pointers    */
+/* have been defined; it is not compiled by itself.                        */
+/* ************************************************************************ */
+
+static int simdBLAS = BLAS_SIMD_NONE;
+
+/* ************************************************************************ */
+/* Vectorized unit-stride kernels, selected by load_BLAS() for the native   */
+/* library according to the instruction set of the processor.  Strided     */
+/* calls are passed on to the scalar versions.  The results are identical  */
+/* to those of the scalar versions, except for ddot that sums in lanes.    */
+/* ************************************************************************ */
+#if ((defined __GNUC__ && __GNUC__ >= 5) || (defined __clang__)) && \
+    ((defined __x86_64__) || (defined __i386__)) && !(defined NoBlasSIMD)
+  #define BlasSIMD
+  #if (defined __clang__) || (__GNUC__ >= 7)
+    #define BlasSIMD512
+  #endif
+  #include <immintrin.h>
+  /* Keep multiplications and additions separately rounded, as in the scalar code */
+  #ifdef __clang__
+    #pragma clang fp contract(off)
+    #define BlasTarget(isa) __attribute__((target(isa)))
+  #else
+    #define BlasTarget(isa) __attribute__((target(isa), optimize("fp-contract=off")))
+  #endif
+#endif
+
+#ifdef BlasSIMD
+BlasTarget("avx2")
+static void BLAS_CALLMODEL avx2_daxpy( int *_n, REAL *_da, REAL *dx, int *_incx, REAL *dy, int *_incy)
+{
+  int     i, n = *_n, n4 = n & ~3;
+  REAL    da = *_da;
+  __m256d va;
+
+  if((*_incx != 1) || (*_incy != 1) || (da == 0.0)) {
+    my_daxpy(_n, _da, dx, _incx, dy, _incy);
+    return;
+  }
+  va = _mm256_set1_pd(da);
+  for(i = 0; i < n4; i += 4)
+    _mm256_storeu_pd(dy+i, _mm256_add_pd(_mm256_loadu_pd(dy+i),
+                                         _mm256_mul_pd(va, _mm256_loadu_pd(dx+i))));
+  for(; i < n; i++)
+    dy[i] += da*dx[i];
+}
+
+BlasTarget("avx2")
+static void BLAS_CALLMODEL avx2_dscal( int *_n, REAL *_da, REAL *dx, int *_incx)
+{
+  int     i, n = *_n, n4 = n & ~3;
+  REAL    da = *_da;
+  __m256d va;
+
+  if(*_incx != 1) {
+    my_dscal(_n, _da, dx, _incx);
+    return;
+  }
+  va = _mm256_set1_pd(da);
+  for(i = 0; i < n4; i += 4)
+    _mm256_storeu_pd(dx+i, _mm256_mul_pd(va, _mm256_loadu_pd(dx+i)));
+  for(; i < n; i++)
+    dx[i] *= da;
+}
+
+BlasTarget("avx2")
+static REAL BLAS_CALLMODEL avx2_ddot( int *_n, REAL *dx, int *_incx, REAL *dy, int *_incy)
+{
+  int     i, n = *_n, n8 = n & ~7;
+  REAL    dtemp, sum[4];
+  __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+
+  if((*_incx != 1) || (*_incy != 1))
+    return( my_ddot(_n, dx, _incx, dy, _incy) );
+  for(i = 0; i < n8; i += 8) {
+    s0 = _mm256_add_pd(s0, _mm256_mul_pd(_mm256_loadu_pd(dx+i),   _mm256_loadu_pd(dy+i)));
+    s1 = _mm256_add_pd(s1, _mm256_mul_pd(_mm256_loadu_pd(dx+i+4), _mm256_loadu_pd(dy+i+4)));
+  }
+  _mm256_storeu_pd(sum, _mm256_add_pd(s0, s1));
+  dtemp = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+  for(; i < n; i++)
+    dtemp += dx[i]*dy[i];
+  return( dtemp );
+}
+
+BlasTarget("avx2")
+static int BLAS_CALLMODEL avx2_idamax( int *_n, REAL *x, int *_is)
+{
+  int     i, k, n = *_n, n4 = n & ~3;
+  REAL    xmax, xm[4];
+  __m256d vmax = _mm256_setzero_pd(),
+          absmask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+
+  if((*_is != 1) || (n < 8))
+    return( my_idamax(_n, x, _is) );
+
+  /* Find the largest absolute value ... */
+  for(i = 0; i < n4; i += 4)
+    vmax = _mm256_max_pd(vmax, _mm256_and_pd(_mm256_loadu_pd(x+i), absmask));
+  _mm256_storeu_pd(xm, vmax);
+  xmax = MAX(MAX(xm[0], xm[1]), MAX(xm[2], xm[3]));
+  for(; i < n; i++)
+    SETMAX(xmax, fabs(x[i]));
+
+  /* ... and return its first position, as the scalar version does */
+  vmax = _mm256_set1_pd(xmax);
+  for(i = 0; i < n4; i += 4) {
+    k = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_and_pd(_mm256_loadu_pd(x+i), absmask),
+                                         vmax, _CMP_EQ_OQ));
+    if(k != 0)
+      return( i + __builtin_ctz(k) + 1 );
+  }
+  for(; i < n; i++)
+    if(fabs(x[i]) == xmax)
+      return( i + 1 );
+  return( my_idamax(_n, x, _is) );  /* Not a number in x */
+}
+#endif
+
+#ifdef BlasSIMD512
+BlasTarget("avx512f")
+static void BLAS_CALLMODEL avx512_daxpy( int *_n, REAL *_da, REAL *dx, int *_incx, REAL *dy, int *_incy)
+{
+  int     i, n = *_n, n8 = n & ~7;
+  REAL    da = *_da;
+  __m512d va;
+
+  if((*_incx != 1) || (*_incy != 1) || (da == 0.0)) {
+    my_daxpy(_n, _da, dx, _incx, dy, _incy);
+    return;
+  }
+  va = _mm512_set1_pd(da);
+  for(i = 0; i < n8; i += 8)
+    _mm512_storeu_pd(dy+i, _mm512_add_pd(_mm512_loadu_pd(dy+i),
+                                         _mm512_mul_pd(va, _mm512_loadu_pd(dx+i))));
+  for(; i < n; i++)
+    dy[i] += da*dx[i];
+}
+
+BlasTarget("avx512f")
+static void BLAS_CALLMODEL avx512_dscal( int *_n, REAL *_da, REAL *dx, int *_incx)
+{
+  int     i, n = *_n, n8 = n & ~7;
+  REAL    da = *_da;
+  __m512d va;
+
+  if(*_incx != 1) {
+    my_dscal(_n, _da, dx, _incx);
+    return;
+  }
+  va = _mm512_set1_pd(da);
+  for(i = 0; i < n8; i += 8)
+    _mm512_storeu_pd(dx+i, _mm512_mul_pd(va, _mm512_loadu_pd(dx+i)));
+  for(; i < n; i++)
+    dx[i] *= da;
+}
+
+BlasTarget("avx512f")
+static REAL BLAS_CALLMODEL avx512_ddot( int *_n, REAL *dx, int *_incx, REAL *dy, int *_incy)
+{
+  int     i, n = *_n, n16 = n & ~15;
+  REAL    dtemp;
+  __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+
+  if((*_incx != 1) || (*_incy != 1))
+    return( my_ddot(_n, dx, _incx, dy, _incy) );
+  for(i = 0; i < n16; i += 16) {
+    s0 = _mm512_add_pd(s0, _mm512_mul_pd(_mm512_loadu_pd(dx+i),   _mm512_loadu_pd(dy+i)));
+    s1 = _mm512_add_pd(s1, _mm512_mul_pd(_mm512_loadu_pd(dx+i+8), _mm512_loadu_pd(dy+i+8)));
+  }
+  dtemp = _mm512_reduce_add_pd(_mm512_add_pd(s0, s1));
+  for(; i < n; i++)
+    dtemp += dx[i]*dy[i];
+  return( dtemp );
+}
+
+BlasTarget("avx512f")
+static int BLAS_CALLMODEL avx512_idamax( int *_n, REAL *x, int *_is)
+{
+  int     i, n = *_n, n8 = n & ~7;
+  REAL    xmax;
+  __mmask8 k;
+  __m512d vmax = _mm512_setzero_pd();
+
+  if((*_is != 1) || (n < 16))
+    return( my_idamax(_n, x, _is) );
+
+  /* Find the largest absolute value ... */
+  for(i = 0; i < n8; i += 8)
+    vmax = _mm512_max_pd(vmax, _mm512_abs_pd(_mm512_loadu_pd(x+i)));
+  xmax = _mm512_reduce_max_pd(vmax);
+  for(; i < n; i++)
+    SETMAX(xmax, fabs(x[i]));
+
+  /* ... and return its first position, as the scalar version does */
+  vmax = _mm512_set1_pd(xmax);
+  for(i = 0; i < n8; i += 8) {
+    k = _mm512_cmp_pd_mask(_mm512_abs_pd(_mm512_loadu_pd(x+i)), vmax, _CMP_EQ_OQ);
+    if(k != 0)
+      return( i + __builtin_ctz(k) + 1 );
+  }
+  for(; i < n; i++)
+    if(fabs(x[i]) == xmax)
+      return( i + 1 );
+  return( my_idamax(_n, x, _is) );  /* Not a number in x */
+}
+#endif
+
+/* Detect the vector instruction sets of the processor and install the
+   widest vectorized kernels that it supports */
+static void simd_BLAS(void)
+{
+#ifdef BlasSIMD
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx512f"))
+    simdBLAS = BLAS_SIMD_AVX512;
+  else if(__builtin_cpu_supports("avx2"))
+    simdBLAS = BLAS_SIMD_AVX2;
+#ifdef BlasSIMD512
+  if(simdBLAS >= BLAS_SIMD_AVX512) {
+    BLAS_dscal  = avx512_dscal;
+    BLAS_daxpy  = avx512_daxpy;
+    BLAS_ddot   = avx512_ddot;
+    BLAS_idamax = avx512_idamax;
+  }
+  else
+#endif
+  if(simdBLAS >= BLAS_SIMD_AVX2) {
+    BLAS_dscal  = avx2_dscal;
+    BLAS_daxpy  = avx2_daxpy;
+    BLAS_ddot   = avx2_ddot;
+    BLAS_idamax = avx2_idamax;
+  }
+#endif
+}
+
+/* The vector instruction set detected by init_BLAS; callers with their own
+   vectorized code use this rather than testing the processor again */
+int simd_levelBLAS(void)
+{
+  return( simdBLAS );
+}
@@ -0,0 +1,418 @@
+
+#include <stdlib.h>
+#include "mythread.h"
+
+#if !defined NoThreads && !defined WIN32 && !defined _WIN32
+  #include <unistd.h>
+#endif
+
+#ifdef FORTIFY
+# include "lp_fortify.h"
+#endif
+
+
+/* ************************************************************************ */
+/* Local worker record                                                      */
+/* ************************************************************************ */
+typedef struct _threadarg
+{
+  thread_func *func;
+  void        *data;
+  int         threadnr;
+  int         threadcount;
+} threadarg;
+
+#if defined NoThreads
+#elif defined WIN32 || defined _WIN32
+static DWORD WINAPI thread_start(LPVOID arg)
+{
+  threadarg *targ = (threadarg *) arg;
+
+  targ->func(targ->data, targ->threadnr, targ->threadcount);
+  return( 0 );
+}
+#else
+static void *thread_start(void *arg)
+{
+  threadarg *targ = (threadarg *) arg;
+
+  targ->func(targ->data, targ->threadnr, targ->threadcount);
+  return( NULL );
+}
+#endif
+
+#if !defined NoThreads && (defined WIN32 || defined _WIN32)
+static BOOL CALLBACK thread_oncestart(PINIT_ONCE once, PVOID func, PVOID *context)
+{
+  ((thread_oncefunc *) func)();
+  return( TRUE );
+}
+#endif
+
+
+/* ************************************************************************ */
+/* Worker pool; worker k (1..workers) runs share k of the current job and   */
+/* then sleeps until the job generation changes.  Only one thread_run can   */
+/* use the pool at a time; a concurrent or nested call starts and joins    */
+/* its own threads instead.                                                 */
+/* ************************************************************************ */
+#if !defined NoThreads
+typedef struct _threadpool
+{
+#if defined WIN32 || defined _WIN32
+  CRITICAL_SECTION   section;
+  CONDITION_VARIABLE wakeup, finished;
+#else
+  pthread_mutex_t    mutex;
+  pthread_cond_t     wakeup, finished;
+#endif
+  MYBOOL    ready;                      /* The lock and the conditions are valid */
+  MYBOOL    busy;                       /* A thread_run is using the pool */
+  int       workers;                    /* Number of started worker threads */
+  int       generation;                 /* Incremented for every new job */
+  int       jobcount;                   /* Shares 1..jobcount-1 are run by the workers */
+  int       pending;                    /* Shares of the current job not yet finished */
+  threadarg job[THREAD_MAXCOUNT];
+} threadpool;
+
+static threadpool pool;
+static threadonce poolonce = THREAD_ONCE_INIT;
+
+#if defined WIN32 || defined _WIN32
+  #define pool_lock()          EnterCriticalSection(&pool.section)
+  #define pool_unlock()        LeaveCriticalSection(&pool.section)
+  #define pool_wait(cond)      SleepConditionVariableCS(&pool.cond, &pool.section, INFINITE)
+  #define pool_wakeall(cond)   WakeAllConditionVariable(&pool.cond)
+#else
+  #define pool_lock()          pthread_mutex_lock(&pool.mutex)
+  #define pool_unlock()        pthread_mutex_unlock(&pool.mutex)
+  #define pool_wait(cond)      pthread_cond_wait(&pool.cond, &pool.mutex)
+  #define pool_wakeall(cond)   pthread_cond_broadcast(&pool.cond)
+#endif
+
+static void pool_init(void)
+{
+#if defined WIN32 || defined _WIN32
+  InitializeCriticalSection(&pool.section);
+  InitializeConditionVariable(&pool.wakeup);
+  InitializeConditionVariable(&pool.finished);
+  pool.ready = TRUE;
+#else
+  pool.ready = (MYBOOL) ((pthread_mutex_init(&pool.mutex, NULL) == 0) &&
+                         (pthread_cond_init(&pool.wakeup, NULL) == 0) &&
+                         (pthread_cond_init(&pool.finished, NULL) == 0));
+#endif
+}
+
+static void pool_work(int threadnr)
+{
+  int       generation;
+  threadarg targ;
+
+  /* Workers are started by pool_submit for the job that it is about to post */
+  pool_lock();
+  generation = pool.generation-1;
+  for(;;) {
+    while(pool.generation == generation)
+      pool_wait(wakeup);
+    generation = pool.generation;
+    if(threadnr >= pool.jobcount)
+      continue;
+    targ = pool.job[threadnr];
+    pool_unlock();
+    targ.func(targ.data, targ.threadnr, targ.threadcount);
+    pool_lock();
+    pool.pending--;
+    if(pool.pending == 0)
+      pool_wakeall(finished);
+  }
+}
+
+#if defined WIN32 || defined _WIN32
+static DWORD WINAPI pool_start(LPVOID arg)
+{
+  pool_work((int) (INT_PTR) arg);
+  return( 0 );
+}
+#else
+static void *pool_start(void *arg)
+{
+  pool_work((int) (size_t) arg);
+  return( NULL );
+}
+#endif
+
+/* Start workers up to count-1 (with the pool lock held); returns the number of workers */
+static int pool_grow(int count)
+{
+#if defined WIN32 || defined _WIN32
+  HANDLE    handle;
+#else
+  pthread_t handle;
+  pthread_attr_t attr;
+
+  if(pthread_attr_init(&attr) != 0)
+    return( pool.workers );
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+#endif
+  while(pool.workers < count-1) {
+#if defined WIN32 || defined _WIN32
+    handle = CreateThread(NULL, 0, pool_start, (LPVOID) (INT_PTR) (pool.workers+1), 0, NULL);
+    if(handle == NULL)
+      break;
+    CloseHandle(handle);
+#else
+    if(pthread_create(&handle, &attr, pool_start, (void *) (size_t) (pool.workers+1)) != 0)
+      break;
+#endif
+    pool.workers++;
+  }
+#if !defined WIN32 && !defined _WIN32
+  pthread_attr_destroy(&attr);
+#endif
+  return( pool.workers );
+}
+
+/* Hand shares 1..threadcount-1 to the pool; returns the number of shares
+   given out plus one, or 0 if the pool is not available */
+static int pool_submit(threadarg *targ, int threadcount)
+{
+  int i, n;
+
+  thread_once(&poolonce, pool_init);
+  if(!pool.ready)
+    return( 0 );
+  pool_lock();
+  if(pool.busy) {
+    pool_unlock();
+    return( 0 );
+  }
+  pool.busy = TRUE;
+  n = pool_grow(threadcount) + 1;
+  if(n > threadcount)
+    n = threadcount;
+  for(i = 1; i < n; i++)
+    pool.job[i] = targ[i];
+  pool.jobcount = n;
+  pool.pending  = n-1;
+  pool.generation++;
+  pool_wakeall(wakeup);
+  pool_unlock();
+  return( n );
+}
+
+static void pool_join(void)
+{
+  pool_lock();
+  while(pool.pending > 0)
+    pool_wait(finished);
+  pool.busy = FALSE;
+  pool_unlock();
+}
+#endif
+
+
+/* ************************************************************************ */
+/* Number of processors available to the process                            */
+/* ************************************************************************ */
+int thread_cpucount(void)
+{
+  int n = 1;
+
+#if defined NoThreads
+#elif defined WIN32 || defined _WIN32
+  SYSTEM_INFO info;
+
+  GetSystemInfo(&info);
+  n = (int) info.dwNumberOfProcessors;
+#elif defined _SC_NPROCESSORS_ONLN
+  n = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+  if(n < 1)
+    n = 1;
+  else if(n > THREAD_MAXCOUNT)
+    n = THREAD_MAXCOUNT;
+  return( n );
+}
+
+
+/* ************************************************************************ */
+/* Run func on threadcount threads and wait for all of them to finish; the  */
+/* work of thread 0 is done on the calling thread and the other shares by  */
+/* the worker pool.  If the pool is in use, the call starts and joins its  */
+/* own threads.  If a thread cannot be created, its share is executed      */
+/* sequentially by the caller instead, so the call always completes all    */
+/* the work.                                                                */
+/* ************************************************************************ */
+MYBOOL thread_run(int threadcount, thread_func *func, void *data)
+{
+  int       i;
+  MYBOOL    status = TRUE;
+  threadarg targ[THREAD_MAXCOUNT];
+#if defined NoThreads
+#elif defined WIN32 || defined _WIN32
+  HANDLE    handle[THREAD_MAXCOUNT];
+#else
+  pthread_t handle[THREAD_MAXCOUNT];
+  MYBOOL    started[THREAD_MAXCOUNT];
+#endif
+
+  if(threadcount < 1)
+    threadcount = 1;
+  else if(threadcount > THREAD_MAXCOUNT)
+    threadcount = THREAD_MAXCOUNT;
+
+  if(threadcount == 1) {
+    func(data, 0, 1);
+    return( status );
+  }
+
+  for(i = 0; i < threadcount; i++) {
+    targ[i].func        = func;
+    targ[i].data        = data;
+    targ[i].threadnr    = i;
+    targ[i].threadcount = threadcount;
+  }
+
+#if defined NoThreads
+  for(i = 0; i < threadcount; i++)
+    func(data, i, threadcount);
+#else
+  i = pool_submit(targ, threadcount);
+  if(i > 0) {
+    func(data, 0, threadcount);
+    for(; i < threadcount; i++) {
+      func(data, i, threadcount);
+      status = FALSE;
+    }
+    pool_join();
+  }
+  else {
+#if defined WIN32 || defined _WIN32
+    for(i = 1; i < threadcount; i++)
+      handle[i] = CreateThread(NULL, 0, thread_start, &targ[i], 0, NULL);
+    func(data, 0, threadcount);
+    for(i = 1; i < threadcount; i++) {
+      if(handle[i] == NULL) {
+        func(data, i, threadcount);
+        status = FALSE;
+      }
+      else {
+        WaitForSingleObject(handle[i], INFINITE);
+        CloseHandle(handle[i]);
+      }
+    }
+#else
+    for(i = 1; i < threadcount; i++)
+      started[i] = (MYBOOL) (pthread_create(&handle[i], NULL, thread_start, &targ[i]) == 0);
+    func(data, 0, threadcount);
+    for(i = 1; i < threadcount; i++) {
+      if(!started[i]) {
+        func(data, i, threadcount);
+        status = FALSE;
+      }
+      else
+        pthread_join(handle[i], NULL);
+    }
+#endif
+  }
+#endif
+
+  return( status );
+}
+
+
+/* ************************************************************************ */
+/* Split the index range firstindex..lastindex in contiguous chunks; the    */
+/* chunk of thread threadnr is lo..hi (empty if hi < lo)                    */
+/* ************************************************************************ */
+void thread_partition(int threadnr, int threadcount, int firstindex, int lastindex, int *lo, int *hi)
+{
+  int n = lastindex - firstindex + 1,
+      size, extra;
+
+  if((n <= 0) || (threadcount < 1)) {
+    *lo = firstindex;
+    *hi = firstindex - 1;
+    return;
+  }
+  size  = n / threadcount;
+  extra = n % threadcount;
+  *lo = firstindex + threadnr*size + (threadnr < extra ? threadnr : extra);
+  *hi = *lo + size - 1 + (threadnr < extra ? 1 : 0);
+}
+
+
+/* ************************************************************************ */
+/* Mutual exclusion                                                         */
+/* ************************************************************************ */
+threadlock *thread_createlock(void)
+{
+  threadlock *lock = (threadlock *) calloc(1, sizeof(*lock));
+
+  if(lock == NULL)
+    return( lock );
+#if defined NoThreads
+#elif defined WIN32 || defined _WIN32
+  InitializeCriticalSection(&lock->section);
+#else
+  if(pthread_mutex_init(&lock->mutex, NULL) != 0) {
+    free(lock);
+    lock = NULL;
+  }
+#endif
+  return( lock );
+}
+
+void thread_lock(threadlock *lock)
+{
+#if defined NoThreads
+#elif defined WIN32 || defined _WIN32
+  EnterCriticalSection(&lock->section);
+#else
+  pthread_mutex_lock(&lock->mutex);
+#endif
+}
+
+void thread_unlock(threadlock *lock)
+{
+#if defined NoThreads
+#elif defined WIN32 || defined _WIN32
+  LeaveCriticalSection(&lock->section);
+#else
+  pthread_mutex_unlock(&lock->mutex);
+#endif
+}
+
+void thread_freelock(threadlock **lock)
+{
+  if(*lock == NULL)
+    return;
+#if defined NoThreads
+#elif defined WIN32 || defined _WIN32
+  DeleteCriticalSection(&(*lock)->section);
+#else
+  pthread_mutex_destroy(&(*lock)->mutex);
+#endif
+  free(*lock);
+  *lock = NULL;
+}
+
+
+/* ************************************************************************ */
+/* Call func exactly once over all threads; callers that arrive while the   */
+/* first call is running wait until it has finished                         */
+/* ************************************************************************ */
+void thread_once(threadonce *once, thread_oncefunc *func)
+{
+#if defined NoThreads
+  if(!once->done) {
+    once->done = TRUE;
+    func();
+  }
+#elif defined WIN32 || defined _WIN32
+  InitOnceExecuteOnce(&once->once, thread_oncestart, (PVOID) func, NULL);
+#else
+  pthread_once(&once->once, func);
+#endif
+}
@@ -0,0 +1,83 @@
+#ifndef HEADER_mythread
+#define HEADER_mythread
+
+/* ************************************************************************ */
+/* Minimal fork-join threading support for the solver and the BFPs          */
+/* Licence: LGPL                                                            */
+/* ************************************************************************ */
+/* The interface only offers what the solver needs: a blocking "run this    */
+/* routine on n threads" primitive, static range partitioning, a plain     */
+/* mutual exclusion lock and a one-time initialization.  Thread 0 always   */
+/* executes on the calling thread, so a thread count of 1 has no overhead  */
+/* over a direct call; the other threads are taken from a pool of workers  */
+/* that are started on first use and then wait for the next call.  Define  */
+/* NoThreads to compile a strictly sequential version of the library.      */
+/* ************************************************************************ */
+
+#include "commonlib.h"
+
+#if defined NoThreads
+#elif defined WIN32 || defined _WIN32
+  #include <windows.h>
+#else
+  #include <pthread.h>
+#endif
+
+#define THREAD_MAXCOUNT    64      /* Upper limit to the number of worker threads */
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Worker routine; threadnr is in the range 0..threadcount-1 */
+typedef void (thread_func)(void *data, int threadnr, int threadcount);
+
+typedef struct _threadlock
+{
+#if defined NoThreads
+  int               dummy;
+#elif defined WIN32 || defined _WIN32
+  CRITICAL_SECTION  section;
+#else
+  pthread_mutex_t   mutex;
+#endif
+} threadlock;
+
+/* One-time initialization record; define it statically with THREAD_ONCE_INIT */
+typedef void (thread_oncefunc)(void);
+typedef struct _threadonce
+{
+#if defined NoThreads
+  MYBOOL            done;
+#elif defined WIN32 || defined _WIN32
+  INIT_ONCE         once;
+#else
+  pthread_once_t    once;
+#endif
+} threadonce;
+
+#if defined NoThreads
+  #define THREAD_ONCE_INIT  { FALSE }
+#elif defined WIN32 || defined _WIN32
+  #define THREAD_ONCE_INIT  { INIT_ONCE_STATIC_INIT }
+#else
+  #define THREAD_ONCE_INIT  { PTHREAD_ONCE_INIT }
+#endif
+
+int thread_cpucount(void);
+MYBOOL thread_run(int threadcount, thread_func *func, void *data);
+void thread_partition(int threadnr, int threadcount, int firstindex, int lastindex, int *lo, int *hi);
+
+threadlock *thread_createlock(void);
+void thread_lock(threadlock *lock);
+void thread_unlock(threadlock *lock);
+void thread_freelock(threadlock **lock);
+
+void thread_once(threadonce *once, thread_oncefunc *func);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -44,6 +44,71 @@ NAN_MODULE_INIT(init) {
     Nan::Set(STATUS, Nan::New<String>("NOFEASFOUND").ToLocalChecked(), Nan::New<Number>(13));
     Nan::Set(target, Nan::New<String>("STATUS").ToLocalChecked(), STATUS);
 
+    Local<Object> SIMPLEX = Nan::New<Object>();
+    Nan::Set(SIMPLEX, Nan::New<String>("PRIMAL_PRIMAL").ToLocalChecked(), Nan::New<Number>(5));
+    Nan::Set(SIMPLEX, Nan::New<String>("DUAL_PRIMAL").ToLocalChecked(), Nan::New<Number>(6));
+    Nan::Set(SIMPLEX, Nan::New<String>("PRIMAL_DUAL").ToLocalChecked(), Nan::New<Number>(9));
+    Nan::Set(SIMPLEX, Nan::New<String>("DUAL_DUAL").ToLocalChecked(), Nan::New<Number>(10));
+    Nan::Set(SIMPLEX, Nan::New<String>("CONCURRENT").ToLocalChecked(), Nan::New<Number>(64));
+    Nan::Set(target, Nan::New<String>("SIMPLEX").ToLocalChecked(), SIMPLEX);
+
+    Local<Object> PRESOLVE = Nan::New<Object>();
+    Nan::Set(PRESOLVE, Nan::New<String>("NONE").ToLocalChecked(), Nan::New<Number>(0));
+    Nan::Set(PRESOLVE, Nan::New<String>("ROWS").ToLocalChecked(), Nan::New<Number>(1));
+    Nan::Set(PRESOLVE, Nan::New<String>("COLS").ToLocalChecked(), Nan::New<Number>(2));
+    Nan::Set(PRESOLVE, Nan::New<String>("LINDEP").ToLocalChecked(), Nan::New<Number>(4));
+    Nan::Set(PRESOLVE, Nan::New<String>("AGGREGATE").ToLocalChecked(), Nan::New<Number>(8));
+    Nan::Set(PRESOLVE, Nan::New<String>("SPARSER").ToLocalChecked(), Nan::New<Number>(16));
+    Nan::Set(PRESOLVE, Nan::New<String>("SOS").ToLocalChecked(), Nan::New<Number>(32));
+    Nan::Set(PRESOLVE, Nan::New<String>("REDUCEMIP").ToLocalChecked(), Nan::New<Number>(64));
+    Nan::Set(PRESOLVE, Nan::New<String>("KNAPSACK").ToLocalChecked(), Nan::New<Number>(128));
+    Nan::Set(PRESOLVE, Nan::New<String>("ELIMEQ2").ToLocalChecked(), Nan::New<Number>(256));
+    Nan::Set(PRESOLVE, Nan::New<String>("IMPLIEDFREE").ToLocalChecked(), Nan::New<Number>(512));
+    Nan::Set(PRESOLVE, Nan::New<String>("REDUCEGCD").ToLocalChecked(), Nan::New<Number>(1024));
+    Nan::Set(PRESOLVE, Nan::New<String>("PROBEFIX").ToLocalChecked(), Nan::New<Number>(2048));
+    Nan::Set(PRESOLVE, Nan::New<String>("PROBEREDUCE").ToLocalChecked(), Nan::New<Number>(4096));
+    Nan::Set(PRESOLVE, Nan::New<String>("ROWDOMINATE").ToLocalChecked(), Nan::New<Number>(8192));
+    Nan::Set(PRESOLVE, Nan::New<String>("COLDOMINATE").ToLocalChecked(), Nan::New<Number>(16384));
+    Nan::Set(PRESOLVE, Nan::New<String>("MERGEROWS").ToLocalChecked(), Nan::New<Number>(32768));
+    Nan::Set(PRESOLVE, Nan::New<String>("IMPLIEDSLK").ToLocalChecked(), Nan::New<Number>(65536));
+    Nan::Set(PRESOLVE, Nan::New<String>("COLFIXDUAL").ToLocalChecked(), Nan::New<Number>(131072));
+    Nan::Set(PRESOLVE, Nan::New<String>("BOUNDS").ToLocalChecked(), Nan::New<Number>(262144));
+    Nan::Set(PRESOLVE, Nan::New<String>("DUALS").ToLocalChecked(), Nan::New<Number>(524288));
+    Nan::Set(PRESOLVE, Nan::New<String>("SENSDUALS").ToLocalChecked(), Nan::New<Number>(1048576));
+    Nan::Set(target, Nan::New<String>("PRESOLVE").ToLocalChecked(), PRESOLVE);
+
+    Local<Object> CRASH = Nan::New<Object>();
+    Nan::Set(CRASH, Nan::New<String>("NONE").ToLocalChecked(), Nan::New<Number>(0));
+    Nan::Set(CRASH, Nan::New<String>("NONBASICBOUNDS").ToLocalChecked(), Nan::New<Number>(1));
+    Nan::Set(CRASH, Nan::New<String>("MOSTFEASIBLE").ToLocalChecked(), Nan::New<Number>(2));
+    Nan::Set(CRASH, Nan::New<String>("LEASTDEGENERATE").ToLocalChecked(), Nan::New<Number>(3));
+    Nan::Set(CRASH, Nan::New<String>("TRIANGULAR").ToLocalChecked(), Nan::New<Number>(4));
+    Nan::Set(target, Nan::New<String>("CRASH").ToLocalChecked(), CRASH);
+
+    Local<Object> NODE = Nan::New<Object>();
+    Nan::Set(NODE, Nan::New<String>("FIRSTSELECT").ToLocalChecked(), Nan::New<Number>(0));
+    Nan::Set(NODE, Nan::New<String>("GAPSELECT").ToLocalChecked(), Nan::New<Number>(1));
+    Nan::Set(NODE, Nan::New<String>("RANGESELECT").ToLocalChecked(), Nan::New<Number>(2));
+    Nan::Set(NODE, Nan::New<String>("FRACTIONSELECT").ToLocalChecked(), Nan::New<Number>(3));
+    Nan::Set(NODE, Nan::New<String>("PSEUDOCOSTSELECT").ToLocalChecked(), Nan::New<Number>(4));
+    Nan::Set(NODE, Nan::New<String>("PSEUDONONINTSELECT").ToLocalChecked(), Nan::New<Number>(5));
+    Nan::Set(NODE, Nan::New<String>("PSEUDORATIOSELECT").ToLocalChecked(), Nan::New<Number>(6));
+    Nan::Set(NODE, Nan::New<String>("WEIGHTREVERSEMODE").ToLocalChecked(), Nan::New<Number>(8));
+    Nan::Set(NODE, Nan::New<String>("BRANCHREVERSEMODE").ToLocalChecked(), Nan::New<Number>(16));
+    Nan::Set(NODE, Nan::New<String>("GREEDYMODE").ToLocalChecked(), Nan::New<Number>(32));
+    Nan::Set(NODE, Nan::New<String>("PSEUDOCOSTMODE").ToLocalChecked(), Nan::New<Number>(64));
+    Nan::Set(NODE, Nan::New<String>("DEPTHFIRSTMODE").ToLocalChecked(), Nan::New<Number>(128));
+    Nan::Set(NODE, Nan::New<String>("RANDOMIZEMODE").ToLocalChecked(), Nan::New<Number>(256));
+    Nan::Set(NODE, Nan::New<String>("GUBMODE").ToLocalChecked(), Nan::New<Number>(512));
+    Nan::Set(NODE, Nan::New<String>("DYNAMICMODE").ToLocalChecked(), Nan::New<Number>(1024));
+    Nan::Set(NODE, Nan::New<String>("RESTARTMODE").ToLocalChecked(), Nan::New<Number>(2048));
+    Nan::Set(NODE, Nan::New<String>("BREADTHFIRSTMODE").ToLocalChecked(), Nan::New<Number>(4096));
+    Nan::Set(NODE, Nan::New<String>("AUTOORDER").ToLocalChecked(), Nan::New<Number>(8192));
+    Nan::Set(NODE, Nan::New<String>("RCOSTFIXING").ToLocalChecked(), Nan::New<Number>(16384));
+    Nan::Set(NODE, Nan::New<String>("STRONGINIT").ToLocalChecked(), Nan::New<Number>(32768));
+    Nan::Set(NODE, Nan::New<String>("RELIABILITY").ToLocalChecked(), Nan::New<Number>(65536));
+    Nan::Set(target, Nan::New<String>("NODE").ToLocalChecked(), NODE);
+
     LPSolve::Init(target);
 }
 
@@ -79,6 +144,11 @@ void LPSolve::Init(Handle<Object> exports) {
     Nan::SetPrototypeMethod(tpl, "breakAtFirst", LPSolve::breakAtFirst);
     Nan::SetPrototypeMethod(tpl, "verbose", LPSolve::verbose);
     Nan::SetPrototypeMethod(tpl, "timeout", LPSolve::timeout);
+    Nan::SetPrototypeMethod(tpl, "threads", LPSolve::threads);
+    Nan::SetPrototypeMethod(tpl, "simplexType", LPSolve::simplexType);
+    Nan::SetPrototypeMethod(tpl, "presolve", LPSolve::presolve);
+    Nan::SetPrototypeMethod(tpl, "basisCrash", LPSolve::basisCrash);
+    Nan::SetPrototypeMethod(tpl, "bbRule", LPSolve::bbRule);
     Nan::SetPrototypeMethod(tpl, "solve", LPSolve::solve);
     Nan::SetPrototypeMethod(tpl, "solveSync", LPSolve::solveSync);
     Nan::SetPrototypeMethod(tpl, "variables", LPSolve::variables);
@@ -835,6 +905,111 @@ NAN_METHOD(LPSolve::timeout) {
 	}
 }
 
+NAN_METHOD(LPSolve::threads) {
+	if (info.Length() > 1) {
+	    return Nan::ThrowError("Invalid number of arguments");
+	}
+
+	if (info.Length() == 0) {
+	    LPSolve* obj = node::ObjectWrap::Unwrap<LPSolve>(info.This());
+        int ret = ::get_threads(obj->lp);
+        info.GetReturnValue().Set(Nan::New<Number>(ret));
+	} else {
+	    if (!(info[0]->IsNumber())) {
+    	    return Nan::ThrowTypeError("First argument should be a Number");
+    	}
+
+    	int threads = (int)(info[0]->Int32Value());
+        LPSolve* obj = node::ObjectWrap::Unwrap<LPSolve>(info.This());
+        ::set_threads(obj->lp, threads);
+	}
+}
+
+NAN_METHOD(LPSolve::simplexType) {
+	if (info.Length() > 1) {
+	    return Nan::ThrowError("Invalid number of arguments");
+	}
+
+	if (info.Length() == 0) {
+	    LPSolve* obj = node::ObjectWrap::Unwrap<LPSolve>(info.This());
+        int ret = ::get_simplextype(obj->lp);
+        info.GetReturnValue().Set(Nan::New<Number>(ret));
+	} else {
+	    if (!(info[0]->IsNumber())) {
+    	    return Nan::ThrowTypeError("First argument should be a Number");
+    	}
+
+    	int simplextype = (int)(info[0]->Int32Value());
+        LPSolve* obj = node::ObjectWrap::Unwrap<LPSolve>(info.This());
+        ::set_simplextype(obj->lp, simplextype);
+	}
+}
+
+NAN_METHOD(LPSolve::presolve) {
+	if (info.Length() > 2) {
+	    return Nan::ThrowError("Invalid number of arguments");
+	}
+
+	if (info.Length() == 0) {
+	    LPSolve* obj = node::ObjectWrap::Unwrap<LPSolve>(info.This());
+        int ret = ::get_presolve(obj->lp);
+        info.GetReturnValue().Set(Nan::New<Number>(ret));
+	} else {
+	    if (!(info[0]->IsNumber())) {
+    	    return Nan::ThrowTypeError("First argument should be a Number");
+    	}
+
+	    if (info.Length() == 2 && !(info[1]->IsNumber())) {
+    	    return Nan::ThrowTypeError("Second argument should be a Number");
+    	}
+
+    	int do_presolve = (int)(info[0]->Int32Value());
+        LPSolve* obj = node::ObjectWrap::Unwrap<LPSolve>(info.This());
+        int maxloops = (info.Length() == 2) ? (int)(info[1]->Int32Value()) : ::get_presolveloops(obj->lp);
+        ::set_presolve(obj->lp, do_presolve, maxloops);
+	}
+}
+
+NAN_METHOD(LPSolve::basisCrash) {
+	if (info.Length() > 1) {
+	    return Nan::ThrowError("Invalid number of arguments");
+	}
+
+	if (info.Length() == 0) {
+	    LPSolve* obj = node::ObjectWrap::Unwrap<LPSolve>(info.This());
+        int ret = ::get_basiscrash(obj->lp);
+        info.GetReturnValue().Set(Nan::New<Number>(ret));
+	} else {
+	    if (!(info[0]->IsNumber())) {
+    	    return Nan::ThrowTypeError("First argument should be a Number");
+    	}
+
+    	int mode = (int)(info[0]->Int32Value());
+        LPSolve* obj = node::ObjectWrap::Unwrap<LPSolve>(info.This());
+        ::set_basiscrash(obj->lp, mode);
+	}
+}
+
+NAN_METHOD(LPSolve::bbRule) {
+	if (info.Length() > 1) {
+	    return Nan::ThrowError("Invalid number of arguments");
+	}
+
+	if (info.Length() == 0) {
+	    LPSolve* obj = node::ObjectWrap::Unwrap<LPSolve>(info.This());
+        int ret = ::get_bb_rule(obj->lp);
+        info.GetReturnValue().Set(Nan::New<Number>(ret));
+	} else {
+	    if (!(info[0]->IsNumber())) {
+    	    return Nan::ThrowTypeError("First argument should be a Number");
+    	}
+
+    	int bb_rule = (int)(info[0]->Int32Value());
+        LPSolve* obj = node::ObjectWrap::Unwrap<LPSolve>(info.This());
+        ::set_bb_rule(obj->lp, bb_rule);
+	}
+}
+
 NAN_METHOD(LPSolve::writeLP) {
 	if (info.Length() != 1) {
 	    return Nan::ThrowError("Invalid number of arguments");
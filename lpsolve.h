@@ -46,6 +46,11 @@ private:
     static NAN_METHOD(breakAtFirst);
     static NAN_METHOD(verbose);
     static NAN_METHOD(timeout);
+    static NAN_METHOD(threads);
+    static NAN_METHOD(simplexType);
+    static NAN_METHOD(presolve);
+    static NAN_METHOD(basisCrash);
+    static NAN_METHOD(bbRule);
     static NAN_METHOD(solve);
     static NAN_METHOD(solveSync);
     static NAN_METHOD(variables);
@@ -69,10 +74,8 @@ dualize_lp
 free_lp
 get_anti_degen
 get_basis
-get_basiscrash
 get_bb_depthlimit
 get_bb_floorfirst
-get_bb_rule
 get_bounds_tighter
 get_break_at_value
 get_col_name, get_origcol_name
@@ -104,7 +107,6 @@ get_obj_bound
 get_objective
 get_orig_index
 get_pivoting
-get_presolve
 get_presolveloops
 get_primal_solution, get_ptr_primal_solution, get_var_primalresult
 get_print_sol
@@ -114,7 +116,6 @@ get_scalelimit
 get_scaling
 get_sensitivity_obj, get_ptr_sensitivity_obj, get_sensitivity_objex, get_ptr_sensitivity_objex
 get_sensitivity_rhs, get_ptr_sensitivity_rhs, get_dual_solution, get_ptr_dual_solution, get_var_dualresult
-get_simplextype
 get_solutioncount
 get_solutionlimit
 get_status
@@ -172,11 +173,9 @@ reset_basis
 reset_params
 set_anti_degen, get_anti_degen
 set_basis
-set_basiscrash
 set_basisvar
 set_bb_depthlimit
 set_bb_floorfirst
-set_bb_rule
 set_BFP
 set_XLI
 set_bounds_tighter
@@ -205,7 +204,6 @@ set_obj_in_basis
 set_outputstream, set_outputfile
 set_pivoting
 set_preferdual
-set_presolve
 set_print_sol
 set_row, set_rowex
 set_row_name
@@ -213,7 +211,6 @@ set_scalelimit
 set_scaling
 set_semicont
 set_sense
-set_simplextype
 set_solutionlimit
 set_trace
 set_use_names
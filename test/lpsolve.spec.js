@@ -168,6 +168,283 @@ describe('lpsolvelib', function () {
     done()
   })
 
+  it('should be able to set the number of threads', function (done) {
+    expect(problem.threads()).to.be.eql(1)
+
+    problem.threads(2)
+    expect(problem.threads()).to.be.eql(2)
+    done()
+  })
+
+  it('should find the same integer solution with several threads', function (done) {
+    problem.resize(2, 3)
+    problem.objFn([0, 5, 4, 3])
+    problem.maxim(true)
+
+    problem.intVar(1, true)
+    problem.intVar(2, true)
+    problem.intVar(3, true)
+
+    problem.constraint([0, 2, 3, 1], lpsolve.CONSTRAINT_TYPE.LE, 5.5)
+    problem.constraint([0, 4, 1, 2], lpsolve.CONSTRAINT_TYPE.LE, 11.5)
+
+    problem.threads(4)
+    var status = problem.solveSync()
+    expect(status).to.be.eql(lpsolve.STATUS.OPTIMAL)
+
+    var variables = []
+    problem.variables(variables)
+    expect(variables).to.be.eql([0, 0, 5])
+    done()
+  })
+
+  it('should be able to set the branching rule', function (done) {
+    expect(problem.bbRule()).to.be.eql(lpsolve.NODE.FIRSTSELECT)
+
+    problem.bbRule(lpsolve.NODE.PSEUDOCOSTSELECT | lpsolve.NODE.RELIABILITY)
+    expect(problem.bbRule()).to.be.eql(lpsolve.NODE.PSEUDOCOSTSELECT | lpsolve.NODE.RELIABILITY)
+    done()
+  })
+
+  it('should find the same solution with strong branching on one and several threads', function (done) {
+    var solveWithThreads = function (threads) {
+      var lp = lpsolve.makeLP(0, 6)
+      lp.objFn([0, 5, 4, 3, 7, 6, 2])
+      lp.maxim(true)
+      for (var j = 1; j <= 6; j++) {
+        lp.intVar(j, true)
+        lp.upBound(j, 3)
+      }
+
+      lp.constraint([0, 2, 3, 1, 4, 3, 1], lpsolve.CONSTRAINT_TYPE.LE, 10.5)
+      lp.constraint([0, 4, 1, 2, 3, 5, 2], lpsolve.CONSTRAINT_TYPE.LE, 13.5)
+      lp.constraint([0, 1, 2, 3, 2, 1, 3], lpsolve.CONSTRAINT_TYPE.LE, 9.5)
+
+      lp.bbRule(lpsolve.NODE.PSEUDOCOSTSELECT | lpsolve.NODE.RELIABILITY)
+      lp.threads(threads)
+      var status = lp.solveSync()
+      expect(status).to.be.eql(lpsolve.STATUS.OPTIMAL)
+
+      var variables = []
+      lp.variables(variables)
+      lp.delete()
+      return variables
+    }
+
+    var serial = solveWithThreads(1)
+    expect(serial).to.be.eql([2, 0, 1, 1, 0, 0])
+    expect(solveWithThreads(4)).to.be.eql(serial)
+    done()
+  })
+
+  it('should be able to set the simplex type', function (done) {
+    expect(problem.simplexType()).to.be.eql(lpsolve.SIMPLEX.DUAL_PRIMAL)
+
+    problem.simplexType(lpsolve.SIMPLEX.PRIMAL_DUAL | lpsolve.SIMPLEX.CONCURRENT)
+    expect(problem.simplexType()).to.be.eql(lpsolve.SIMPLEX.PRIMAL_DUAL | lpsolve.SIMPLEX.CONCURRENT)
+    done()
+  })
+
+  it('should find the serial solution with the concurrent simplex', function (done) {
+    problem.resize(2, 2)
+    problem.objFn([0, 3, 2])
+    problem.maxim(true)
+    problem.upBound(1, 3)
+
+    problem.constraint([0, 1, 1], lpsolve.CONSTRAINT_TYPE.LE, 4)
+    problem.constraint([0, 1, 3], lpsolve.CONSTRAINT_TYPE.LE, 6)
+
+    problem.threads(2)
+    problem.simplexType(lpsolve.SIMPLEX.DUAL_PRIMAL | lpsolve.SIMPLEX.CONCURRENT)
+    var status = problem.solveSync()
+    expect(status).to.be.eql(lpsolve.STATUS.OPTIMAL)
+
+    var variables = []
+    problem.variables(variables)
+    expect(variables).to.be.eql([3, 1])
+    done()
+  })
+
+  it('should solve a presolved problem with the concurrent simplex', function (done) {
+    problem.resize(2, 3)
+    problem.objFn([0, 3, 2, 1])
+    problem.maxim(true)
+    problem.upBound(1, 3)
+    problem.upBound(3, 5)
+
+    problem.constraint([0, 1, 1, 0], lpsolve.CONSTRAINT_TYPE.LE, 4)
+    problem.constraint([0, 1, 3, 0], lpsolve.CONSTRAINT_TYPE.LE, 6)
+
+    problem.threads(2)
+    problem.simplexType(lpsolve.SIMPLEX.DUAL_PRIMAL | lpsolve.SIMPLEX.CONCURRENT)
+    problem.presolve(lpsolve.PRESOLVE.COLS)
+    var status = problem.solveSync()
+    expect(status).to.be.eql(lpsolve.STATUS.OPTIMAL)
+
+    var variables = []
+    problem.variables(variables)
+    expect(variables).to.be.eql([3, 1, 5])
+    done()
+  })
+
+  it('should report an infeasible problem found by the concurrent simplex', function (done) {
+    problem.resize(2, 3)
+    problem.objFn([0, 3, 2, 1])
+    problem.maxim(true)
+    problem.upBound(3, 5)
+
+    problem.constraint([0, 1, 1, 0], lpsolve.CONSTRAINT_TYPE.LE, 4)
+    problem.constraint([0, 1, 2, 0], lpsolve.CONSTRAINT_TYPE.GE, 10)
+
+    problem.threads(2)
+    problem.simplexType(lpsolve.SIMPLEX.DUAL_PRIMAL | lpsolve.SIMPLEX.CONCURRENT)
+    problem.presolve(lpsolve.PRESOLVE.COLS)
+    var status = problem.solveSync()
+    expect(status).to.be.eql(lpsolve.STATUS.INFEASIBLE)
+    done()
+  })
+
+  it('should be able to set the presolve options', function (done) {
+    expect(problem.presolve()).to.be.eql(lpsolve.PRESOLVE.NONE)
+
+    problem.presolve(lpsolve.PRESOLVE.ROWS | lpsolve.PRESOLVE.BOUNDS)
+    expect(problem.presolve()).to.be.eql(lpsolve.PRESOLVE.ROWS | lpsolve.PRESOLVE.BOUNDS)
+    done()
+  })
+
+  it('should solve an integer problem with bound propagation in presolve', function (done) {
+    problem.resize(2, 3)
+    problem.objFn([0, 5, 4, 3])
+    problem.maxim(true)
+
+    problem.intVar(1, true)
+    problem.intVar(2, true)
+    problem.intVar(3, true)
+
+    problem.constraint([0, 2, 3, 1], lpsolve.CONSTRAINT_TYPE.LE, 5.5)
+    problem.constraint([0, 4, 1, 2], lpsolve.CONSTRAINT_TYPE.LE, 11.5)
+
+    problem.presolve(lpsolve.PRESOLVE.ROWS | lpsolve.PRESOLVE.COLS | lpsolve.PRESOLVE.BOUNDS)
+    var status = problem.solveSync()
+    expect(status).to.be.eql(lpsolve.STATUS.OPTIMAL)
+
+    var variables = []
+    problem.variables(variables)
+    expect(variables).to.be.eql([0, 0, 5])
+    done()
+  })
+
+  it('should report an infeasible integer problem with bound propagation in presolve', function (done) {
+    problem.resize(1, 2)
+    problem.objFn([0, 1, 1])
+    problem.maxim(true)
+
+    problem.intVar(1, true)
+    problem.intVar(2, true)
+    problem.upBound(1, 1)
+    problem.upBound(2, 1)
+
+    problem.constraint([0, 1, 1], lpsolve.CONSTRAINT_TYPE.EQ, 1.5)
+
+    problem.presolve(lpsolve.PRESOLVE.BOUNDS)
+    var status = problem.solveSync()
+    expect(status).to.be.eql(lpsolve.STATUS.INFEASIBLE)
+    done()
+  })
+
+  it('should be able to set the basis crash mode', function (done) {
+    expect(problem.basisCrash()).to.be.eql(lpsolve.CRASH.NONE)
+
+    problem.basisCrash(lpsolve.CRASH.TRIANGULAR)
+    expect(problem.basisCrash()).to.be.eql(lpsolve.CRASH.TRIANGULAR)
+    done()
+  })
+
+  it('should solve a problem needing phase 1 after a triangular crash', function (done) {
+    problem.resize(3, 2)
+    problem.objFn([0, -4, -3])
+    problem.maxim(true)
+    problem.bounds(1, -10, 10)
+    problem.bounds(2, -10, 10)
+
+    problem.constraint([0, -1, -1], lpsolve.CONSTRAINT_TYPE.EQ, -2)
+    problem.constraint([0, 0, -3], lpsolve.CONSTRAINT_TYPE.GE, 0)
+    problem.constraint([0, -1, 0], lpsolve.CONSTRAINT_TYPE.GE, -4)
+
+    problem.simplexType(lpsolve.SIMPLEX.PRIMAL_PRIMAL)
+    problem.basisCrash(lpsolve.CRASH.TRIANGULAR)
+    var status = problem.solveSync()
+    expect(status).to.be.eql(lpsolve.STATUS.OPTIMAL)
+
+    var variables = []
+    problem.variables(variables)
+    expect(variables).to.be.eql([2, 0])
+    done()
+  })
+
+  it('should solve a problem needing phase 1 with basic user variables after a crash', function (done) {
+    problem.resize(4, 3)
+    problem.objFn([0, 5, -2, 1])
+    problem.maxim(true)
+    problem.bounds(1, 1, 2)
+    problem.lowBound(2, -1e30)
+    problem.lowBound(3, -1e30)
+
+    problem.constraint([0, 0, -2, 1], lpsolve.CONSTRAINT_TYPE.GE, -3)
+    problem.constraint([0, -2, 2, 1], lpsolve.CONSTRAINT_TYPE.EQ, -9)
+    problem.constraint([0, 0, 1, 0], lpsolve.CONSTRAINT_TYPE.GE, -10)
+    problem.constraint([0, 0, 0, 1], lpsolve.CONSTRAINT_TYPE.LE, 10)
+
+    problem.simplexType(lpsolve.SIMPLEX.PRIMAL_PRIMAL)
+    problem.basisCrash(lpsolve.CRASH.MOSTFEASIBLE)
+    var status = problem.solveSync()
+    expect(status).to.be.eql(lpsolve.STATUS.OPTIMAL)
+
+    var variables = []
+    problem.variables(variables)
+    expect(variables).to.be.eql([2, -7.5, 10])
+    done()
+  })
+
+  it('should branch from a concurrent root relaxation with primal phase 1', function (done) {
+    problem.resize(3, 6)
+    problem.objFn([0, 5, 4, 3, 7, 6, 2])
+    problem.maxim(true)
+    for (var j = 1; j <= 6; j++) {
+      problem.intVar(j, true)
+      problem.upBound(j, 3)
+    }
+
+    problem.constraint([0, 2, 3, 1, 4, 3, 1], lpsolve.CONSTRAINT_TYPE.LE, 10.5)
+    problem.constraint([0, 4, 1, 2, 3, 5, 2], lpsolve.CONSTRAINT_TYPE.LE, 13.5)
+    problem.constraint([0, 1, 2, 3, 2, 1, 3], lpsolve.CONSTRAINT_TYPE.LE, 9.5)
+
+    problem.threads(2)
+    problem.simplexType(lpsolve.SIMPLEX.PRIMAL_DUAL | lpsolve.SIMPLEX.CONCURRENT)
+    var status = problem.solveSync()
+    expect(status).to.be.eql(lpsolve.STATUS.OPTIMAL)
+
+    var variables = []
+    problem.variables(variables)
+    expect(variables).to.be.eql([2, 0, 1, 1, 0, 0])
+    done()
+  })
+
+  it('should keep integer columns integral when sparsifying in presolve', function (done) {
+    problem.resize(2, 2)
+    problem.objFn([0, 8, 1])
+    problem.maxim(true)
+    problem.intVar(1, true)
+
+    problem.constraint([0, -9, 9], lpsolve.CONSTRAINT_TYPE.EQ, 36)
+    problem.constraint([0, 4, -1], lpsolve.CONSTRAINT_TYPE.EQ, 1)
+
+    problem.presolve(lpsolve.PRESOLVE.ROWS | lpsolve.PRESOLVE.COLS | lpsolve.PRESOLVE.SPARSER)
+    var status = problem.solveSync()
+    expect(status).to.be.eql(lpsolve.STATUS.INFEASIBLE)
+    done()
+  })
+
   it('should be able to read from a LP file', function (done) {
     var lpPath = path.join(__dirname, 'lpsolve.lp')
     problem = lpsolve.readLP(lpPath, lpsolve.VERBOSITY.NORMAL, 'problem')